@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2017-2018 NEC Corporation
+ * This file is part of the VEOS.
+ *
+ * The VEOS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * The VEOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with the VEOS; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file ve_mmap_bench.c
+ * @brief Benchmark of VE page allocation under concurrent mmap requesters.
+ *
+ * Each requester maps, touches and unmaps one page in a loop, so that
+ * every iteration allocates and frees one VE page in VEOS. The number of
+ * requesters is doubled from 1 up to the given maximum and the mmap
+ * throughput of each step is printed. With the per-core page caches the
+ * throughput should scale with the number of requesters instead of
+ * staying flat on ve_pages_node_lock.
+ *
+ * This is a VE program. Build and run it with:
+ *	$ /opt/nec/ve/bin/ncc -O2 -pthread -o ve_mmap_bench ve_mmap_bench.c
+ *	$ ./ve_mmap_bench [-p] [-H] [-n max_requesters] [-i iterations]
+ *
+ *	-p	requesters are processes instead of threads
+ *	-H	map 64MB pages instead of 2MB pages
+ *
+ * @internal
+ * @author AMM
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define MAP_2MB			((uint64_t)1<<22)
+#define MAP_64MB		((uint64_t)1<<23)
+#define PAGE_SIZE_2MB		(2UL * 1024 * 1024)
+#define PAGE_SIZE_64MB		(64UL * 1024 * 1024)
+
+#define DEF_MAX_REQUESTERS	8
+#define DEF_ITERATIONS		1000
+
+static size_t pgsz = PAGE_SIZE_2MB;
+static int pgflag = MAP_2MB;
+static long iterations = DEF_ITERATIONS;
+
+/**
+ * @brief Map, touch and unmap one page "iterations" times.
+ *
+ * @param[in] arg Unused.
+ *
+ * @return NULL on success, (void *)-1 on failure.
+ */
+static void *requester(void *arg)
+{
+	long i;
+	char *p;
+
+	for (i = 0; i < iterations; i++) {
+		p = mmap(NULL, pgsz, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS | pgflag, -1, 0);
+		if (MAP_FAILED == p) {
+			fprintf(stderr, "mmap failed: %s\n", strerror(errno));
+			return (void *)-1;
+		}
+		p[0] = 1;
+		if (munmap(p, pgsz)) {
+			fprintf(stderr, "munmap failed: %s\n", strerror(errno));
+			return (void *)-1;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Run "nr" threads of requester() and wait for them.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int run_threads(int nr)
+{
+	int i, ret = 0;
+	void *res;
+	pthread_t *th;
+
+	th = calloc(nr, sizeof(pthread_t));
+	if (NULL == th)
+		return -1;
+	for (i = 0; i < nr; i++) {
+		if (pthread_create(&th[i], NULL, requester, NULL)) {
+			nr = i;
+			ret = -1;
+			break;
+		}
+	}
+	for (i = 0; i < nr; i++) {
+		pthread_join(th[i], &res);
+		if (NULL != res)
+			ret = -1;
+	}
+	free(th);
+	return ret;
+}
+
+/**
+ * @brief Run "nr" processes of requester() and wait for them.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int run_processes(int nr)
+{
+	int i, status, ret = 0;
+	pid_t pid;
+
+	for (i = 0; i < nr; i++) {
+		pid = fork();
+		if (0 == pid)
+			_exit(NULL == requester(NULL) ? 0 : 1);
+		if (0 > pid) {
+			ret = -1;
+			break;
+		}
+	}
+	while (0 < wait(&status)) {
+		if (!WIFEXITED(status) || WEXITSTATUS(status))
+			ret = -1;
+	}
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	int opt, nr, use_process = 0, max_requesters = DEF_MAX_REQUESTERS;
+	double sec, ops, base = 0;
+	struct timespec start, end;
+
+	while ((opt = getopt(argc, argv, "pHn:i:")) != -1) {
+		switch (opt) {
+		case 'p':
+			use_process = 1;
+			break;
+		case 'H':
+			pgsz = PAGE_SIZE_64MB;
+			pgflag = MAP_64MB;
+			break;
+		case 'n':
+			max_requesters = atoi(optarg);
+			break;
+		case 'i':
+			iterations = atol(optarg);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-p] [-H] [-n max_requesters]"
+				" [-i iterations]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (max_requesters < 1 || iterations < 1) {
+		fprintf(stderr, "invalid argument\n");
+		return 1;
+	}
+
+	printf("%s of %s page, %ld mmap/munmap per requester\n",
+	       use_process ? "processes" : "threads",
+	       (pgsz == PAGE_SIZE_2MB) ? "2MB" : "64MB", iterations);
+	printf("%10s %14s %10s\n", "requesters", "mmap/sec", "speedup");
+
+	for (nr = 1; nr <= max_requesters; nr *= 2) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if ((use_process ? run_processes(nr) : run_threads(nr))) {
+			fprintf(stderr, "requester failed with %d\n", nr);
+			return 1;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		sec = (end.tv_sec - start.tv_sec) +
+			(end.tv_nsec - start.tv_nsec) / 1e9;
+		ops = (double)nr * iterations / sec;
+		if (1 == nr)
+			base = ops;
+		printf("%10d %14.0f %9.2fx\n", nr, ops, ops / base);
+	}
+	return 0;
+}
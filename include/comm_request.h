@@ -39,6 +39,34 @@
 
 #define MAX_PROTO_MSG_SIZE (4*1024)
 
+/**
+ * @brief Fast path framing of pseudo/VEOS messages.
+ *
+ *	Once FAST_IPC_NEGOTIATE agreed on a version for a connection, the
+ *	commands accepted by VEOS_FAST_IPC_CMD() are sent as struct
+ *	veos_fast_hdr followed by the raw payload, instead of a packed
+ *	PseudoVeosMessage, and are acknowledged in the same framing.
+ *	The first byte of VEOS_FAST_IPC_MAGIC is never the first byte of
+ *	a packed PseudoVeosMessage, so both framings share the socket.
+ */
+#define VEOS_FAST_IPC_MAGIC	0x56454607U
+#define VEOS_FAST_IPC_VERSION	1
+
+struct veos_fast_hdr {
+	uint32_t magic;		/*!< VEOS_FAST_IPC_MAGIC */
+	uint16_t version;	/*!< Version agreed on the connection */
+	int16_t cmd_id;		/*!< Command ID */
+	int32_t pid;		/*!< TID of sending pseudo process */
+	uint32_t len;		/*!< Length of payload */
+	int64_t syscall_retval;	/*!< System call return value */
+};
+
+#define VEOS_FAST_IPC_MAX_PAYLOAD \
+	(MAX_PROTO_MSG_SIZE - sizeof(struct veos_fast_hdr))
+
+/* Number of authenticated TIDs remembered per pseudo connection */
+#define VEOS_TID_CACHE_SIZE	64
+
 #define KB 1024
 #define VEOS_THREAD_PAGE_SIZE (4*KB)
 #define VEOS_BYTES_PER_VE_THREAD 64
@@ -256,16 +284,17 @@ struct ve_rw_check_iovec {
 
 /**
  * @brief This stusture contain the process_rw_info.
+ *
+ * All the iovec pairs of one process_vm_readv/writev call are handled
+ * in one request: VE OS reads both iovec arrays from the VE memory of the
+ * calling process.
  */
 struct ve_process_rw_info {
 	pid_t r_pid;		/*!< remote process id */
-	vemva_t base_rvemva;
-	uint64_t r_len;
-	uint64_t len;
-	uint64_t lcov_offset;	/*!< offset on local vemva address to rw*/
-	uint64_t rcov_offest;	/*!< offset on remote vemva address to rw*/
-	vemva_t local_vemva;	/*!< local vemva address to rw*/
-	vemva_t remote_vemva;	/*!< remote vemva address to rw */
+	vemva_t local_iov;	/*!< VEMVA of local iovec array */
+	uint64_t liovcnt;	/*!< number of elements in local iovec array */
+	vemva_t remote_iov;	/*!< VEMVA of remote iovec array */
+	uint64_t riovcnt;	/*!< number of elements in remote iovec array */
 	int vm_rw;			/*!< 0 for read, 1 for write */
 };
 
@@ -358,6 +387,36 @@ struct dma_args {
 			* */
 };
 
+/**
+ * @brief Maximum number of segments in one DMA_REQ_VEC request.
+ *
+ * The request is sent as one pseudo/VEOS message, so it must fit
+ * in MAX_PROTO_MSG_SIZE together with the protocol buffer header.
+ */
+#define DMA_VEC_MAX_SEG 128
+
+/**
+ * @brief One segment of a vectored DMA request.
+ */
+struct dma_vec_seg {
+	uint64_t srcaddr;
+	uint64_t dstaddr;
+	uint64_t size;
+};
+
+/**
+ * @brief Arguments of vectored DMA request (DMA_REQ_VEC).
+ *
+ *	All segments have the same source and destination address type.
+ *	Only the first nseg entries of seg[] are sent to VEOS.
+ */
+struct dma_vec_args {
+	int srctype;
+	int dsttype;
+	uint64_t nseg;
+	struct dma_vec_seg seg[DMA_VEC_MAX_SEG];
+};
+
 /**
 * @brief Store the signal information for the signal
 * generated for VE process
@@ -400,6 +459,12 @@ typedef struct veos_thread_arg {
 	int pidfd;
 	void *pseudo_proc_msg;
 	struct ucred cred;	/*!< credential */
+	int fast_ipc;		/*!< Fast path version agreed, 0 if none */
+	bool fast_req;		/*!< Current request came on the fast path */
+	pid_t verified_tid[VEOS_TID_CACHE_SIZE];
+				/*!< TIDs already authenticated on connection */
+	int nr_verified_tid;	/*!< Number of valid entries in verified_tid */
+	uint64_t tid_cache_gen;	/*!< veos_dead_tid_gen when cache was valid */
 } veos_thread_arg_t;
 
 struct veos_cmd_entry {
@@ -618,8 +683,18 @@ enum pseudo_veos_msg_id {
 	CMD_VHSHM,
 	MAP_DMADES,
 	UNMAP_DMADES,
+	DMA_REQ_VEC,
+	FAST_IPC_NEGOTIATE,
 	PSEUDO_VEOS_MAX_MSG_NUM,
 	CMD_INVALID = -1,
 };
 
+/**
+ * @brief Commands which may be sent on the fast path.
+ */
+#define VEOS_FAST_IPC_CMD(cmd) \
+	((cmd) == DMA_REQ || (cmd) == BLOCK || \
+	 (cmd) == UNBLOCK_AND_SET_REGVAL || (cmd) == SCHEDULE || \
+	 (cmd) == GET_REGVAL_REQ || (cmd) == SET_USR_REG)
+
 #endif
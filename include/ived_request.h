@@ -29,6 +29,7 @@
 #define __VEOS_PSEUDO_INTERFACE_IVED_H
 
 #define NR_CR_ARGS	4
+#define VESHM_BATCH_MAX	64	/* Max # of elements of a batch request */
 
 /* It is used by VESHM and CR. */
 struct ived_sub_reply {
@@ -79,6 +80,45 @@ struct veshm_args {
 	}arg;
 };
 
+/* Element of a batch attach request. A VESHM is identified by
+ * (owner pid, uuid, vemva, size). uuid_veshm is all zero to attach
+ * any VESHM of the area, or the uuid returned by a previous attach to
+ * fail with -ESTALE if the owner has renewed the VESHM since then. */
+struct veshm_batch_attach {
+	struct attach_arg arg;
+	uint8_t uuid_veshm[16];		/* uuid_t */
+};
+
+/* Batch request of VESHM attach/detach. Only "num" elements are sent. */
+struct veshm_batch_args {
+	int subcmd;
+	int num;			/* # of elements */
+	union {
+		struct veshm_batch_attach attach[VESHM_BATCH_MAX];
+		struct detach_arg detach[VESHM_BATCH_MAX];
+	} arg;
+};
+
+/* Upper bound of the protobuf fields which frame pseudo_msg in a
+ * PseudoVeosMessage (6 tagged fields of at most 11 bytes each) */
+#define VESHM_BATCH_MSG_FRAMING	64
+
+/* Max # of elements of ent_size bytes which one VESHM batch message
+ * carries within MAX_PROTO_MSG_SIZE. Larger batches are split by the
+ * pseudo process. */
+#define VESHM_BATCH_MSG_MAX(ent_size)					\
+	((MAX_PROTO_MSG_SIZE - VESHM_BATCH_MSG_FRAMING			\
+	  - offsetof(struct veshm_batch_args, arg)) / (ent_size))
+
+/* Result of an element of a batch request */
+struct veshm_batch_result {
+	int64_t  retval;		/* Attach: address, Detach: 0
+					 * or -errno on failure */
+	uint64_t size;			/* Detach: size of detached VESHM */
+	uint32_t num;			/* Detach: # of remaining attaches */
+	uint8_t  uuid_veshm[16];	/* Attach: uuid of attached VESHM */
+};
+
 struct cr_args {
 	int subcmd;
 	uint64_t args[NR_CR_ARGS];
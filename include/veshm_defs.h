@@ -46,7 +46,8 @@ enum VESHM_command {
 	VESHM_ATTACH,
 	VESHM_DETACH,
 	VESHM_CLOSE,
-
+	VESHM_ATTACH_BATCH,	/* Attach VESHMs in one request */
+	VESHM_DETACH_BATCH,	/* Detach VESHMs in one request */
 	VESHM_PGSIZE	= 0x36,
 	VESHM_CHECK_PARTIAL,
 };
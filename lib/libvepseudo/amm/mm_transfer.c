@@ -32,6 +32,7 @@
 #include <error.h>
 #include <errno.h>
 #include <unistd.h>
+#include <stddef.h>
 #include <sys/syscall.h>
 #include <sys/mman.h>
 #include <ctype.h>
@@ -613,9 +614,23 @@ int amm_dma_xfer_req(uint8_t *dma_param, veos_handle *handle, pid_t tid)
 	PseudoVeosMessage *pseudo_rsp_msg = NULL;
 	char cmd_buf_req[MAX_PROTO_MSG_SIZE] = {0};
 	char cmd_buf_ack[MAX_PROTO_MSG_SIZE] = {0};
+	int64_t ack_ret = 0;
 
 	PSEUDO_DEBUG("Invoked");
 
+	if (handle->fast_ipc) {
+		ret = pseudo_veos_send_fast_cmd(handle->veos_sock_fd,
+				handle->fast_ipc, DMA_REQ,
+				tid ? tid : syscall(SYS_gettid), 0,
+				dma_param, sizeof(struct dma_args));
+		if (0 > ret) {
+			PSEUDO_ERROR("failed to communicate with veos");
+			ret = -EFAULT;
+			goto hndl_error;
+		}
+		goto recv_ack;
+	}
+
 	PseudoVeosMessage ve_dma_req = PSEUDO_VEOS_MESSAGE__INIT;
 	ProtobufCBinaryData ve_dma_req_msg;
 
@@ -660,6 +675,7 @@ int amm_dma_xfer_req(uint8_t *dma_param, veos_handle *handle, pid_t tid)
 		goto hndl_error;
 	}
 
+recv_ack:
 	ret = pseudo_veos_recv_cmd(handle->veos_sock_fd,
 			(void *)&cmd_buf_ack, MAX_PROTO_MSG_SIZE);
 	if (0 > ret) {
@@ -668,6 +684,11 @@ int amm_dma_xfer_req(uint8_t *dma_param, veos_handle *handle, pid_t tid)
 		goto hndl_error;
 	}
 
+	if (pseudo_veos_recv_fast_ack(cmd_buf_ack, ret, &ack_ret, NULL, 0)) {
+		ret = ack_ret;
+		goto hndl_error;
+	}
+
 	pseudo_rsp_msg = pseudo_veos_message__unpack(NULL, ret,
 			(const uint8_t *)(&cmd_buf_ack));
 	if (NULL == pseudo_rsp_msg) {
@@ -691,12 +712,228 @@ hndl_error:
 	return ret;
 }
 
+/**
+ * @brief Vectored DMA Request to veos.
+ *
+ * @param[in] dma_param segments to transfer, only first nseg are sent
+ * @param[in] handle VEOS handle
+ *
+ * @return On success returns 0 and negative of errno on failure.
+ */
+int amm_dma_vec_xfer_req(struct dma_vec_args *dma_param, veos_handle *handle)
+{
+	int ret = -1;
+	ssize_t pseudo_msg_len = -1;
+	PseudoVeosMessage *pseudo_rsp_msg = NULL;
+	char cmd_buf_req[MAX_PROTO_MSG_SIZE] = {0};
+	char cmd_buf_ack[MAX_PROTO_MSG_SIZE] = {0};
+
+	PSEUDO_TRACE("Invoked");
+
+	PseudoVeosMessage ve_dma_req = PSEUDO_VEOS_MESSAGE__INIT;
+	ProtobufCBinaryData ve_dma_req_msg;
+
+	ve_dma_req.pseudo_veos_cmd_id = DMA_REQ_VEC;
+	ve_dma_req.has_pseudo_pid = true;
+	ve_dma_req.pseudo_pid = syscall(SYS_gettid);
+
+	ve_dma_req_msg.len = offsetof(struct dma_vec_args, seg) +
+		dma_param->nseg * sizeof(struct dma_vec_seg);
+	ve_dma_req_msg.data = (uint8_t *)dma_param;
+
+	ve_dma_req.has_pseudo_msg = true;
+	ve_dma_req.pseudo_msg = ve_dma_req_msg;
+
+	pseudo_msg_len = pseudo_veos_message__get_packed_size(&ve_dma_req);
+
+	if (pseudo_msg_len != pseudo_veos_message__pack(&ve_dma_req,
+				(uint8_t *)cmd_buf_req)) {
+		PSEUDO_DEBUG("internal message protocol buffer error, "
+				"message length : %ld", pseudo_msg_len);
+		PSEUDO_ERROR("internal message protocol buffer error");
+		fprintf(stderr, "internal message protocol buffer error, "
+				"message length : %ld", pseudo_msg_len);
+		abort();
+	}
+
+	ret = pseudo_veos_send_cmd(handle->veos_sock_fd,
+			cmd_buf_req, pseudo_msg_len);
+	if (0 > ret) {
+		PSEUDO_DEBUG("failed to send request to veos, "
+				" transferred %d bytes", ret);
+		PSEUDO_ERROR("failed to communicate with veos");
+		ret = -EFAULT;
+		goto hndl_error;
+	}
+
+	ret = pseudo_veos_recv_cmd(handle->veos_sock_fd,
+			(void *)&cmd_buf_ack, MAX_PROTO_MSG_SIZE);
+	if (0 > ret) {
+		PSEUDO_ERROR("failed to communicate with veos");
+		ret = -EFAULT;
+		goto hndl_error;
+	}
+
+	pseudo_rsp_msg = pseudo_veos_message__unpack(NULL, ret,
+			(const uint8_t *)(&cmd_buf_ack));
+	if (NULL == pseudo_rsp_msg) {
+		PSEUDO_ERROR("internal message protocol buffer error");
+		fprintf(stderr, "internal message protocol buffer error");
+		abort();
+	}
+
+	ret = pseudo_rsp_msg->syscall_retval;
+	if (0 > ret)
+		PSEUDO_DEBUG("error(%s) while vectored DMA on VE OS",
+				strerror(-ret));
+	else
+		PSEUDO_DEBUG("received acknowledgement from VE OS for "
+				"vectored DMA xfer req");
+	pseudo_veos_message__free_unpacked(pseudo_rsp_msg, NULL);
+
+hndl_error:
+	PSEUDO_DEBUG("returned with %d", ret);
+	PSEUDO_TRACE("returned");
+	return ret;
+}
+
+/**
+ * @brief Send the batched segments of a vectored transfer to VEOS.
+ *
+ * @param[in] handle VEOS handle
+ * @param[in,out] dma_param batched segments, nseg is reset on return
+ * @param[in] is_send whether to send/receive.
+ *
+ * @return On success returns 0 and negative of errno on failure.
+ */
+static int ve_xfer_data_vec_flush(veos_handle *handle,
+		struct dma_vec_args *dma_param, bool is_send)
+{
+	int ret = 0;
+
+	if (!dma_param->nseg)
+		return 0;
+
+	/* Same as __ve_recv_data(), VH buffer must not be copied by fork
+	 * while VE memory is received into it. */
+	if (!is_send && pthread_rwlock_rdlock(&sync_fork_dma)) {
+		fprintf(stderr, "Internal resource usage error\n");
+		pseudo_abort();
+	}
+
+	ret = amm_dma_vec_xfer_req(dma_param, handle);
+	if (0 > ret)
+		ret = -EFAULT;
+
+	if (!is_send && pthread_rwlock_unlock(&sync_fork_dma)) {
+		fprintf(stderr, "Internal resource usage error\n");
+		pseudo_abort();
+	}
+	dma_param->nseg = 0;
+	return ret;
+}
+
+/**
+ * @brief Transfer a scatter/gather list between VH and VE memory.
+ *
+ *	Segments whose VEMVA, VH address and size are aligned to
+ *	ALIGN_BUFF_SIZE are batched in DMA_REQ_VEC requests of up to
+ *	DMA_VEC_MAX_SEG segments, so that each batch costs one round
+ *	trip to VEOS and one DMA request list. Other segments are
+ *	transferred one by one as ve_send_data()/ve_recv_data() do.
+ *
+ * @param[in] handle VEOS handle
+ * @param[in] seg segments, source and destination in the DMA direction
+ * @param[in] nseg number of segments
+ * @param[in] is_send whether to send/receive.
+ *
+ * @return On success returns 0 and negative of errno on failure.
+ */
+static int ve_xfer_data_vec(veos_handle *handle, struct dma_vec_seg *seg,
+		int nseg, bool is_send)
+{
+	int ret = 0, idx = 0;
+	uint64_t vemva = 0, vhva = 0;
+	struct dma_vec_args dma_param;
+
+	PSEUDO_TRACE("Invoked");
+
+	dma_param.srctype = is_send ? VE_DMA_VHVA : VE_DMA_VEMVA;
+	dma_param.dsttype = is_send ? VE_DMA_VEMVA : VE_DMA_VHVA;
+	dma_param.nseg = 0;
+
+	for (idx = 0; idx < nseg; idx++) {
+		if (!seg[idx].size)
+			continue;
+		vemva = is_send ? seg[idx].dstaddr : seg[idx].srcaddr;
+		vhva = is_send ? seg[idx].srcaddr : seg[idx].dstaddr;
+
+		if (((vemva | vhva | seg[idx].size) % ALIGN_BUFF_SIZE) ||
+				(seg[idx].size > VE_XFER_BLOCK_SIZE)) {
+			ret = is_send ?
+				ve_send_data(handle, vemva, seg[idx].size,
+						(void *)vhva) :
+				ve_recv_data(handle, vemva, seg[idx].size,
+						(void *)vhva);
+			if (ret)
+				goto xfer_done;
+			continue;
+		}
+
+		dma_param.seg[dma_param.nseg++] = seg[idx];
+		if (dma_param.nseg == DMA_VEC_MAX_SEG) {
+			ret = ve_xfer_data_vec_flush(handle, &dma_param,
+					is_send);
+			if (ret)
+				goto xfer_done;
+		}
+	}
+	ret = ve_xfer_data_vec_flush(handle, &dma_param, is_send);
+
+xfer_done:
+	PSEUDO_DEBUG("returned with %d", ret);
+	PSEUDO_TRACE("returned");
+	return ret;
+}
+
+/**
+ * @brief Send a gather list of VH buffers to VE memory.
+ *
+ * @param[in] handle VEOS handle
+ * @param[in] seg segments, srcaddr is VH address and dstaddr is VEMVA
+ * @param[in] nseg number of segments
+ *
+ * @return On success returns 0 and negative of errno on failure.
+ */
+int ve_send_data_vec(veos_handle *handle, struct dma_vec_seg *seg, int nseg)
+{
+	return ve_xfer_data_vec(handle, seg, nseg, true);
+}
+
+/**
+ * @brief Receive a scatter list of VE memory into VH buffers.
+ *
+ * @param[in] handle VEOS handle
+ * @param[in] seg segments, srcaddr is VEMVA and dstaddr is VH address
+ * @param[in] nseg number of segments
+ *
+ * @return On success returns 0 and negative of errno on failure.
+ */
+int ve_recv_data_vec(veos_handle *handle, struct dma_vec_seg *seg, int nseg)
+{
+	return ve_xfer_data_vec(handle, seg, nseg, false);
+}
+
 /**
  *@brief Receive string from VEMVA.
  *
  *	This function is same as vedl_recv_string. It is copied here
  *	to use the DMA library attached with veos.
  *
+ *	The string is read speculatively up to the end of the VE page or
+ *	of the destination buffer, whichever comes first, so that usually
+ *	one DMA request is enough.
+ *
  *@param[in] handle VEOS handle
  *@param[in] from Starting address of string to receive (VEMVA)
  *@param[out] dest Destination buffer address to receive string.
@@ -715,22 +952,23 @@ int ve_recv_string(veos_handle *handle, uint64_t from, char *dest,
 	int i = 0;
 	int len = 0;
 	int ret = 0;
-	int ve_page_size = 0;
+	uint64_t ve_page_size = 0;
 	uint64_t page_boundary = 0;
-	size_t buff_size = 0;
 	size_t recv_size = 0;
-	char *buff = NULL;
-	char *dest_p = dest;
+	size_t copied = 0;
+	char *nul = NULL;
 
-	/* receive buffer size (4KB each) */
-	buff_size = PAGE_SIZE_4KB;
 	PSEUDO_TRACE("Invoked");
 	PSEUDO_DEBUG("arguments: from: \
 			0x%lx, dest = %p, dest_size = %ld",
 			from, dest, dest_size);
+
+	if (!dest_size) {
+		PSEUDO_DEBUG("dest buffer is too small");
+		return DSTSMLL;
+	}
+
 	/* get VEMVA page size */
-	/* Temporary set it 2MB. In actual environment, ask AMM to get it */
-	/* Get the page size of VE address using ve_get_pgsz() */
 	ve_page_size = __get_page_size((vemva_t)from);
 	if (!ve_page_size) {
 		ret = -EFAULT;
@@ -738,19 +976,8 @@ int ve_recv_string(veos_handle *handle, uint64_t from, char *dest,
 		return ret;
 	}
 
-
-	/* allocate buffer */
-	buff = (char *)malloc(sizeof(char) * buff_size);
-	if (buff == NULL) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error (%s) while allcating memory",
-				strerror(-ret));
-		return ret;
-	}
-	memset(buff, 0, buff_size);
-
 	/* calc page boundary address. */
-	page_boundary = (from & ~((uint64_t)ve_page_size - 1)) + ve_page_size;
+	page_boundary = (from & ~(ve_page_size - 1)) + ve_page_size;
 	PSEUDO_DEBUG("from = 0x%016lx, page_boundary = 0x%016lx",
 			from, page_boundary);
 
@@ -763,65 +990,36 @@ int ve_recv_string(veos_handle *handle, uint64_t from, char *dest,
 			PSEUDO_DEBUG("receiving second page."
 					"(this might fail)");
 		}
-		while (from != page_boundary) {
-
-			/* calc recv_size */
-			if (page_boundary < from + buff_size)
-				recv_size = page_boundary - from;
-			else
-				recv_size = buff_size;
-
-			PSEUDO_DEBUG("from = %016lx, to = %016lx"
-					"(size = 0x%zx)",
-					from, from + recv_size, recv_size);
-			/* receive VE memory */
-			ret = ve_recv_data(handle, from, recv_size, buff);
-			if (ret) {
-				PSEUDO_DEBUG("error while receiving date from VE");
-				ret = FAIL2RCV;
-				goto failure;
-			}
 
-			/* search null character from buff */
-			for (len = 0; len < recv_size; len++) {
-				if (buff[len] == '\0') {
-					len++;
-					break;
-				} else if (dest_size == len) {
-					PSEUDO_DEBUG("Null not found"
-							"in prescribed range");
-					ret = DSTSMLL;
-					goto failure;
-				}
-				if (isprint(buff[len]) == 0
-						&& buff[len] != '\n') {
-					PSEUDO_DEBUG("non-printable character found");
-				}
-			}
+		/* read the rest of the page, but no more than dest holds */
+		recv_size = page_boundary - from;
+		if (recv_size > dest_size - copied)
+			recv_size = dest_size - copied;
 
-			/* check if dest buffer size is enough or not */
-			if (dest_size < ((uint64_t)dest_p + len) -
-					(uint64_t)dest) {
-				PSEUDO_DEBUG("dest buffer is too small");
-				ret = DSTSMLL;
-				goto failure;
-			}
-			memcpy(dest_p, buff, len);
-
-			/* check if null character found or not */
-			if (len != recv_size || buff[len-1] == '\0') {
-				PSEUDO_DEBUG("null character found.");
-				goto success;
-			} else if (recv_size == dest_size) {
-				PSEUDO_DEBUG("null character not found.");
-				ret = NULLNTFND;
-				goto failure;
-			}
+		PSEUDO_DEBUG("from = %016lx, to = %016lx"
+				"(size = 0x%zx)",
+				from, from + recv_size, recv_size);
+		/* receive VE memory */
+		ret = ve_recv_data(handle, from, recv_size, dest + copied);
+		if (ret) {
+			PSEUDO_DEBUG("error while receiving date from VE");
+			ret = FAIL2RCV;
+			goto failure;
+		}
 
+		/* search null character */
+		nul = memchr(dest + copied, '\0', recv_size);
+		if (nul) {
+			PSEUDO_DEBUG("null character found.");
+			goto success;
+		}
 
-			/* let's ready for the next */
-			dest_p = (char *)((uint64_t)dest_p + recv_size);
-			from += recv_size;
+		copied += recv_size;
+		from += recv_size;
+		if (copied == dest_size) {
+			PSEUDO_DEBUG("Null not found in prescribed range");
+			ret = NULLNTFND;
+			goto failure;
 		}
 	}
 	PSEUDO_DEBUG("null character not found in the area.");
@@ -829,12 +1027,11 @@ int ve_recv_string(veos_handle *handle, uint64_t from, char *dest,
 	goto failure;
 
 success:
-	len = strlen(dest);
+	len = nul - dest;
 	PSEUDO_DEBUG("str = %s", dest);
 	PSEUDO_DEBUG("length = %d", len);
 	ret = len;
 failure:
-	free(buff);
 	PSEUDO_DEBUG("returned with %d", ret);
 	PSEUDO_TRACE("returned");
 	return ret;
@@ -28,6 +28,7 @@
 
 #include "sys_common.h"
 #include "mm_type.h"
+#include "comm_request.h"
 #define NULLNTFND	-2
 #define FAIL2RCV	-3
 #define DSTSMLL		-4
@@ -57,4 +58,7 @@ int ve_recv_data_tid(veos_handle *, uint64_t, size_t, void *, pid_t tid);
 int ve_recv_string(veos_handle *, uint64_t, char *, size_t);
 int __ve_send_data(veos_handle *, uint64_t, size_t, void *, pid_t tid);
 int __ve_recv_data(veos_handle *, uint64_t, size_t, void *, pid_t tid);
+int ve_send_data_vec(veos_handle *, struct dma_vec_seg *, int);
+int ve_recv_data_vec(veos_handle *, struct dma_vec_seg *, int);
+int amm_dma_vec_xfer_req(struct dma_vec_args *, veos_handle *);
 #endif
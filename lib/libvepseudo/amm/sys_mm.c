@@ -1543,6 +1543,8 @@ ret_t ve_mprotect(int syscall_num, char *syscall_name, veos_handle *handle)
 
 	/*sending request*/
 	ret = amm_request_mprotect(handle, vemva, len, prot);
+	/* Addresses cached as valid may no longer be accessible */
+	vemva_valid_cache_invalidate();
 	if (0 > ret) {
 		PSEUDO_DEBUG("Error(%s) for syscall(%s)", strerror(-ret), syscall_name);
 		PSEUDO_ERROR("error(%s) for syscall(%s)", strerror(-ret), syscall_name);
@@ -1762,9 +1764,7 @@ ret_t ve_process_vm_readv(int syscall_num, char *syscall_name, veos_handle *hand
 {
 	pid_t pid = 0;
 	uint64_t l_iovec = 0;
-	struct iovec *vhremote_iovec = NULL;
 	uint64_t riovcnt = 0;
-	struct iovec *vhlocal_iovec = NULL;
 	uint64_t r_iovec = 0;
 	uint64_t liovcnt = 0;
 	uint64_t flags = 0;
@@ -1791,6 +1791,13 @@ ret_t ve_process_vm_readv(int syscall_num, char *syscall_name, veos_handle *hand
 			"r_iovec(0x%lx) riovcnt(0x%lx) flags(0x%lx)", syscall_name,
 			pid, l_iovec, liovcnt, r_iovec, riovcnt, flags);
 
+	/* No flag is defined for process_vm_readv */
+	if (flags) {
+		ret = -EINVAL;
+		PSEUDO_DEBUG("Error(%s) flags(0x%lx)", strerror(-ret), flags);
+		goto error_return;
+	}
+
 	/* Check the iovec count is valid or not */
 	if (liovcnt > IOV_MAX || riovcnt > IOV_MAX) {
 		ret = -EINVAL;
@@ -1813,81 +1820,14 @@ ret_t ve_process_vm_readv(int syscall_num, char *syscall_name, veos_handle *hand
 		goto error_return;
 	}
 
-	vhremote_iovec = (struct iovec *)calloc(1, sizeof(struct iovec)
-			* riovcnt);
-	if (NULL == vhremote_iovec) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error(%s) while allocating memory for vhremote_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	vhlocal_iovec = (struct iovec *)calloc(1, sizeof(struct iovec) * liovcnt);
-	if (NULL == vhlocal_iovec) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error(%s) while allocating memory for vhremote_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	/*Read from ve memory and store to local buff for manipulation*/
-	ret = ve_recv_data(handle, l_iovec, sizeof(struct iovec) * liovcnt,
-			(void *)vhlocal_iovec);
-	if (0 > ret) {
-		ret = -EFAULT;
-		PSEUDO_DEBUG("Error(%s) while receiving date from VE for l_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	/*Read from ve memory and store to local buff for manipulation*/
-	ret = ve_recv_data(handle, r_iovec, sizeof(struct iovec) * riovcnt,
-			(void *)vhremote_iovec);
-	if (0 > ret) {
-		ret = -EFAULT;
-		PSEUDO_DEBUG("Error(%s) while receiving date from VE for r_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	/* Call VH process_vm_readv for checking access and capability*/
-	ret = process_vm_readv(pid, vhlocal_iovec, 1, vhremote_iovec, 1,
-			flags);
-	if (0 > ret) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error(%s) while transferring data from the remote"
-				"process to the local process on VH", strerror(-ret));
-		goto error_return;
-	}
-
-	/*Check the validation of local iovec*/
-	ret = ve_check_iovec(vhlocal_iovec, liovcnt);
-	if (0 > ret) {
-		PSEUDO_DEBUG("Error(%s) while checking validity of vhlocal_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	ret = ve_check_iovec(vhremote_iovec, riovcnt);
-	if (0 > ret) {
-		PSEUDO_DEBUG("Error(%s) while checking validity of vhremote_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	ret = __ve_process_vm_rw(handle, vhlocal_iovec, liovcnt,
-			vhremote_iovec, riovcnt, pid, 0);
+	ret = __ve_process_vm_rw(handle, l_iovec, liovcnt,
+			r_iovec, riovcnt, pid, 0);
 	if (0 > ret) {
 		PSEUDO_DEBUG("Error(%s) for syscall(%s)", strerror(-ret), syscall_name);
 		PSEUDO_ERROR("error(%s) for syscall(%s)", strerror(-ret), syscall_name);
 	}
 
 error_return:
-	if (vhlocal_iovec)
-		free(vhlocal_iovec);
-	if (vhremote_iovec)
-		free(vhremote_iovec);
-
 	PSEUDO_TRACE("returned(%ld)", ret);
 	return ret;
 }
@@ -1906,9 +1846,7 @@ ret_t ve_process_vm_writev(int syscall_num, char *syscall_name, veos_handle *han
 {
 	pid_t pid = 0;
 	uint64_t l_iovec = 0;
-	struct iovec *vhremote_iovec = NULL;
 	uint64_t riovcnt = 0;
-	struct iovec *vhlocal_iovec = NULL;
 	uint64_t r_iovec = 0;
 	uint64_t liovcnt = 0;
 	uint64_t flags = 0;
@@ -1937,6 +1875,12 @@ ret_t ve_process_vm_writev(int syscall_num, char *syscall_name, veos_handle *han
 			"r_iovec(0x%lx) riovcnt(0x%lx) flags(0x%lx)", syscall_name,
 			pid, l_iovec, liovcnt, r_iovec, riovcnt, flags);
 
+	if (flags) {
+		ret = -EINVAL;
+		PSEUDO_DEBUG("Error(%s) flags(0x%lx)", strerror(-ret), flags);
+		goto error_return;
+	}
+
 	if (liovcnt > IOV_MAX || riovcnt > IOV_MAX) {
 		ret = -EINVAL;
 		PSEUDO_DEBUG("Error(%s) liovcnt(0x%lx)", strerror(-ret), liovcnt);
@@ -1955,74 +1899,13 @@ ret_t ve_process_vm_writev(int syscall_num, char *syscall_name, veos_handle *han
 		goto error_return;
 	}
 
-	vhremote_iovec = (struct iovec *)calloc(1, sizeof(struct iovec) * riovcnt);
-	if (NULL == vhremote_iovec) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error(%s) while allocating memory for vhremote_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	vhlocal_iovec = (struct iovec *)calloc(1, sizeof(struct iovec) * liovcnt);
-	if (NULL == vhlocal_iovec) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error(%s) while allocating memory for vhlocal_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	ret = ve_recv_data(handle, l_iovec, sizeof(struct iovec) * liovcnt,
-			(void *)vhlocal_iovec);
-	if (0 > ret) {
-		ret = -EFAULT;
-		PSEUDO_DEBUG("Error(%s) while receiving date from VE for l_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	ret = ve_recv_data(handle, r_iovec, sizeof(struct iovec) * riovcnt,
-			(void *)vhremote_iovec);
-	if (0 > ret) {
-		ret = -EFAULT;
-		PSEUDO_DEBUG("Error(%s) while receiving date from VE for l_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	ret = ve_check_iovec(vhlocal_iovec, liovcnt);
-	if (0 > ret) {
-		PSEUDO_DEBUG("Error(%s) while checking validity of vhlocal_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-
-	ret = ve_check_iovec(vhremote_iovec, riovcnt);
-	if (0 > ret) {
-		PSEUDO_DEBUG("Error(%s) while checking validity of vhlocal_iovec",
-				strerror(-ret));
-		goto error_return;
-	}
-	ret = process_vm_writev(pid, vhlocal_iovec, 1, vhremote_iovec, 1,
-			flags);
-	if (0 > ret) {
-		ret = -errno;
-		PSEUDO_DEBUG("Error(%s) while transferring data from the local"
-				"process to the remote process on VH", strerror(-ret));
-		goto error_return;
-	}
-
-	ret = __ve_process_vm_rw(handle, vhlocal_iovec, liovcnt,
-			vhremote_iovec, riovcnt, pid, 1);
+	ret = __ve_process_vm_rw(handle, l_iovec, liovcnt,
+			r_iovec, riovcnt, pid, 1);
 	if (0 > ret) {
 		PSEUDO_DEBUG("Error(%s) for syscall(%s)", strerror(-ret), syscall_name);
 		PSEUDO_ERROR("error(%s) for syscall(%s)", strerror(-ret), syscall_name);
 	}
 error_return:
-	if (vhlocal_iovec)
-		free(vhlocal_iovec);
-	if (vhremote_iovec)
-		free(vhremote_iovec);
-
 	PSEUDO_TRACE("returned(%ld)", ret);
 	return ret;
 }
@@ -2031,12 +1914,17 @@ error_return:
  * @brief This function do read/write operation to/from specified process
  * memory to/from calling process memory.
  *
+ * @note The whole iovec arrays are handed over to VEOS in one request.
+ * VEOS alone reads and validates them from VE memory, checks the access
+ * to the remote process and transfers every segment at once.
+ *
  * @param[in] handle VEOS handle.
- * @param[in] local_iovec iovec array specifying where to copy to/from locally.
+ * @param[in] local_iovec VEMVA of iovec array specifying where to copy
+ * to/from locally.
  * @param[in] liovcnt number of elements in local iovec array.
- * @param[in] remote_iovec iovec array specifying where to copy to/from
- * remote process.
- * @param[in] riovcnt Number of elements in local iovec array.
+ * @param[in] remote_iovec VEMVA of iovec array specifying where to copy
+ * to/from remote process.
+ * @param[in] riovcnt Number of elements in remote iovec array.
  * @param[in] pid Pid of process to/from read/write.
  * @param[in] type Type of operation read/write.
  * 0 for read from remote process, 1 for write to remote process.
@@ -2044,189 +1932,32 @@ error_return:
  * @return On success return number of bytes read/write to/from remote process
  * and negative of errno on failure.
  */
-int64_t __ve_process_vm_rw(veos_handle *handle, struct iovec *local_iovec,
-		uint64_t liovcnt, struct iovec *remote_iovec, uint64_t riovcnt,
+int64_t __ve_process_vm_rw(veos_handle *handle, vemva_t local_iovec,
+		uint64_t liovcnt, vemva_t remote_iovec, uint64_t riovcnt,
 		pid_t pid, int type)
 {
-	size_t cur_lcnt = 0, curr_l_offset = 0;
-	int64_t total_rw = 0, ret = 0, idx = 0;
-
-	PSEUDO_TRACE("invoked");
-
-	for (idx = 0; idx < riovcnt; idx++) {
-		ret = ve_process_vm_rw_single_iov(handle,
-				(remote_iovec + idx),
-				local_iovec, liovcnt, &cur_lcnt,
-				&curr_l_offset,	pid, type);
-		if (0 > ret) {
-			if (!total_rw) {
-				total_rw = -1;
-				break;
-			}
-			break;
-		}
-		total_rw += ret;
-		PSEUDO_DEBUG("total byte %s (%ld) riovcnt %ld",
-				(type) ? "written":"read", total_rw, idx);
-	}
-
-	PSEUDO_TRACE("returned(%ld)", total_rw);
-	return total_rw;
-
-}
-
-/**
- * @brief This function check the validity of each iovec.
- *
- * @param[in] iovec Pointer to check the iovec.
- * @param[in] iovcnt Number of iovec to check.
- *
- * @return On success return 0 and negative of errno on failure.
- */
-int64_t ve_check_iovec(struct iovec *iovec, uint64_t iovcnt)
-{
-	ssize_t len = 0;
-	int idx = 0;
-
-	PSEUDO_TRACE("invoked");
-
-	for (idx = 0; idx < iovcnt; idx++) {
-		len = (ssize_t)iovec[idx].iov_len;
-		if (0 > len) {
-			PSEUDO_DEBUG("Error(%s) len(0x%lx)", strerror(EINVAL), len);
-			return -EINVAL;
-		}
-		PSEUDO_DEBUG("iovec[%d].iov_length(0x%lx)", idx, len);
-	}
-
-	PSEUDO_TRACE("returned(0)");
-	return 0;
-}
-
-/**
- * @brief This function do read/write operation to/from specified process
- * memory to/from calling process memory for each iovec.
- *
- * @param[in] handle Handle VEOS handle.
- * @param[in] r_iovec remote_iovec iovec array specifying where to copy
- * to/from remotelly.
- * @param[in] local_iovec local_iovec iovec array specifying where to copy
- * to/from locally.
- * @param[in] liovcnt number of elements in local iovec array
- * @param[in] curr_lcnt Current numeber local_iovev to/from read/write.
- * @param[in,out] curr_l_offset Current offset on local iovec to read/write.
- * @param[in] r_pid Pid of process to/from read/write
- * @param[in] type Type of operation read/write.
- * 0 for read from remote process, 1 for write to remote process.
- *
- * @return On success return number of bytes read/write to/from remote process.
- * and negative of errno on failure.
- */
-int64_t ve_process_vm_rw_single_iov(veos_handle *handle, struct iovec *r_iovec,
-		struct iovec *local_iovec, size_t liovcnt,
-		size_t *curr_lcnt, size_t *curr_l_offset, pid_t r_pid,
-		int type)
-{
-	vemva_t addr = 0, nr_pages = 0, nr_page_copied = 0;
-	offset_t start_offset = 0;
-	size_t pg_size = 0, min = 0;
-	int64_t data_loops = 0, ret = -1;
-	struct ve_process_rw_info *cmd = NULL;
-	pg_size = PAGE_SIZE_2MB;
+	int64_t ret = 0;
+	struct ve_process_rw_info cmd = {0};
 
 	PSEUDO_TRACE("invoked");
 
-	/* Getting the base address for checking read/write permission */
-	if (!IS_ALIGNED((uint64_t)(r_iovec[0].iov_base),
-				ve_page_info.page_size)) {
-		PSEUDO_DEBUG("Offset is not aligned to page boundary");
-		addr = ALIGN_RD((uint64_t)(r_iovec[0].iov_base), pg_size);
-	} else
-		addr = (vemva_t)(r_iovec[0].iov_base);
-
-	nr_pages = (r_iovec[0].iov_len)/pg_size;
-
-	if (!nr_pages)
-		nr_pages = 1;
-	PSEUDO_DEBUG("addr  = 0x%lx, rbase vemva = %p", addr,
-			r_iovec[0].iov_base);
-
-	nr_page_copied = 0;
-	start_offset = (offset_t)r_iovec[0].iov_base - addr;
-
-	cmd = (struct ve_process_rw_info *)calloc(1, sizeof(struct
-				ve_process_rw_info));
-	if (NULL == cmd) {
-		PSEUDO_DEBUG("Error(%s) while allocating mem for ve_process_rw_info",
-				strerror(errno));
-		return -errno;
-	}
-	cmd->base_rvemva = (uint64_t)(r_iovec[0].iov_base);
-	cmd->r_len = r_iovec[0].iov_len;
-
-	/* This for loop will read/write from/to one remote iovec
-	 * to/from local iovecs base on iovec length*/
-	for (; *curr_lcnt < liovcnt && nr_page_copied < nr_pages;) {
-		while ((0 == local_iovec[*curr_lcnt].iov_len))
-			(*curr_lcnt)++;
-		if (*curr_lcnt == liovcnt || 0 == r_iovec[0].iov_len)
-			break;
-
-		min = (size_t)MIN_2(uint64_t, pg_size - start_offset,
-				(r_iovec[0].iov_len - data_loops));
-		if (start_offset >= pg_size)
-			min = r_iovec[0].iov_len - data_loops;
-		PSEUDO_DEBUG("first  min  = 0x%lx", min);
-		min = (size_t)MIN_2(uint64_t, min, (local_iovec[*curr_lcnt].iov_len -
-					*curr_l_offset));
-		PSEUDO_DEBUG("second min  = 0x%lx", min);
-
-		cmd->r_pid = r_pid;
-		cmd->lcov_offset = *curr_l_offset;
-		cmd->rcov_offest = start_offset;
-		cmd->local_vemva = (vemva_t)(local_iovec[*curr_lcnt].iov_base);
-		cmd->remote_vemva = (vemva_t)(addr + (pg_size * nr_page_copied));
-		cmd->len = min;
-		cmd->vm_rw = type;
-
-		/*sending request veos*/
-		ret = amm_send_proc_vm_rw_req(handle,
-				(struct ve_process_rw_info *)cmd);
-		if (0 > ret) {
-			if (!data_loops) {
-				data_loops = -1;
-				PSEUDO_DEBUG("Error(%s) while sending proc vm (read/write) req",
-						strerror(-ret));
-				goto error_return;
-			} else {
-				PSEUDO_DEBUG("Error(%s) while sending proc vm (read/write) req",
-						strerror(-ret));
-				goto error_return;
+	cmd.r_pid = pid;
+	cmd.local_iov = local_iovec;
+	cmd.liovcnt = liovcnt;
+	cmd.remote_iov = remote_iovec;
+	cmd.riovcnt = riovcnt;
+	cmd.vm_rw = type;
 
-			}
-		}
-		data_loops += min;
-		*curr_l_offset = (*curr_l_offset) + min;
-		/* Moving to next local iovec */
-		if (((*curr_l_offset) >= (local_iovec[*curr_lcnt].iov_len))) {
-			(*curr_lcnt)++;
-			*curr_l_offset = 0;
-		}
-		start_offset += min;
-		if (data_loops >= pg_size)
-			nr_page_copied++;
-		/* Check if one remote iovec is completed or not */
-		if (data_loops >= r_iovec[0].iov_len)  {
-			PSEUDO_DEBUG("data_loops >= r_iovec[0].iov_len");
-			break;
-		}
-	}
+	ret = amm_send_proc_vm_rw_req(handle, &cmd);
+	if (0 > ret)
+		PSEUDO_DEBUG("Error(%s) while sending proc vm (read/write) req",
+				strerror(-ret));
+	else
+		PSEUDO_DEBUG("total byte %s (%ld)",
+				(type) ? "written" : "read", ret);
 
-error_return:
-	if (cmd)
-		free(cmd);
-	PSEUDO_TRACE("returned(%ld)", data_loops);
-	return	data_loops;
+	PSEUDO_TRACE("returned(%ld)", ret);
+	return ret;
 }
 
 /**
@@ -2250,14 +1981,10 @@ int64_t amm_send_proc_vm_rw_req(veos_handle *handle,
 	ProtobufCBinaryData ve_vm_rw_msg = {0};
 
 	PSEUDO_TRACE("invoked");
-	PSEUDO_DEBUG("base_rvemva = 0x%lx, r_len = 0x%lx, len = 0x%lx"
-			" lcov_offeset = 0x%lx, rcov_offest = 0x%lx"
-			" remote_vemva = 0x%lx local_vemva = 0x%lx"
-			"vm_rw = %d",
-			cmd_buf->base_rvemva, cmd_buf->r_len,
-			cmd_buf->len, cmd_buf->lcov_offset,
-			cmd_buf->rcov_offest, cmd_buf->remote_vemva,
-			cmd_buf->local_vemva, cmd_buf->vm_rw);
+	PSEUDO_DEBUG("r_pid = %d, local_iov = 0x%lx, liovcnt = 0x%lx"
+			" remote_iov = 0x%lx, riovcnt = 0x%lx vm_rw = %d",
+			cmd_buf->r_pid, cmd_buf->local_iov, cmd_buf->liovcnt,
+			cmd_buf->remote_iov, cmd_buf->riovcnt, cmd_buf->vm_rw);
 
 
 	ve_vm_rw.pseudo_veos_cmd_id = CMD_VMRW;
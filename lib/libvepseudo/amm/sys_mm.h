@@ -86,16 +86,11 @@ int64_t ve_heap_reduce(veos_handle *handle, vemva_t old_top_address,
 		uint64_t size);
 void *ve_heap_extend(veos_handle *handle, vemva_t old_top_address,
 		uint64_t size);
-int64_t __ve_process_vm_rw(veos_handle *handle, struct iovec *local_iovec,
-		uint64_t liovcnt, struct iovec *remote_iovec, uint64_t riovcnt,
+int64_t __ve_process_vm_rw(veos_handle *handle, vemva_t local_iovec,
+		uint64_t liovcnt, vemva_t remote_iovec, uint64_t riovcnt,
 		pid_t pid, int type);
-int64_t ve_process_vm_rw_single_iov(veos_handle *handle, struct iovec *r_iovec,
-		struct iovec *local_iovec, size_t liovcnt,
-		size_t *curr_lcnt, size_t *curr_l_offset, pid_t r_pid,
-		int type);
 int64_t amm_send_proc_vm_rw_req(veos_handle *handle,
 		struct ve_process_rw_info *cmd_buf);
-int64_t ve_check_iovec(struct iovec *iovec, uint64_t iovcnt);
 int64_t amm_request_mmap(veos_handle *, vemva_t, size_t, int, uint64_t,
 					struct file_stat *);
 
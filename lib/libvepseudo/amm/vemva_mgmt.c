@@ -285,7 +285,6 @@ void *avail_vemva(veos_handle *handle, uint64_t vaddr,
 		uint64_t size, uint64_t flag)
 {
 	struct vemva_struct *vemva_tmp = NULL;
-	struct list_head *temp_list_head = NULL;
 	void *vemva = (void *)-1;
 	void *vemva_base = NULL;
 	int64_t entry = 0;
@@ -315,27 +314,17 @@ void *avail_vemva(veos_handle *handle, uint64_t vaddr,
 	PSEUDO_TRACE("invoked");
 	PSEUDO_DEBUG("invoked with addr: %p Size: %lx flags: %lx req_type %d",
 			(void *)vaddr, size, flag, required_type);
-	/*Fetch the bitmap from vemva_start*/
-	list_for_each(temp_list_head, &vemva_header.vemva_list) {
-		vemva_tmp = list_entry(temp_list_head,
-				struct vemva_struct, list);
+	/*Fetch the bitmap of the directory holding vaddr*/
+	vemva_tmp = find_vemva_dir(vemva_base);
+	if (vemva_tmp && vemva_tmp->type == required_type) {
 		PSEUDO_DEBUG("fetched vemva_base = %p Type %d",
 				vemva_tmp->vemva_base, vemva_tmp->type);
-
-		if (vemva_tmp->type != required_type)
-			continue;
-
-		if (vemva_base == vemva_tmp->vemva_base &&
-				(flag & MAP_FIXED)) {
+		if (flag & MAP_FIXED)
 			vemva = ve_get_fixed_vemva(handle, vemva_tmp,
 					vaddr, entry, count, flag);
-			break;
-		} else if (vemva_base == vemva_tmp->vemva_base &&
-				!(flag & MAP_FIXED)) {
+		else
 			vemva = ve_get_nearby_vemva(handle, vemva_tmp,
 					vaddr, entry, count, flag);
-			break;
-		}
 	}
 
 	/*
@@ -500,8 +489,6 @@ int __ve_free_vemva(void *vemva_addr, size_t size, bool del_dir)
 	uint64_t addr = 0;
 	size_t page_size = 0;
 	size_t chunk_size = 0;
-	struct list_head *temp_list_head = NULL;
-	struct vemva_struct *vemva_tmp = NULL;
 	struct vemva_struct *vemva_del = NULL;
 
 	PSEUDO_TRACE("invoked");
@@ -529,15 +516,8 @@ int __ve_free_vemva(void *vemva_addr, size_t size, bool del_dir)
 		/*Calculate entry using addr*/
 		entry = (addr & (chunk_size - 1))/page_size;
 
-		/*Scan VEMVA list for the matching vemva_base*/
-		list_for_each(temp_list_head, &vemva_header.vemva_list) {
-			vemva_tmp = list_entry(temp_list_head,
-					struct vemva_struct, list);
-			if (vemva_tmp->vemva_base == vemva_base) {
-				vemva_del = vemva_tmp;
-				break;
-			}
-		}
+		/*Look up the directory with the matching vemva_base*/
+		vemva_del = find_vemva_dir(vemva_base);
 
 		ret = check_vemva_mapped((void *)addr, page_size, MARK_USED);
 		if (0 < ret) {
@@ -673,7 +653,6 @@ int mark_vemva(uint64_t vemva, uint64_t size, int flag)
 	int64_t entry = 0;
 	int64_t count = 0;
 	uint64_t vemva_base = 0;
-	struct list_head *temp_list_head = NULL;
 	struct vemva_struct *vemva_tmp = NULL;
 
 	PSEUDO_TRACE("invoked");
@@ -686,12 +665,9 @@ int mark_vemva(uint64_t vemva, uint64_t size, int flag)
 	entry = (vemva & (ve_page_info.chunk_mask))/
 		ve_page_info.page_size;
 
-	list_for_each(temp_list_head, &vemva_header.vemva_list) {
-		vemva_tmp = list_entry(temp_list_head,
-				struct vemva_struct, list);
-		if ((uint64_t)vemva_tmp->vemva_base == vemva_base)
-			goto mark_bits;
-	}
+	vemva_tmp = find_vemva_dir((void *)vemva_base);
+	if (vemva_tmp)
+		goto mark_bits;
 
 	PSEUDO_DEBUG("VEMVA not found in existing list");
 	return -1;
@@ -735,17 +711,27 @@ void mark_bits(struct vemva_struct *vemva_dir,
 	PSEUDO_TRACE("invoked");
 	PSEUDO_DEBUG("invoked with count %ld func", count);
 
+	/* VE pages released here may still be cached as valid */
+	if (flag & MARK_UNUSED)
+		vemva_valid_cache_invalidate();
+
 	for (ent = 0; ent < count; ent++) {
 		if (flag & MARK_USED) {
 			bitmap[word] = bitmap[word] &
 				(~((uint64_t)1 << bit++));
-			if (!(flag & MARK_VESHM) && !(flag & MARK_FILE))
+			if (!(flag & MARK_VESHM) && !(flag & MARK_FILE)) {
 				vemva_dir->used_count++;
+				vemva_header.nr_free[VEMVA_DIR_TYPE_INDEX(
+						vemva_dir->type)]--;
+			}
 		} else if (flag & MARK_UNUSED) {
 			bitmap[word] = bitmap[word] |
 				((uint64_t)1 << bit++);
-			if (!(flag & MARK_VESHM) && !(flag & MARK_FILE))
+			if (!(flag & MARK_VESHM) && !(flag & MARK_FILE)) {
 				vemva_dir->used_count--;
+				vemva_header.nr_free[VEMVA_DIR_TYPE_INDEX(
+						vemva_dir->type)]++;
+			}
 		}
 		if (bit >= BITS_PER_WORD) {
 			word++;
@@ -871,6 +857,13 @@ void *scan_vemva_dir_list(veos_handle *handle, uint64_t count, uint64_t flag)
 
 	PSEUDO_TRACE("invoked");
 	PSEUDO_DEBUG("invoked with count %ld", count);
+
+	/* No directory of this type has a free page */
+	if (!vemva_header.nr_free[VEMVA_DIR_TYPE_INDEX(required_type)]) {
+		PSEUDO_DEBUG("no free vemva of type %d", required_type);
+		return vemva;
+	}
+
 	/*
 	 * Scan the entire pseudo_vemva list to get the available
 	 * VEMVA.
@@ -882,6 +875,13 @@ void *scan_vemva_dir_list(veos_handle *handle, uint64_t count, uint64_t flag)
 		if (vemva_tmp->type != required_type)
 			continue;
 
+		/*
+		 * Free VEMVA beginning in a full directory would begin
+		 * in the next one, which is scanned on its own
+		 */
+		if (vemva_tmp->used_count >= ENTRIES_PER_DIR)
+			continue;
+
 		vemva = ve_get_free_vemva(handle, vemva_tmp, 0, count);
 		if (vemva == (void *)-1)
 			continue;
@@ -912,6 +912,7 @@ int init_vemva_header(void)
 		PSEUDO_DEBUG("Init vemva_lock failed");
 		return -1;
 	}
+	vemva_header.valid_gen = 1;
 
 	PSEUDO_DEBUG("Return: Success");
 	PSEUDO_TRACE("returned");
@@ -932,8 +933,6 @@ int vemva_mapped(void *vemva_addr, size_t size, uint8_t flag)
 {
 	void *vemva_base = NULL;
 	int64_t entry = 0;
-	struct list_head *temp_list_head = NULL;
-	struct vemva_struct *vemva_tmp = NULL;
 	struct vemva_struct *vemva_del = NULL;
 
 	int64_t count = 0;
@@ -952,15 +951,7 @@ int vemva_mapped(void *vemva_addr, size_t size, uint8_t flag)
 
 	/*Scan VEMVA list for the matching vemva_base*/
 	if (!list_empty(&vemva_header.vemva_list)) {
-		/*First check vemva_base in vemva_start*/
-		list_for_each(temp_list_head, &vemva_header.vemva_list) {
-			vemva_tmp = list_entry(temp_list_head,
-					struct vemva_struct, list);
-			if (vemva_tmp->vemva_base == vemva_base) {
-				vemva_del = vemva_tmp;
-				break;
-			}
-		}
+		vemva_del = find_vemva_dir(vemva_base);
 		if (vemva_del == NULL) {
 			PSEUDO_DEBUG("vemva %p not allocated",
 					vemva_addr);
@@ -1138,8 +1129,6 @@ uint64_t __get_page_size(vemva_t vaddr)
 {
 	void *vemva_base = NULL;
 	void *vemva_base_h = NULL;
-	struct list_head *temp_list_head = NULL;
-	struct vemva_struct *vemva_tmp = NULL;
 	struct vemva_struct *vemva_req = NULL;
 	uint64_t page_size = 0;
 
@@ -1154,16 +1143,9 @@ uint64_t __get_page_size(vemva_t vaddr)
 
 	/*Scan VEMVA list for the matching vemva_base*/
 	if (!list_empty(&vemva_header.vemva_list)) {
-		/*First check vemva_base in vemva_start*/
-		list_for_each(temp_list_head, &vemva_header.vemva_list) {
-			vemva_tmp = list_entry(temp_list_head,
-					struct vemva_struct, list);
-			if ((vemva_tmp->vemva_base == vemva_base) ||
-					(vemva_tmp->vemva_base == vemva_base_h)) {
-				vemva_req = vemva_tmp;
-				break;
-			}
-		}
+		vemva_req = find_vemva_dir(vemva_base);
+		if (vemva_req == NULL)
+			vemva_req = find_vemva_dir(vemva_base_h);
 		if (vemva_req == NULL) {
 			PSEUDO_DEBUG("vaddr %lx not found in allocated DIR",
 					vaddr);
@@ -1368,6 +1350,45 @@ err_exit:
 	return vemva_ret;
 }
 
+/**
+ * @brief Find the position of a VEMVA base in the directory index.
+ *
+ * @param[in] vemva_base VEMVA base to look for
+ *
+ * @return Position of the first directory whose base is not below
+ * vemva_base.
+ */
+static uint64_t vemva_dir_index_pos(void *vemva_base)
+{
+	uint64_t lo = 0, hi = vemva_header.vemva_count, mid = 0;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (vemva_header.dir_index[mid]->vemva_base < vemva_base)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/**
+ * @brief Find the VEMVA directory with the given base.
+ *
+ * @param[in] vemva_base VEMVA base of the directory
+ *
+ * @return Pointer to the directory, NULL if there is none.
+ */
+struct vemva_struct *find_vemva_dir(void *vemva_base)
+{
+	uint64_t pos = vemva_dir_index_pos(vemva_base);
+
+	if (pos < vemva_header.vemva_count &&
+			vemva_header.dir_index[pos]->vemva_base == vemva_base)
+		return vemva_header.dir_index[pos];
+	return NULL;
+}
+
 /**
  * @brief This function adds newly allocated VEMVA Chunks
  * in VEMVA list in accending order and update consec dir
@@ -1382,6 +1403,7 @@ void add_vemva_dir_in_list(struct vemva_struct *vemva_add)
 	struct vemva_struct *vemva_next = NULL;
 	struct vemva_struct *vemva_prev = NULL;
 	struct list_head *temp_list_head = NULL;
+	uint64_t pos = 0;
 	void *vemva_cur_base = NULL;
 	void *vemva_cur_top = NULL;
 	void *vemva_next_base = NULL;
@@ -1459,6 +1481,16 @@ added:
 			vemva_prev->consec_dir = 1;
 	}
 
+	/* Insert in the directory index at the same position */
+	pos = vemva_dir_index_pos(vemva_add->vemva_base);
+	memmove(&vemva_header.dir_index[pos + 1],
+			&vemva_header.dir_index[pos],
+			(vemva_header.vemva_count - pos) *
+			sizeof(struct vemva_struct *));
+	vemva_header.dir_index[pos] = vemva_add;
+	vemva_header.nr_free[VEMVA_DIR_TYPE_INDEX(vemva_add->type)] +=
+		ENTRIES_PER_DIR - vemva_add->used_count;
+
 	vemva_header.vemva_count++;
 	PSEUDO_TRACE("returned");
 }
@@ -1476,6 +1508,7 @@ int dealloc_vemva_dir(struct vemva_struct *vemva_del)
 	struct list_head *temp_list_head = NULL;
 	struct vemva_struct *vemva_current = NULL;
 	struct vemva_struct *vemva_prev = NULL;
+	uint64_t pos = 0;
 
 	PSEUDO_TRACE("invoked");
 	PSEUDO_DEBUG("invoked with vemva_del: %p",
@@ -1512,6 +1545,13 @@ int dealloc_vemva_dir(struct vemva_struct *vemva_del)
 
 	__list_del(vemva_del->list.prev,
 			vemva_del->list.next);
+	pos = vemva_dir_index_pos(vemva_del->vemva_base);
+	memmove(&vemva_header.dir_index[pos],
+			&vemva_header.dir_index[pos + 1],
+			(vemva_header.vemva_count - pos - 1) *
+			sizeof(struct vemva_struct *));
+	vemva_header.nr_free[VEMVA_DIR_TYPE_INDEX(vemva_del->type)] -=
+		ENTRIES_PER_DIR - vemva_del->used_count;
 	vemva_header.vemva_count--;
 
 	free(vemva_del);
@@ -1534,8 +1574,6 @@ int check_vemva_mapped(void *vemva_addr, size_t page_size, uint8_t flag)
 {
 	void *vemva_base = NULL;
 	int64_t entry = 0;
-	struct list_head *temp_list_head = NULL;
-	struct vemva_struct *vemva_tmp = NULL;
 	struct vemva_struct *vemva_del = NULL;
 
 	int64_t count = 1;
@@ -1555,15 +1593,7 @@ int check_vemva_mapped(void *vemva_addr, size_t page_size, uint8_t flag)
 
 	/*Scan VEMVA list for the matching vemva_base*/
 	if (!list_empty(&vemva_header.vemva_list)) {
-		/*First check vemva_base in vemva_start*/
-		list_for_each(temp_list_head, &vemva_header.vemva_list) {
-			vemva_tmp = list_entry(temp_list_head,
-					struct vemva_struct, list);
-			if (vemva_tmp->vemva_base == vemva_base) {
-				vemva_del = vemva_tmp;
-				break;
-			}
-		}
+		vemva_del = find_vemva_dir(vemva_base);
 		if (vemva_del == NULL) {
 			PSEUDO_DEBUG("vemva %p not allocated",
 					vemva_addr);
@@ -1587,3 +1617,68 @@ int check_vemva_mapped(void *vemva_addr, size_t page_size, uint8_t flag)
 	PSEUDO_TRACE("returned");
 	return 0;
 }
+
+/**
+ * @brief Look up a VE address in the cache of VE pages known to be valid.
+ *
+ * @param[in] vaddr VE address to look up
+ *
+ * @return true if the page of vaddr was found valid since the last
+ * unmap or protection change, false otherwise.
+ */
+bool vemva_valid_cache_lookup(vemva_t vaddr)
+{
+	uint64_t granule = (uint64_t)vaddr >> VEMVA_VALID_SHIFT;
+	uint64_t tag = ((uint64_t)vemva_header.valid_gen << 32) | granule;
+
+	return vemva_header.valid_cache[granule %
+		VEMVA_VALID_CACHE_SIZE] == tag;
+}
+
+/**
+ * @brief Get the current generation of the valid VE page cache.
+ *
+ * Generation has to be fetched before asking VEOS about an address so
+ * that an unmap racing with the request discards the result.
+ *
+ * @return Current generation.
+ */
+uint32_t vemva_valid_cache_gen(void)
+{
+	return __sync_fetch_and_add(&vemva_header.valid_gen, 0);
+}
+
+/**
+ * @brief Record a VE address which VEOS has found valid.
+ *
+ * Only pages tracked as used in a VEMVA directory are recorded, as
+ * freeing those invalidates the cache.
+ *
+ * @param[in] vaddr VE address found valid
+ * @param[in] gen Generation fetched before VEOS was asked
+ */
+void vemva_valid_cache_add(vemva_t vaddr, uint32_t gen)
+{
+	uint64_t granule = (uint64_t)vaddr >> VEMVA_VALID_SHIFT;
+	uint64_t page_size = 0;
+
+	pthread_mutex_lock(&vemva_header.vemva_lock);
+	page_size = __get_page_size(vaddr);
+	if (page_size && check_vemva_mapped((void *)vaddr, page_size,
+				MARK_USED))
+		vemva_header.valid_cache[granule % VEMVA_VALID_CACHE_SIZE] =
+			((uint64_t)gen << 32) | granule;
+	pthread_mutex_unlock(&vemva_header.vemva_lock);
+}
+
+/**
+ * @brief Forget all VE addresses known to be valid.
+ *
+ * Invoked whenever VEMVA is freed or its protection is changed.
+ * Generation 0 is skipped as it matches never filled entries.
+ */
+void vemva_valid_cache_invalidate(void)
+{
+	if (0 == __sync_add_and_fetch(&vemva_header.valid_gen, 1))
+		__sync_add_and_fetch(&vemva_header.valid_gen, 1);
+}
@@ -71,6 +71,9 @@
 #define ADDR_SPACE_2MB		((uint8_t)1 << 1)
 #define ANON_SPACE_64MB		((uint8_t)1 << 2)
 #define ADDR_SPACE_64MB		((uint8_t)1 << 3)
+/* Number of directory types and index of a type in per-type arrays */
+#define VEMVA_DIR_TYPES		4
+#define VEMVA_DIR_TYPE_INDEX(type)	(__builtin_ctz(type))
 
 
 /* Mapping control flags */
@@ -90,6 +93,11 @@
 #define MARK_VESHM		(((uint8_t)1)<<4)
 #define MARK_FILE		(((uint8_t)1)<<5)
 
+/* Number of entries in the cache of VE pages known to be valid */
+#define VEMVA_VALID_CACHE_SIZE	256
+/* Granularity of the cache of VE pages known to be valid */
+#define VEMVA_VALID_SHIFT	21
+
 extern uint64_t default_page_size;
 /**
  * @brief Structure to store ve page info
@@ -113,6 +121,10 @@ struct vemva_header {
 	uint64_t ve_heap;		/*!< ve heap section address */
 	uint64_t ve_stack;		/*!< ve stack section address */
 	struct list_head vemva_list;	/*!< list head for vemva list*/
+	struct vemva_struct *dir_index[MAX_VEMVA_LIST]; /*!< dirs by base */
+	uint64_t nr_free[VEMVA_DIR_TYPES]; /*!< free pages per dir type */
+	uint32_t valid_gen;		/*!< generation of valid_cache */
+	uint64_t valid_cache[VEMVA_VALID_CACHE_SIZE]; /*!< VE pages known valid */
 };
 extern struct vemva_header vemva_header;
 
@@ -153,6 +165,7 @@ struct vemva_struct *alloc_vemva_dir(veos_handle *, struct vemva_struct *,
 		uint64_t, uint16_t, int64_t);
 int dealloc_vemva_dir(struct vemva_struct *);
 void add_vemva_dir_in_list(struct vemva_struct *);
+struct vemva_struct *find_vemva_dir(void *);
 
 int mark_vemva(uint64_t, uint64_t, int);
 int check_bits(struct vemva_struct *, int64_t, int64_t, uint8_t);
@@ -166,4 +179,9 @@ uint64_t __get_page_size(vemva_t vaddr);
 
 int vemva_mapped(void *, size_t, uint8_t);
 int check_vemva_mapped(void *, size_t, uint8_t);
+
+bool vemva_valid_cache_lookup(vemva_t);
+uint32_t vemva_valid_cache_gen(void);
+void vemva_valid_cache_add(vemva_t, uint32_t);
+void vemva_valid_cache_invalidate(void);
 #endif
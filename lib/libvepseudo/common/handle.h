@@ -32,6 +32,7 @@ struct veos_handle_struct {
 	char *veos_sock_name;
 	int veos_sock_fd;
 	void *ext_data;/* for VEO or other extensions */
+	int fast_ipc;/* fast path framing version agreed with VEOS */
 };
 
 typedef struct veos_handle_struct veos_handle;
@@ -42,6 +42,7 @@
 #include "pseudo_vhshm.h"
 #include "sys_veaio.h"
 #include "sys_accelerated_io.h"
+#include "vemva_mgmt.h"
 
 /**
  * @brief This function will be invoked to handle the MONC interrupt
@@ -1522,6 +1523,7 @@ veos_handle *veos_handle_create(char *device, char *os_socket,
 	}
 
 	veos_hndl->veos_sock_fd = fd;
+	veos_hndl->fast_ipc = pseudo_veos_fast_ipc_negotiate(fd);
 	veos_hndl->veos_sock_name = strdup(os_socket);
 	veos_hndl->device_name = strdup(device);
 	if (veos_hndl->device_name == NULL ||
@@ -1607,6 +1609,14 @@ ret_t ve_is_valid_address(veos_handle *handle, uint64_t addr)
 {
 	ret_t retval = -1;
 	char check_buff[1] = {0};
+	uint32_t gen = 0;
+
+	/* VE pages already found valid need no round trip to VEOS */
+	if (vemva_valid_cache_lookup(addr)) {
+		PSEUDO_DEBUG("VE address %lx is known to be valid", addr);
+		return 0;
+	}
+	gen = vemva_valid_cache_gen();
 
 	/* check whether VE address is valid or invalid by
 	 * receiving 1 byte data from the VE address
@@ -1617,6 +1627,7 @@ ret_t ve_is_valid_address(veos_handle *handle, uint64_t addr)
 		return -1;
 	}
 
+	vemva_valid_cache_add(addr, gen);
 	PSEUDO_DEBUG("Successfully received data from VE memory");
 	return 0;
 }
@@ -35,6 +35,7 @@
 #include <unistd.h>
 #include <errno.h>
 #include "sys_common.h"
+#include "comm_request.h"
 #include "ve_socket.h"
 #include "exception.h"
 #include "libved.h"
@@ -265,3 +266,99 @@ recv_error:
 	PSEUDO_TRACE("Exiting");
 	return ret;
 }
+
+/**
+ * @brief Get the fast path version agreed on the socket.
+ *
+ *	Fast path is agreed per connection when the VEOS handle is created,
+ *	so it is looked up in the handle of the calling thread.
+ *
+ * @param sock_fd Descriptor used to communicate with VEOS
+ *
+ * @return version agreed with VEOS, 0 if fast path is not used
+ */
+int pseudo_veos_fast_ipc(int sock_fd)
+{
+	if (g_handle && g_handle->veos_sock_fd == sock_fd)
+		return g_handle->fast_ipc;
+	return 0;
+}
+
+/**
+ * @brief This function sends a request to VEOS on the fast path.
+ *
+ * @param sock_fd Descriptor used to communicate with VEOS
+ * @param version Fast path version agreed on the socket
+ * @param cmd_id Command ID
+ * @param pid TID of the requesting thread
+ * @param syscall_retval System call return value
+ * @param msg Payload of request, may be NULL
+ * @param len Length of payload
+ *
+ * @return On failure, returns -1 and on success, returns any positive value
+ */
+ssize_t pseudo_veos_send_fast_cmd(int sock_fd, int version, int cmd_id,
+		pid_t pid, int64_t syscall_retval, void *msg, size_t len)
+{
+	char buff[MAX_PROTO_MSG_SIZE];
+	struct veos_fast_hdr hdr = {0};
+	ssize_t ret = -1;
+
+	PSEUDO_TRACE("Entering");
+
+	if (len > VEOS_FAST_IPC_MAX_PAYLOAD) {
+		PSEUDO_ERROR("Fast path request too long");
+		PSEUDO_DEBUG("Payload length: %lu", len);
+		goto send_error;
+	}
+
+	hdr.magic = VEOS_FAST_IPC_MAGIC;
+	hdr.version = version;
+	hdr.cmd_id = cmd_id;
+	hdr.pid = pid;
+	hdr.len = len;
+	hdr.syscall_retval = syscall_retval;
+	memcpy(buff, &hdr, sizeof(hdr));
+	if (len)
+		memcpy(buff + sizeof(hdr), msg, len);
+
+	ret = pseudo_veos_send_cmd(sock_fd, buff, sizeof(hdr) + len);
+	if (ret < (ssize_t)(sizeof(hdr) + len))
+		ret = -1;
+
+send_error:
+	PSEUDO_TRACE("Exiting");
+	return ret;
+}
+
+/**
+ * @brief This function decodes an acknowledgment received on the fast path.
+ *
+ * @param buff Response returned from VEOS
+ * @param len Length of response
+ * @param[out] syscall_retval System call return value
+ * @param[out] data Buffer for payload of acknowledgment, may be NULL
+ * @param data_len Size of data buffer
+ *
+ * @return true if the response is a fast path acknowledgment, false if it
+ * is a packed PseudoVeosMessage.
+ */
+bool pseudo_veos_recv_fast_ack(void *buff, ssize_t len,
+		int64_t *syscall_retval, void *data, size_t data_len)
+{
+	struct veos_fast_hdr hdr;
+
+	if (len < (ssize_t)sizeof(hdr))
+		return false;
+	memcpy(&hdr, buff, sizeof(hdr));
+	if (hdr.magic != VEOS_FAST_IPC_MAGIC)
+		return false;
+
+	*syscall_retval = hdr.syscall_retval;
+	if (data && hdr.len <= len - sizeof(hdr)) {
+		if (hdr.len < data_len)
+			data_len = hdr.len;
+		memcpy(data, (char *)buff + sizeof(hdr), data_len);
+	}
+	return true;
+}
@@ -29,9 +29,16 @@
 #ifndef __VE_SOCKET_H
 #define __VE_SOCKET_H
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
 int pseudo_veos_soc(char *);
 ssize_t pseudo_veos_recv_cmd(int, void *, ssize_t);
 ssize_t pseudo_veos_send_cmd(int, void *, ssize_t);
 ssize_t pseudo_veos_recv_signal_ack(int, void *, ssize_t);
 ssize_t pseudo_veos_send_signal_req(int, void *, ssize_t);
+int pseudo_veos_fast_ipc(int);
+ssize_t pseudo_veos_send_fast_cmd(int, int, int, pid_t, int64_t, void *, size_t);
+bool pseudo_veos_recv_fast_ack(void *, ssize_t, int64_t *, void *, size_t);
 #endif
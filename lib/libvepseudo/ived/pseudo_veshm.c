@@ -27,6 +27,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <unistd.h>
 #include <error.h>
@@ -52,6 +53,10 @@
 #include "pseudo_veshm_pgmode.h"
 
 #define	VESHM_MAX_ARGS	5
+/* An element of batch attach: VESHM_ATTACH arguments and uuid */
+#define	VESHM_BATCH_ATTACH_ARGS	(VESHM_MAX_ARGS + 2)
+/* A result of batch attach: address or -errno, and uuid */
+#define	VESHM_BATCH_ATTACH_RETS	3
 
 int veshm_test = 0;
 
@@ -318,6 +323,319 @@ pseudo_veshm_detach(uint64_t *args, veos_handle *handle)
 }
 
 
+/* A chunk of a batch attach must fit in one message, and so must the
+ * replies to a whole batch */
+_Static_assert(VESHM_BATCH_MSG_MAX(sizeof(struct veshm_batch_attach)) > 0,
+	       "VESHM batch attach element exceeds MAX_PROTO_MSG_SIZE");
+_Static_assert(sizeof(struct veshm_batch_result) * VESHM_BATCH_MAX
+	       + VESHM_BATCH_MSG_FRAMING <= MAX_PROTO_MSG_SIZE,
+	       "VESHM batch reply exceeds MAX_PROTO_MSG_SIZE");
+
+/**
+ * @brief Send a batch request of VESHM to VEOS
+ *
+ * A batch whose elements don't fit in MAX_PROTO_MSG_SIZE is sent as
+ * several requests of at most VESHM_BATCH_MSG_MAX(ent_size) elements.
+ * If VEOS rejects a request, all the elements of that request fail
+ * with its error.
+ *
+ * @param [in]     handle   veos_handle
+ * @param [in]     batch    Request (subcmd and num are set)
+ * @param [in]     ent_size Size of an element of the request
+ * @param [out]    result   Results of elements
+ *
+ * @retval # of succeeded elements
+ */
+static int
+pseudo_veshm_exchange_batch(veos_handle *handle,
+			    struct veshm_batch_args *batch, size_t ent_size,
+			    struct veshm_batch_result *result)
+{
+	int i, ret, retval, done = 0;
+	int pos, num, max = VESHM_BATCH_MSG_MAX(ent_size);
+	size_t len;
+	struct veshm_batch_args chunk;
+	PseudoVeosMessage ve_veshm_req = PSEUDO_VEOS_MESSAGE__INIT;
+	ProtobufCBinaryData ve_veshm_req_msg;
+	PseudoVeosMessage *ret_msg = NULL;
+
+	chunk.subcmd = batch->subcmd;
+
+	for (pos = 0; pos < batch->num; pos += num){
+		num = batch->num - pos;
+		if (num > max)
+			num = max;
+		chunk.num = num;
+		memcpy(&chunk.arg, (uint8_t *)&batch->arg + ent_size * pos,
+		       ent_size * num);
+
+		/* Send only used elements */
+		ve_veshm_req_msg.len = offsetof(struct veshm_batch_args, arg)
+			+ ent_size * num;
+		ve_veshm_req_msg.data = (uint8_t *)&chunk;
+
+		ve_veshm_req.pseudo_veos_cmd_id = CMD_VESHM;
+		ve_veshm_req.has_pseudo_pid = true;
+		ve_veshm_req.pseudo_pid = syscall(SYS_gettid);
+		ve_veshm_req.has_pseudo_msg = true;
+		ve_veshm_req.pseudo_msg = ve_veshm_req_msg;
+
+		ret = exchange_request(handle, &ve_veshm_req, &ret_msg);
+		if (ret != 0 ){
+			IVED_ERROR(log4cat_pseudo_ived, 
+				   "Failed to send VESHM request. (%d)", ret);
+			fprintf(stderr,
+				"Failed to send VESHM request to VEOS.\n");
+			pseudo_abort();
+		}
+		retval = ret_msg->syscall_retval;
+
+		len = sizeof(struct veshm_batch_result) * num;
+		if (retval >= 0 && ret_msg->has_pseudo_msg
+		    && ret_msg->pseudo_msg.len == len){
+			memcpy(&result[pos], ret_msg->pseudo_msg.data, len);
+			done += retval;
+		} else {
+			if (retval >= 0){
+				IVED_ERROR(log4cat_pseudo_ived, 
+					   "Invalid VESHM batch reply");
+				retval = -ECANCELED;
+			}
+			memset(&result[pos], 0, len);
+			for (i = pos; i < pos + num; i++)
+				result[i].retval = retval;
+		}
+		pseudo_veos_message__free_unpacked(ret_msg, NULL);
+		ret_msg = NULL;
+	}
+
+	return(done);
+}
+
+/**
+ * @brief System call function for batch VESHM attach
+ *
+ * args[1]: Address of arrays of VESHM_ATTACH arguments and uuid
+ *          (owner_pid, vemva, size, syncnum, mode_flag, uuid[2])
+ *          uuid is 16 bytes of zero, or uuid returned by a previous
+ *          batch attach to attach only that VESHM (-ESTALE if renewed)
+ * args[2]: # of arrays
+ * args[3]: Address of results (attached address or -errno, uuid[2]
+ *          per element)
+ *
+ * @param [in]     args  Arguments of the system call
+ * @param [in]     handle veos_handle
+ *
+ * @retval # of attached VESHMs on success, -errno on failure.
+ */
+int64_t
+pseudo_veshm_attach_batch(uint64_t *args, veos_handle *handle)
+{
+	int i, n, ret;
+	int num;
+	int64_t retval = -ECANCELED;
+	int64_t local_pgsize;
+	uint64_t flag, mode_flag;
+	uint64_t ent[VESHM_BATCH_MAX][VESHM_BATCH_ATTACH_ARGS];
+	int64_t result[VESHM_BATCH_MAX][VESHM_BATCH_ATTACH_RETS];
+	int64_t attached_vemva[VESHM_BATCH_MAX];
+	int idx[VESHM_BATCH_MAX];	/* index of an element in a request */
+	struct veshm_batch_args batch;
+	struct veshm_batch_result batch_ret[VESHM_BATCH_MAX];
+	struct attach_arg *attach;
+
+	IVED_TRACE(log4cat_pseudo_ived, "PASS");
+
+	memset(result, 0, sizeof(result));
+
+	if (args == NULL || handle == NULL){
+		IVED_CRIT(log4cat_pseudo_ived, 
+			  "Internal error: Argument is NULL");
+		return(-ECANCELED);
+	}
+
+	num = (int)args[2];
+	if (num <= 0 || num > VESHM_BATCH_MAX)
+		return(-EINVAL);
+
+	ret = ve_recv_data(handle, args[1],
+			   sizeof(uint64_t) * VESHM_BATCH_ATTACH_ARGS * num, ent);
+	if (ret != 0){
+		IVED_ERROR(log4cat_pseudo_ived, 
+			   "Load arguments failed:%"PRIx64"\n", args[1]);
+		return(-EINVAL);
+	}
+
+	/* Generate IPC Command. Elements which fail here are not sent. */
+	batch.subcmd = VESHM_ATTACH_BATCH;
+	for (i = 0, n = 0; i < num; i++){
+		attach = &batch.arg.attach[n].arg;
+		memcpy(batch.arg.attach[n].uuid_veshm, &ent[i][VESHM_MAX_ARGS],
+		       sizeof(batch.arg.attach[n].uuid_veshm));
+		attach->owner_pid = (uint32_t)ent[i][0];
+		attach->vemva     = ent[i][1];
+		attach->size      = ent[i][2];
+		attach->syncnum   = (uint32_t)ent[i][3];
+		attach->mode_flag = ent[i][4];
+		attach->user_vemva = -1;
+
+		/* If VE_REGISTER_VEMVA, get vemva for a VESHM user */
+		mode_flag = attach->mode_flag;
+		if (isset_flag(mode_flag, VE_REGISTER_VEMVA)){
+			local_pgsize = pseudo_veshm_get_pgmode
+				(handle, (uint8_t)VE_ADDR_VEMVA, 
+				 attach->owner_pid, attach->vemva);
+			if (local_pgsize < 0){
+				result[i][0] = -EINVAL;
+				continue;
+			} else if (local_pgsize == PGSIZE_2M){
+				flag = MAP_2MB;
+			} else {
+				flag = MAP_64MB;
+			}
+			flag |= MAP_PRIVATE | MAP_ANON | MAP_VESHM;
+
+			attach->user_vemva = (int64_t)ve_get_vemva
+				(handle, (uint64_t)NULL, attach->size, flag, 
+				 PROT_READ|PROT_WRITE, -1, 0);
+			if ((int64_t)attach->user_vemva < 0){
+				result[i][0] = -ENOMEM;
+				continue;
+			}
+		}
+		attached_vemva[n] = attach->user_vemva;
+		idx[n++] = i;
+	}
+	batch.num = n;
+
+	if (n > 0){
+		pseudo_veshm_exchange_batch
+			(handle, &batch, sizeof(struct veshm_batch_attach),
+			 batch_ret);
+		for (i = 0; i < n; i++){
+			attach = &batch.arg.attach[i].arg;
+			result[idx[i]][0] = batch_ret[i].retval;
+			if (result[idx[i]][0] >= 0)
+				memcpy(&result[idx[i]][1],
+				       batch_ret[i].uuid_veshm,
+				       sizeof(batch_ret[i].uuid_veshm));
+			if (isset_flag(attach->mode_flag, VE_REGISTER_VEMVA)
+			    && result[idx[i]][0] != attached_vemva[i]){
+				/* Free unnecessary VEMVA */
+				ve_free_vemva((void *)attached_vemva[i],
+					      attach->size);
+			}
+		}
+	}
+
+	retval = 0;
+	for (i = 0; i < num; i++){
+		if (result[i][0] >= 0)
+			retval++;
+	}
+
+	ret = ve_send_data(handle, args[3],
+			   sizeof(int64_t) * VESHM_BATCH_ATTACH_RETS * num,
+			   result);
+	if (ret != 0){
+		IVED_ERROR(log4cat_pseudo_ived, 
+			   "Store results failed:%"PRIx64"\n", args[3]);
+		retval = -EFAULT;
+	}
+
+	IVED_DEBUG(log4cat_pseudo_ived, "VESHM batch attaching: %d/%d",
+		   (int)retval, num);
+	return(retval);
+}
+
+
+/**
+ * @brief System call function for batch VESHM detach
+ *
+ * args[1]: Address of arrays of VESHM_DETACH arguments (address, mode_flag)
+ * args[2]: # of arrays
+ * args[3]: Address of results (0 or -errno per element)
+ *
+ * @param [in]     args  Arguments of the system call
+ * @param [in]     handle veos_handle
+ *
+ * @retval # of detached VESHMs on success, -errno on failure.
+ */
+int 
+pseudo_veshm_detach_batch(uint64_t *args, veos_handle *handle)
+{
+	int i, ret, retval;
+	int num;
+	uint64_t ent[VESHM_BATCH_MAX][2];
+	int64_t result[VESHM_BATCH_MAX];
+	struct veshm_batch_args batch;
+	struct veshm_batch_result batch_ret[VESHM_BATCH_MAX];
+
+	IVED_TRACE(log4cat_pseudo_ived, "PASS");
+
+	if (args == NULL || handle == NULL){
+		IVED_CRIT(log4cat_pseudo_ived, 
+			  "Internal error: Argument is NULL");
+		return(-ECANCELED);
+	}
+
+	num = (int)args[2];
+	if (num <= 0 || num > VESHM_BATCH_MAX)
+		return(-EINVAL);
+
+	ret = ve_recv_data(handle, args[1], sizeof(uint64_t) * 2 * num, ent);
+	if (ret != 0){
+		IVED_ERROR(log4cat_pseudo_ived, 
+			   "Load arguments failed:%"PRIx64"\n", args[1]);
+		return(-EINVAL);
+	}
+
+	/* Generate IPC Command */
+	batch.subcmd = VESHM_DETACH_BATCH;
+	batch.num    = num;
+	for (i = 0; i < num; i++){
+		batch.arg.detach[i].address   = ent[i][0];
+		batch.arg.detach[i].mode_flag = ent[i][1];
+	}
+
+	pseudo_veshm_exchange_batch
+		(handle, &batch, sizeof(struct detach_arg), batch_ret);
+
+	for (i = 0; i < num; i++){
+		result[i] = batch_ret[i].retval;
+
+		/* If VE_REGISTER_VEMVA, free vemva for a VESHM user */
+		if (result[i] >= 0 && isset_flag(ent[i][1], VE_REGISTER_VEMVA)
+		    && batch_ret[i].num == 0 && batch_ret[i].size != 0){
+			ve_free_vemva((void *)ent[i][0], batch_ret[i].size);
+		}
+
+		/* Same as pseudo_veshm_detach() */
+		if (result[i] == -ECANCELED)
+			result[i] = 0;
+		else if (result[i] == -ESRCH)
+			result[i] = -ECANCELED;
+	}
+
+	retval = 0;
+	for (i = 0; i < num; i++){
+		if (result[i] >= 0)
+			retval++;
+	}
+
+	ret = ve_send_data(handle, args[3], sizeof(int64_t) * num, result);
+	if (ret != 0){
+		IVED_ERROR(log4cat_pseudo_ived, 
+			   "Store results failed:%"PRIx64"\n", args[3]);
+		retval = -EFAULT;
+	}
+
+	IVED_DEBUG(log4cat_pseudo_ived, "VESHM batch detaching: %d/%d",
+		   retval, num);
+	return(retval);
+}
+
+
 /**
  * @brief System call function for VESHM close
  *
@@ -420,6 +738,8 @@ ve_veshm(veos_handle *handle, uint64_t *args)
 		case VESHM_ATTACH:
 		case VESHM_DETACH:
 		case VESHM_CLOSE:
+		case VESHM_ATTACH_BATCH:
+		case VESHM_DETACH_BATCH:
 			IVED_ERROR(log4cat_pseudo_ived, 
 				   "VESHM for 2MB binary is not available.");
 			return(-ENOTSUP);
@@ -455,6 +775,14 @@ ve_veshm(veos_handle *handle, uint64_t *args)
 		retval = pseudo_veshm_close(args, handle);
 		break;
 
+	case VESHM_ATTACH_BATCH:
+		retval = pseudo_veshm_attach_batch(args, handle);
+		break;
+
+	case VESHM_DETACH_BATCH:
+		retval = pseudo_veshm_detach_batch(args, handle);
+		break;
+
 	case VESHM_PGSIZE: 
 		retval = pseudo_get_pgsize(args, handle);
 		break;
@@ -39,4 +39,6 @@ ret_t ve_veshm(veos_handle *handle, uint64_t *);
 
 int64_t pseudo_veshm_attach(uint64_t *, veos_handle *handle);
 int pseudo_veshm_detach(uint64_t *, veos_handle *handle);
+int64_t pseudo_veshm_attach_batch(uint64_t *, veos_handle *handle);
+int pseudo_veshm_detach_batch(uint64_t *, veos_handle *handle);
 #endif
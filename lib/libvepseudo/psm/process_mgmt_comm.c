@@ -131,6 +131,7 @@ int64_t pseudo_psm_send_schedule_req(int veos_sock_fd)
 	PseudoVeosMessage ve_schedule_req = PSEUDO_VEOS_MESSAGE__INIT;
 	void *buf = NULL;
 	ssize_t pseudo_msg_len = 0, msg_len = 0;
+	int fast_ipc = 0;
 
 	PSEUDO_TRACE("Entering");
 
@@ -140,6 +141,17 @@ int64_t pseudo_psm_send_schedule_req(int veos_sock_fd)
 		goto malloc_error;
 	}
 
+	fast_ipc = pseudo_veos_fast_ipc(veos_sock_fd);
+	if (fast_ipc) {
+		retval = pseudo_veos_send_fast_cmd(veos_sock_fd, fast_ipc,
+				SCHEDULE, syscall(SYS_gettid), 0, NULL, 0);
+		if (0 > retval) {
+			PSEUDO_ERROR("Failed to send request to VEOS");
+			retval = -EFAULT;
+		}
+		goto malloc_error;
+	}
+
 	/* prepare request to be sent to PSM */
 	ve_schedule_req.pseudo_veos_cmd_id = SCHEDULE;
 
@@ -200,6 +212,7 @@ malloc_error:
 int64_t pseudo_psm_recv_schedule_ack(int veos_sock_fd)
 {
 	ssize_t retval = -1;
+	int64_t ack_ret = 0;
 	PseudoVeosMessage *ve_schedule_ack = NULL;
 	char buf[MAX_PROTO_MSG_SIZE] = {0};
 
@@ -218,6 +231,10 @@ int64_t pseudo_psm_recv_schedule_ack(int veos_sock_fd)
 		PSEUDO_ERROR("Failed to receive schedule acknowledgment "
 				"from VEOS");
 		retval = -EFAULT;
+	} else if (pseudo_veos_recv_fast_ack(buf, retval, &ack_ret,
+				NULL, 0)) {
+		PSEUDO_DEBUG("PSEUDO received SCHEDULE ACK");
+		retval = ack_ret;
 	} else {
 		/* Unpack the structure */
 		ve_schedule_ack = pseudo_veos_message__unpack(NULL, retval,
@@ -270,9 +287,19 @@ int64_t pseudo_psm_block_syscall_req(int veos_sock_fd)
 	PseudoVeosMessage ve_block_req = PSEUDO_VEOS_MESSAGE__INIT;
 	void *buf = NULL;
 	ssize_t pseudo_msg_len = -1, msg_len = -1;
+	int fast_ipc = 0;
 
 	PSEUDO_TRACE("Entering");
 
+	fast_ipc = pseudo_veos_fast_ipc(veos_sock_fd);
+	if (fast_ipc) {
+		retval = pseudo_veos_send_fast_cmd(veos_sock_fd, fast_ipc,
+				BLOCK, syscall(SYS_gettid), 0, NULL, 0);
+		if (0 > retval)
+			PSEUDO_ERROR("failed to communicate with veos");
+		goto malloc_error;
+	}
+
        /* prepare request to be sent to PSM */
 	ve_block_req.pseudo_veos_cmd_id = BLOCK;
 
@@ -333,6 +360,7 @@ malloc_error:
 int64_t pseudo_psm_recv_block_ack(int veos_sock_fd)
 {
 	ssize_t retval = -1;
+	int64_t ack_ret = 0;
 	char buf[MAX_PROTO_MSG_SIZE] = {0};
 	PseudoVeosMessage *pseudo_msg = NULL;
 
@@ -346,6 +374,11 @@ int64_t pseudo_psm_recv_block_ack(int veos_sock_fd)
 		goto hndl_return;
 	}
 
+	if (pseudo_veos_recv_fast_ack(buf, retval, &ack_ret, NULL, 0)) {
+		retval = ack_ret;
+		goto hndl_return;
+	}
+
 	pseudo_msg = pseudo_veos_message__unpack(NULL, retval,
 						 (const uint8_t *)(&buf));
 	if (NULL == pseudo_msg) {
@@ -395,9 +428,21 @@ int pseudo_psm_unblock_and_set_regval_req(int veos_sock_fd,
 	ssize_t pseudo_msg_len = -1, msg_len = -1;
 	ProtobufCBinaryData pseudo_info = {0};
 	PseudoVeosMessage un_blk_n_set_reg = PSEUDO_VEOS_MESSAGE__INIT;
+	int fast_ipc = 0;
 
 	PSEUDO_TRACE("Entering");
 
+	fast_ipc = pseudo_veos_fast_ipc(veos_sock_fd);
+	if (fast_ipc) {
+		retval = pseudo_veos_send_fast_cmd(veos_sock_fd, fast_ipc,
+				UNBLOCK_AND_SET_REGVAL, syscall(SYS_gettid),
+				syscall_ret, sys_info,
+				sizeof(struct ve_sys_info));
+		if (0 > retval)
+			PSEUDO_ERROR("failed to send request to veos");
+		goto malloc_error;
+	}
+
 	/* prepare request to be sent to PSM */
 	un_blk_n_set_reg.pseudo_veos_cmd_id = UNBLOCK_AND_SET_REGVAL;
 
@@ -463,6 +508,7 @@ malloc_error:
 int64_t pseudo_psm_recv_un_block_and_retval_ack(int veos_sock_fd)
 {
 	ssize_t retval = -1;
+	int64_t ack_ret = 0;
 	char buf[MAX_PROTO_MSG_SIZE] = {0};
 	PseudoVeosMessage *pseudo_msg = NULL;
 
@@ -475,6 +521,11 @@ int64_t pseudo_psm_recv_un_block_and_retval_ack(int veos_sock_fd)
 		goto hndl_return;
 	}
 
+	if (pseudo_veos_recv_fast_ack(buf, retval, &ack_ret, NULL, 0)) {
+		retval = ack_ret;
+		goto hndl_return;
+	}
+
 	pseudo_msg = pseudo_veos_message__unpack(NULL,
 			retval, (const uint8_t *)(&buf));
 	if (NULL == pseudo_msg) {
@@ -588,6 +639,7 @@ int ve_set_user_reg_req(int veos_sock_fd, int regid, uint64_t value,
 	ProtobufCBinaryData set_usr_reg_msg = {0};
 	PseudoVeosMessage set_usr_reg_req = PSEUDO_VEOS_MESSAGE__INIT;
 	struct reg_data rd = {0};
+	int fast_ipc = 0;
 
 	PSEUDO_TRACE("Entering");
 
@@ -595,6 +647,19 @@ int ve_set_user_reg_req(int veos_sock_fd, int regid, uint64_t value,
 	rd.regval = value;
 	rd.mask = mask;
 
+	fast_ipc = pseudo_veos_fast_ipc(veos_sock_fd);
+	if (fast_ipc) {
+		retval = pseudo_veos_send_fast_cmd(veos_sock_fd, fast_ipc,
+				SET_USR_REG, syscall(SYS_gettid), 0, &rd,
+				sizeof(struct reg_data));
+		if (0 > retval) {
+			PSEUDO_ERROR("Failed to send request to VEOS");
+			goto hndl_return;
+		}
+		retval = 0;
+		goto hndl_return;
+	}
+
 	/* prepare request to be sent to PSM */
 	set_usr_reg_req.pseudo_veos_cmd_id = SET_USR_REG;
 
@@ -670,6 +735,9 @@ int recv_ve_set_user_reg_ack(int veos_sock_fd)
 		goto hndl_return;
 	}
 
+	if (pseudo_veos_recv_fast_ack(buf, retval, &retval, NULL, 0))
+		goto hndl_return;
+
 	pseudo_msg = pseudo_veos_message__unpack(NULL,
 			retval, (const uint8_t *)(&buf));
 	if (NULL == pseudo_msg) {
@@ -3035,3 +3103,87 @@ hndl_return:
 	PSEUDO_TRACE("Exiting");
 	return retval;
 }
+
+/**
+ * @brief Negotiate fast path framing on a new VEOS connection.
+ *
+ *	Pseudo process offers the highest fast path version it supports
+ *	and VEOS replies with the version it agrees to use on this
+ *	connection. Hot commands are then sent with fixed-layout framing
+ *	instead of a packed PseudoVeosMessage.
+ *
+ * @param[in] veos_sock_fd Descriptor used to communicate with VEOS
+ *
+ * @return Agreed version on success, 0 if fast path is not used
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+int pseudo_veos_fast_ipc_negotiate(int veos_sock_fd)
+{
+	ssize_t retval = -1;
+	int version = 0;
+	uint32_t offer = VEOS_FAST_IPC_VERSION;
+	PseudoVeosMessage negotiate_req = PSEUDO_VEOS_MESSAGE__INIT;
+	PseudoVeosMessage *pseudo_msg = NULL;
+	ProtobufCBinaryData negotiate_msg = {0};
+	ssize_t pseudo_msg_len = -1, msg_len = -1;
+	char buf[MAX_PROTO_MSG_SIZE] = {0};
+
+	PSEUDO_TRACE("Entering");
+
+	negotiate_req.pseudo_veos_cmd_id = FAST_IPC_NEGOTIATE;
+
+	negotiate_req.has_pseudo_pid = true;
+	negotiate_req.pseudo_pid = syscall(SYS_gettid);
+
+	negotiate_msg.len = sizeof(offer);
+	negotiate_msg.data = (uint8_t *)&offer;
+
+	negotiate_req.has_pseudo_msg = true;
+	negotiate_req.pseudo_msg = negotiate_msg;
+
+	pseudo_msg_len = pseudo_veos_message__get_packed_size(&negotiate_req);
+	msg_len = pseudo_veos_message__pack(&negotiate_req,
+					(uint8_t *)buf);
+	if (pseudo_msg_len != msg_len) {
+		PSEUDO_ERROR("Internal message protocol buffer error");
+		PSEUDO_DEBUG("Expected length: %ld, Returned length: %ld",
+				pseudo_msg_len, msg_len);
+		fprintf(stderr, "Internal message protocol buffer error\n");
+		pseudo_abort();
+	}
+
+	retval = pseudo_veos_send_cmd(veos_sock_fd, buf, pseudo_msg_len);
+	if (retval < pseudo_msg_len) {
+		PSEUDO_ERROR("Failed to send request to veos");
+		PSEUDO_DEBUG("Expected bytes: %ld, transferred bytes: %ld",
+				pseudo_msg_len, retval);
+		goto hndl_return;
+	}
+
+	retval = pseudo_veos_recv_cmd(veos_sock_fd,
+			(void *)&buf, MAX_PROTO_MSG_SIZE);
+	if (-1 == retval) {
+		PSEUDO_ERROR("Failed to receive acknowledgement from veos");
+		goto hndl_return;
+	}
+
+	pseudo_msg = pseudo_veos_message__unpack(NULL,
+			retval, (const uint8_t *)(&buf));
+	if (NULL == pseudo_msg) {
+		PSEUDO_ERROR("Internal message protocol buffer error");
+		fprintf(stderr, "Internal message protocol buffer error\n");
+		pseudo_abort();
+	}
+
+	if (pseudo_msg->has_syscall_retval && pseudo_msg->syscall_retval > 0)
+		version = pseudo_msg->syscall_retval;
+	PSEUDO_DEBUG("Fast path version %d on socket %d", version,
+			veos_sock_fd);
+
+	pseudo_veos_message__free_unpacked(pseudo_msg, NULL);
+hndl_return:
+	PSEUDO_TRACE("Exiting");
+	return version;
+}
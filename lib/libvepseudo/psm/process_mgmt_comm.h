@@ -88,4 +88,5 @@ int init_lhm_shm_area(veos_handle *);
 int pseudo_psm_send_setuidgid_req(int, uint64_t, bool);
 int pseudo_psm_recv_setuidgid_ack(int);
 int ve_set_user_reg(veos_handle *, int, uint64_t, int64_t);
+int pseudo_veos_fast_ipc_negotiate(int);
 #endif
@@ -317,11 +317,22 @@ int pseudo_psm_send_get_regval_req(int veos_sock_fd)
 	int retval = -1;
 	void *buf = NULL;
 	ssize_t pseudo_msg_len = 0, msg_len = 0;
+	int fast_ipc = 0;
 
 	PseudoVeosMessage regval_req = PSEUDO_VEOS_MESSAGE__INIT;
 
 	PSEUDO_TRACE("Entering");
 
+	fast_ipc = pseudo_veos_fast_ipc(veos_sock_fd);
+	if (fast_ipc) {
+		retval = pseudo_veos_send_fast_cmd(veos_sock_fd, fast_ipc,
+				GET_REGVAL_REQ, syscall(SYS_gettid), 0, NULL, 0);
+		if (0 > retval)
+			PSEUDO_ERROR("Failed to send message to VEOS");
+		PSEUDO_TRACE("Exiting");
+		return retval;
+	}
+
 	regval_req.pseudo_veos_cmd_id = GET_REGVAL_REQ;
 
 	regval_req.has_pseudo_pid = true;
@@ -371,6 +382,7 @@ int pseudo_psm_send_get_regval_req(int veos_sock_fd)
 int pseudo_psm_recv_get_regval_ack(int veos_sock_fd, uint64_t *ice)
 {
 	ret_t retval = -1;
+	int64_t ack_ret = 0;
 	char buf[MAX_PROTO_MSG_SIZE] = {0};
 	PseudoVeosMessage *pseudo_msg = NULL;
 
@@ -383,6 +395,12 @@ int pseudo_psm_recv_get_regval_ack(int veos_sock_fd, uint64_t *ice)
 		goto hndl_return;
 	}
 
+	if (pseudo_veos_recv_fast_ack(buf, retval, &ack_ret, ice,
+				sizeof(uint64_t))) {
+		retval = ack_ret;
+		goto hndl_return;
+	}
+
 	pseudo_msg = pseudo_veos_message__unpack(NULL,
 					 retval, (const uint8_t *)(&buf));
 	if (NULL == pseudo_msg) {
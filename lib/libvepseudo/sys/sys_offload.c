@@ -1638,12 +1638,99 @@ ret_t ve_write(int syscall_num, char *syscall_name, veos_handle *handle)
 		return ve_hndl_write_pwrite64(syscall_num, syscall_name, handle);
 }
 
+/**
+ * @brief Stage the buffers of readv()/writev() family in one VH arena.
+ *
+ *	The VE buffer addresses in vh_iov[] are saved in ve_addr[] and every
+ *	iov_base is replaced by a slice of one contiguous VH buffer, so that
+ *	a call pays one allocation whatever its number of iovecs is. Slices
+ *	are aligned to ALIGN_BUFF_SIZE for DMA, or to ALIGN_SZ for O_DIRECT.
+ *	Under O_DIRECT a VE buffer which is not aligned to ALIGN_SZ fails
+ *	with EINVAL. The total length is truncated to MAX_RW_COUNT as VH OS
+ *	does.
+ *
+ *	VE buffers are not probed one by one here. VEOS translates every
+ *	segment of the DMA_REQ_VEC request under the mm lock, so an invalid
+ *	VE buffer fails the scatter list transfer with EFAULT. For readv()
+ *	this happens after VH OS has read the data, as a fault while copying
+ *	to user memory does on Linux.
+ *
+ * @param[in] handle VEOS handle.
+ * @param[in] fd File descriptor of the system call.
+ * @param[in,out] vh_iov iovec array received from VE.
+ * @param[out] ve_addr VE buffer address of each iovec.
+ * @param[in] iovcnt Number of iovecs.
+ * @param[out] arena Staging buffer, to be freed by the caller.
+ *
+ * @return 0 on success, negative of errno on failure.
+ */
+int ve_hndl_iov_stage(veos_handle *handle, int fd, struct iovec *vh_iov,
+		uint64_t *ve_addr, int iovcnt, void **arena)
+{
+	int i = 0;
+	int dio_flag = -1;
+	size_t align = ALIGN_BUFF_SIZE;
+	size_t total = 0, arena_sz = 0;
+	char *buf = NULL;
+
+	*arena = NULL;
+	dio_flag = fcntl(fd, F_GETFL, 0);
+	if ((dio_flag > 0) && (dio_flag & O_DIRECT))
+		dio_flag = 1;
+	else
+		dio_flag = 0;
+	if (dio_flag)
+		align = ALIGN_SZ;
+
+	/* Compute the size of arena */
+	for (i = 0; i < iovcnt; i++) {
+		ve_addr[i] = (uint64_t)vh_iov[i].iov_base;
+		vh_iov[i].iov_base = NULL;
+		if (!ve_addr[i] || !vh_iov[i].iov_len)
+			continue;
+		/* O_DIRECT needs aligned VE buffers as VH OS does */
+		if (dio_flag && !IS_ALIGNED(ve_addr[i], ALIGN_SZ)) {
+			PSEUDO_DEBUG("VE buffer %d (0x%lx) is not aligned for"
+					" O_DIRECT", i, ve_addr[i]);
+			return -EINVAL;
+		}
+		if (vh_iov[i].iov_len > MAX_RW_COUNT - total)
+			vh_iov[i].iov_len = MAX_RW_COUNT - total;
+		total += vh_iov[i].iov_len;
+		arena_sz = ALIGN(arena_sz, align) + vh_iov[i].iov_len;
+	}
+	if (!arena_sz)
+		return 0;
+
+	if (posix_memalign((void **)&buf, align, arena_sz)) {
+		PSEUDO_ERROR("Failed to create internal memory buffer");
+		PSEUDO_DEBUG("arena of %lu bytes : posix_memalign failed",
+				arena_sz);
+		return -ENOMEM;
+	}
+
+	/* Slice the arena into VH buffers */
+	arena_sz = 0;
+	for (i = 0; i < iovcnt; i++) {
+		if (!ve_addr[i] || !vh_iov[i].iov_len)
+			continue;
+		arena_sz = ALIGN(arena_sz, align);
+		vh_iov[i].iov_base = buf + arena_sz;
+		arena_sz += vh_iov[i].iov_len;
+	}
+	PSEUDO_DEBUG("%d VE buffers staged in %lu bytes", iovcnt, arena_sz);
+
+	*arena = buf;
+	return 0;
+}
+
 /**
  * @brief Generic Handler for writev() and pwritev() system calls for VE.
  *
  *	This function receives the data and arguments from VEMVA/VEHVA and
  *	offloads the functionality to VH OS writev()/pwritev() system call.
- *	It copies the data to VEMVA using VE driver interface.
+ *	All VE buffers are received into one VH arena with a single scatter
+ *	list using VE driver interface.
  *
  *	Following system calls use this generic handler:
  *	ve_writev(),
@@ -1661,11 +1748,12 @@ ret_t ve_hndl_writev_pwritev(int syscall_num, char *syscall_name,
 	ret_t retval = -1;
 	struct iovec *vh_iov = NULL;
 	int iovcnt = 0;
-	int i = 0;
+	int i = 0, nseg = 0;
 	uint64_t args[4] = {0};
-	uint64_t **vh_buff_addr = NULL;
+	uint64_t *ve_buff_addr = NULL;
+	void *vh_arena = NULL;
+	struct dma_vec_seg *seg = NULL;
 	sigset_t signal_mask = { {0} };
-	int dio_flag = -1;
 
 	PSEUDO_TRACE("Entering");
 	/* get arguments */
@@ -1738,74 +1826,36 @@ ret_t ve_hndl_writev_pwritev(int syscall_num, char *syscall_name,
 			goto hndl_return1;
 	}
 
-	/* create VH buffers */
-	vh_buff_addr = calloc(iovcnt, (sizeof(uint64_t)));
-	if (NULL == vh_buff_addr) {
+	/* create buffers to store VE buffer addresses and scatter list */
+	ve_buff_addr = calloc(iovcnt, sizeof(uint64_t));
+	seg = calloc(iovcnt, sizeof(struct dma_vec_seg));
+	if ((NULL == ve_buff_addr) || (NULL == seg)) {
 		retval = -ENOSPC;
 		PSEUDO_ERROR("Failed to create internal memory buffer");
-		PSEUDO_DEBUG("vh_buff_addr : calloc %s failed %s",
+		PSEUDO_DEBUG("ve_buff_addr : calloc %s failed %s",
 			SYSCALL_NAME, strerror(errno));
-		goto hndl_return1;
+		goto hndl_return2;
 	}
 
-	dio_flag = fcntl(args[0],F_GETFL,0);
-	if ((dio_flag > 0) && (dio_flag & O_DIRECT))
-		dio_flag = 1;
-	else
-		dio_flag = 0;
 	/* Create VH environment for writev() */
-	for (i = 0; i < iovcnt; i++) {
-		PSEUDO_DEBUG("VE data: buff: %d length :%lu data:%lu",
-				i, (unsigned long)(vh_iov[i].iov_len),
-				(unsigned long)vh_iov[i].iov_base);
+	retval = ve_hndl_iov_stage(handle, args[0], vh_iov, ve_buff_addr,
+			iovcnt, &vh_arena);
+	if (0 > retval)
+		goto hndl_return2;
 
-		if ((NULL != (void *)vh_iov[i].iov_base) &&
-				(0 != (ssize_t)vh_iov[i].iov_len)) {
-			if(0 == ve_is_valid_address(handle, (uint64_t)vh_iov[i].iov_base))
-			{
-				if (dio_flag) {
-					if (!IS_ALIGNED((uint64_t)vh_iov[i].iov_base, ALIGN_SZ))
-					{
-						retval = -EINVAL;
-						goto hndl_return2;
-					}
-					if(posix_memalign((void *)&vh_buff_addr[i], ALIGN_SZ, vh_iov[i].iov_len))
-					{
-						retval = -ENOMEM;
-						goto hndl_return2;
-					}
-				} else {
-					vh_buff_addr[i] = (uint64_t *)malloc((vh_iov[i].iov_len)*sizeof(char));
-				}
-				if (NULL != (void *)vh_buff_addr[i]) {
-					memset(vh_buff_addr[i],0x00,vh_iov[i].iov_len);
-					if (0 > ve_recv_data(handle,
-								(uint64_t)(vh_iov[i].iov_base),
-								(vh_iov[i].iov_len*sizeof(char)),
-								(uint64_t *)(vh_buff_addr[i]))) {
-						PSEUDO_DEBUG("Failed to receive"
-								" args[%d] from ve", i);
-						PSEUDO_ERROR("Failed(%s) to"
-								" receive %s arguments from"
-								" ve", strerror(errno),
-								SYSCALL_NAME);
-						retval = -EFAULT;
-						goto hndl_return2;
-					}
-				} else {
-					retval = -ENOSPC;
-					PSEUDO_ERROR("calloc fail for buffer %d",
-							i+1);
-					goto hndl_return2;
-				}
-			}
-			else
-			{
-				retval = -EFAULT;
-				goto hndl_return2;
-			}
-		}
-		vh_iov[i].iov_base = (void *)vh_buff_addr[i];
+	for (i = 0; i < iovcnt; i++) {
+		if (NULL == vh_iov[i].iov_base)
+			continue;
+		seg[nseg].srcaddr = ve_buff_addr[i];
+		seg[nseg].dstaddr = (uint64_t)vh_iov[i].iov_base;
+		seg[nseg].size = vh_iov[i].iov_len;
+		nseg++;
+	}
+	if (0 > ve_recv_data_vec(handle, seg, nseg)) {
+		PSEUDO_ERROR("Failed(%s) to receive %s arguments from ve",
+				strerror(errno), SYSCALL_NAME);
+		retval = -EFAULT;
+		goto hndl_return2;
 	}
 
 	/* unblock all signals except the one actualy blocked by VE process */
@@ -1837,11 +1887,9 @@ ret_t ve_hndl_writev_pwritev(int syscall_num, char *syscall_name,
 
 	/* cleaning local storage */
 hndl_return2:
-	for (i = 0; i < iovcnt; i++) {
-		if (NULL != (void *)vh_buff_addr[i])
-			free(vh_buff_addr[i]);
-	}
-	free(vh_buff_addr);
+	free(vh_arena);
+	free(seg);
+	free(ve_buff_addr);
 hndl_return1:
 	free(vh_iov);
 hndl_return:
@@ -1855,8 +1903,9 @@ hndl_return:
  *
  *	This function receives the data and arguments from VEMVA/VEHVA and
  *	offloads the functionality to VH OS readv()/preadv() system call. This
- *	function after receiving the data from VH OS call copies the data to
- *	VEMVA using VE driver interface.
+ *	function after receiving the data from VH OS call copies the data
+ *	from one VH arena to all VE buffers with a single scatter list using
+ *	VE driver interface.
  *
  *	Following system calls use this generic handler:
  *	ve_readv(),
@@ -1873,14 +1922,13 @@ ret_t ve_hndl_readv_preadv(int syscall_num, char *syscall_name,
 {
 	ssize_t retval = -1;
 	struct iovec *vh_iov = NULL;
-	int iovcnt = 0, i = 0;
-	int err_flag = -1;
-	int cnt = 0;
+	int iovcnt = 0, i = 0, nseg = 0;
 	uint64_t args[4] = {0};
 	uint64_t *ve_buff_addr = NULL;
+	void *vh_arena = NULL;
+	struct dma_vec_seg *seg = NULL;
 	sigset_t signal_mask = { {0} };
-	size_t send_bytes = -1;
-	int dio_flag = -1;
+	size_t send_bytes = 0, len = 0;
 
 	PSEUDO_TRACE("Entering");
 	/* get arguments */
@@ -1947,66 +1995,22 @@ ret_t ve_hndl_readv_preadv(int syscall_num, char *syscall_name,
 			goto hndl_return1;
 	}
 
-	/* create buffer to store VE buffer addresses */
+	/* create buffers to store VE buffer addresses and scatter list */
 	ve_buff_addr = calloc(iovcnt, sizeof(uint64_t));
-	if (NULL == ve_buff_addr) {
+	seg = calloc(iovcnt, sizeof(struct dma_vec_seg));
+	if ((NULL == ve_buff_addr) || (NULL == seg)) {
 		retval = -EIO;
 		PSEUDO_ERROR("Failed to create internal memory buffer");
 		PSEUDO_DEBUG("ve_buff_addr : calloc %s failed %s",
 				SYSCALL_NAME, strerror(errno));
-		goto hndl_return1;
+		goto hndl_return2;
 	}
 
-	dio_flag = fcntl(args[0], F_GETFL, 0);
-	if ((dio_flag > 0) && (dio_flag & O_DIRECT))
-		dio_flag = 1;
-	else
-		dio_flag = 0;
-
 	/* Allocate memory for VH buffers */
-	for (i = 0; i < iovcnt; i++) {
-		ve_buff_addr[i] = (uint64_t)vh_iov[i].iov_base;
-		vh_iov[i].iov_base = NULL;
-		if(0 == ve_is_valid_address(handle, (uint64_t)ve_buff_addr[i]))
-		{
-			if (dio_flag) {
-				if (!IS_ALIGNED((uint64_t)vh_iov[i].iov_base, ALIGN_SZ))
-				{
-					retval = -EINVAL;
-					goto hndl_return2;
-				}
-				if(posix_memalign((void *)&vh_iov[i].iov_base, ALIGN_SZ, vh_iov[i].iov_len))
-				{
-					retval = -ENOMEM;
-					goto hndl_return2;
-				}
-			} else {
-				vh_iov[i].iov_base = (void *)malloc
-					((vh_iov[i].iov_len)*sizeof(char));
-			}
-			if (NULL == (void *) vh_iov[i].iov_base) {
-				retval = -EIO;
-				PSEUDO_ERROR("Failed to create internal memory"
-						" buffer");
-				PSEUDO_DEBUG("Error(%s) for calloc in "
-						"buffer %d", strerror(errno), i);
-				err_flag = 1;
-				goto hndl_return2;
-			}
-			memset(vh_iov[i].iov_base,0x00,vh_iov[i].iov_len);
-		}
-		else if (!(void*)ve_buff_addr[i])
-		{
-			/* skip and got to next iovec */
-			continue;
-		}
-		else
-		{
-			retval = -EFAULT;
-			goto hndl_return2;
-		}
-		cnt++;
-	}
+	retval = ve_hndl_iov_stage(handle, args[0], vh_iov, ve_buff_addr,
+			iovcnt, &vh_arena);
+	if (0 > retval)
+		goto hndl_return2;
 
 	/* unblock all signals except the one actualy blocked by VE process */
 	PSEUDO_DEBUG("Pre-processing finished, unblock signals");
@@ -2019,7 +2023,6 @@ ret_t ve_hndl_readv_preadv(int syscall_num, char *syscall_name,
 	pthread_sigmask(SIG_BLOCK, &signal_mask, NULL);
 	if (-1 == retval) {
 		retval = -errno;
-		err_flag = 1;
 		PSEUDO_ERROR("syscall %s failed %s",
 			SYSCALL_NAME, strerror(errno));
 		PSEUDO_DEBUG("Blocked signals for post-processing");
@@ -2038,50 +2041,31 @@ ret_t ve_hndl_readv_preadv(int syscall_num, char *syscall_name,
 	}
 	PSEUDO_DEBUG("Blocked signals for post-processing");
 
-hndl_return2:
+	/* Send the data read to VE buffers with one scatter list */
 	send_bytes = (size_t)retval;
-	for (i = 0; i < cnt; i++) {
-		if(!send_bytes)
-			break;
-		if (NULL != (void *)vh_iov[i].iov_base) {
-			if (err_flag != 1) {
-				if (send_bytes >= vh_iov[i].iov_len) {
-					send_bytes = send_bytes - vh_iov[i].iov_len;
-				} else {
-					vh_iov[i].iov_len = send_bytes;
-					send_bytes = 0;
-				}
-				if (ve_buff_addr[i] && vh_iov[i].iov_len) {
-					if (0 > ve_send_data(handle,
-						(uint64_t)(ve_buff_addr[i]),
-						(vh_iov[i].iov_len),
-						(uint64_t *)vh_iov[i].iov_base)) {
-						PSEUDO_ERROR("Failed to send"
-							" data to VE memory");
-						PSEUDO_DEBUG("%s Failed(%s) to"
-							" send data:"
-							" %d", SYSCALL_NAME,
-							strerror(errno), i);
-						retval = -EFAULT;
-						err_flag = 1;
-					} else {
-						PSEUDO_DEBUG("buffer %d send"
-							" to ve", i);
-					}
-				} else {
-					PSEUDO_DEBUG("vh_iov[%d].iov_len = %zu",
-							i, vh_iov[i].iov_len);
-				}
-
-			}
-		}
+	for (i = 0; (i < iovcnt) && send_bytes; i++) {
+		len = (send_bytes < vh_iov[i].iov_len) ?
+			send_bytes : vh_iov[i].iov_len;
+		send_bytes -= len;
+		if ((NULL == vh_iov[i].iov_base) || !len)
+			continue;
+		seg[nseg].srcaddr = (uint64_t)vh_iov[i].iov_base;
+		seg[nseg].dstaddr = ve_buff_addr[i];
+		seg[nseg].size = len;
+		nseg++;
 	}
+	if (0 > ve_send_data_vec(handle, seg, nseg)) {
+		PSEUDO_ERROR("Failed to send data to VE memory");
+		PSEUDO_DEBUG("%s Failed(%s) to send %d buffers",
+				SYSCALL_NAME, strerror(errno), nseg);
+		retval = -EFAULT;
+	}
+
+hndl_return2:
+	free(vh_arena);
+	free(seg);
 	free(ve_buff_addr);
 hndl_return1:
-	for (i = 0; i < cnt; i++) {
-		if (vh_iov[i].iov_base != NULL)
-			free(vh_iov[i].iov_base);
-	}
 	free(vh_iov);
 hndl_return:
 	/* write return value */
@@ -29,6 +29,8 @@ ret_t ve_hndl_readv_preadv(int, char *, veos_handle *);
 ret_t ve_hndl_read_pread64(int, char *, veos_handle *);
 ret_t ve_hndl_writev_pwritev(int, char *, veos_handle *);
 ret_t ve_hndl_write_pwrite64(int, char *, veos_handle *);
+int ve_hndl_iov_stage(veos_handle *, int, struct iovec *, uint64_t *, int,
+		void **);
 ret_t ve_setuid(int, char *, veos_handle *);
 ret_t ve_setgid(int , char *, veos_handle *);
 ret_t ve_hndl_sethostname_setdomainname(int, char *, veos_handle *);
@@ -27,6 +27,7 @@
 #ifndef __INTERNAL_H
 #define __INTERNAL_H
 
+#include <stdint.h>
 #include <signal.h>
 #include <sys/ptrace.h>
 
@@ -40,6 +41,10 @@ static inline int signal_is_valid(unsigned long sig)
 #define PTRACE_O_EXITKILL       0x00100000
 #endif
 
+/* Round address down/up to the 8 byte word VE DMA operates on */
+#define VE_PTRACE_WORD_DOWN(x)	((x) & ~(uint64_t)(sizeof(uint64_t) - 1))
+#define VE_PTRACE_WORD_UP(x)	VE_PTRACE_WORD_DOWN((x) + sizeof(uint64_t) - 1)
+
 long __ve_ptrace(enum __ptrace_request, pid_t, void *, void *);
 int ve_ptrace_resume(enum __ptrace_request, pid_t, void *);
 #endif
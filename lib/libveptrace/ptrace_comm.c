@@ -36,6 +36,7 @@
 #include <sys/mman.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "ptrace_comm.h"
 #include "ve_ptrace.h"
 #include "ptrace_log.h"
@@ -44,6 +45,22 @@
 
 int *ve_node_num = NULL;
 
+/**
+ * @brief Connections to VEOS kept open for reuse, one per traced pid.
+ *
+ * An entry is handed out to one request at a time; a concurrent request
+ * for the same pid gets a connection of its own which is closed once the
+ * request completes.
+ */
+static struct veos_sock_cache {
+	pid_t pid;	/*!< Tracee pid, 0 if the entry is free */
+	int fd;		/*!< Connected socket */
+	bool busy;	/*!< Entry in use by a request */
+} veos_sock_cache[VEOS_SOCK_CACHE_SIZE];
+static pid_t veos_sock_cache_owner;
+static int veos_sock_cache_next;
+static pthread_mutex_t veos_sock_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * @brief It will create socket for communication with VEOS.
  *
@@ -69,8 +86,9 @@ int veos_sock(int node)
 	/* ignore SIGPIPE */
 	signal(SIGPIPE, SIG_IGN);
 
-	/* Create a socket */
-	sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+	/* Create a socket, cached connections must not leak into
+	 * programs executed by the tracer */
+	sockfd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
 	if (sockfd < 0) {
 		VE_PTRACE_DEBUG("Failed to create socket: %s",
 				strerror(errno));
@@ -98,6 +116,10 @@ hndl_return:
 /**
  * @brief Function will return the socket file descriptor of VEOS.
  *
+ * A connection cached for the pid is reused when it is not in use by
+ * another request, otherwise a new connection is made and cached when
+ * possible. The descriptor must be released with put_veos_sock_fd().
+ *
  * @param[in] pid PID of the tracee
  *
  * @return socket file descriptor on success and -1 in case of failure.
@@ -106,9 +128,33 @@ int get_veos_sock_fd(pid_t pid)
 {
 	int node = -1;
 	int veos_sock_fd = -1;
+	int idx = 0, slot = -1;
 
 	VE_PTRACE_TRACE("Entering");
 
+	pthread_mutex_lock(&veos_sock_cache_lock);
+	/* Connections inherited over fork() are shared with the parent */
+	if (veos_sock_cache_owner != getpid()) {
+		for (idx = 0; idx < VEOS_SOCK_CACHE_SIZE; idx++) {
+			if (veos_sock_cache[idx].pid)
+				close(veos_sock_cache[idx].fd);
+			veos_sock_cache[idx].pid = 0;
+			veos_sock_cache[idx].busy = false;
+		}
+		veos_sock_cache_owner = getpid();
+	}
+	for (idx = 0; idx < VEOS_SOCK_CACHE_SIZE; idx++) {
+		if ((veos_sock_cache[idx].pid == pid) &&
+				!veos_sock_cache[idx].busy) {
+			veos_sock_cache[idx].busy = true;
+			veos_sock_fd = veos_sock_cache[idx].fd;
+			pthread_mutex_unlock(&veos_sock_cache_lock);
+			VE_PTRACE_DEBUG("Cached socket fd: %d", veos_sock_fd);
+			goto out;
+		}
+	}
+	pthread_mutex_unlock(&veos_sock_cache_lock);
+
 	/* When this function is called first time, then we
 	 * need to find the node number on which the given
 	 * pid exists.
@@ -140,12 +186,81 @@ int get_veos_sock_fd(pid_t pid)
 		goto out;
 	}
 
+	/* Cache the connection in a free entry, else replace an idle one */
+	pthread_mutex_lock(&veos_sock_cache_lock);
+	for (idx = 0; idx < VEOS_SOCK_CACHE_SIZE; idx++) {
+		if (!veos_sock_cache[idx].pid) {
+			slot = idx;
+			break;
+		}
+	}
+	for (idx = 0; (-1 == slot) && (idx < VEOS_SOCK_CACHE_SIZE); idx++) {
+		veos_sock_cache_next = (veos_sock_cache_next + 1) %
+			VEOS_SOCK_CACHE_SIZE;
+		if (!veos_sock_cache[veos_sock_cache_next].busy) {
+			slot = veos_sock_cache_next;
+			close(veos_sock_cache[slot].fd);
+		}
+	}
+	if (-1 != slot) {
+		veos_sock_cache[slot].pid = pid;
+		veos_sock_cache[slot].fd = veos_sock_fd;
+		veos_sock_cache[slot].busy = true;
+	}
+	pthread_mutex_unlock(&veos_sock_cache_lock);
+
 	VE_PTRACE_DEBUG("Socket fd obtained: %d", veos_sock_fd);
 out:
 	VE_PTRACE_TRACE("Exiting");
 	return veos_sock_fd;
 }
 
+/**
+ * @brief Release a socket file descriptor obtained by get_veos_sock_fd().
+ *
+ * The connection is kept for the next request of the pid unless the
+ * request failed in a way that leaves the connection unusable or the
+ * tracee no longer exists.
+ *
+ * @param[in] pid PID of the tracee
+ * @param[in] veos_sock_fd Socket file descriptor to release
+ * @param[in] retval Result of the request made on the connection
+ */
+void put_veos_sock_fd(pid_t pid, int veos_sock_fd, int retval)
+{
+	bool drop = false;
+	int idx = 0;
+
+	VE_PTRACE_TRACE("Entering");
+
+	if (veos_sock_fd < 0)
+		goto hndl_return;
+
+	drop = ((-EFAULT == retval) || (-ECONNRESET == retval) ||
+			(-EPIPE == retval) || (-ESRCH == retval));
+
+	pthread_mutex_lock(&veos_sock_cache_lock);
+	for (idx = 0; idx < VEOS_SOCK_CACHE_SIZE; idx++) {
+		if ((veos_sock_cache[idx].pid == pid) &&
+				(veos_sock_cache[idx].fd == veos_sock_fd) &&
+				veos_sock_cache[idx].busy) {
+			veos_sock_cache[idx].busy = false;
+			if (drop)
+				veos_sock_cache[idx].pid = 0;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&veos_sock_cache_lock);
+
+	/* Connection which is not cached is closed */
+	if (drop || (VEOS_SOCK_CACHE_SIZE == idx)) {
+		VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
+		close(veos_sock_fd);
+	}
+hndl_return:
+	VE_PTRACE_TRACE("Exiting");
+}
+
 /**
  * @brief It will communicates with VEOS ans check whether the pid
  * exists or not.
@@ -424,6 +539,12 @@ int recv_and_unpack_cmd(int veos_soc_fd, ptrace_req *pt_req)
 		retval = -errno;
 		goto hndl_return;
 	}
+	/* VEOS closed a cached connection */
+	if (0 == read_len) {
+		VE_PTRACE_DEBUG("VEOS closed the connection");
+		retval = -ECONNRESET;
+		goto hndl_return;
+	}
 
 	/* Unpack the read buffer */
 	ptrace_cmd = pseudo_veos_message__unpack(NULL, read_len,
@@ -456,6 +577,46 @@ hndl_return:
 	return retval;
 }
 
+/**
+ * @brief Send a ptrace request to VEOS on a connection obtained by
+ * get_veos_sock_fd().
+ *
+ * A cached connection is stale when VEOS has closed it, and sending on it
+ * fails. In that case the connection is closed and dropped from the cache,
+ * a new connection is made and the request is sent once more. A request
+ * which could not be sent has not reached VEOS, so it is never handled
+ * twice.
+ *
+ * @param[in] pid PID of the tracee
+ * @param[in,out] veos_sock_fd Socket file descriptor, replaced by the new
+ * connection when reconnected and -1 when reconnecting fails
+ * @param[in] pt_req Ptrace request structure
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int send_cmd_to_veos(pid_t pid, int *veos_sock_fd, ptrace_req pt_req)
+{
+	int retval = -1;
+
+	VE_PTRACE_TRACE("Entering");
+
+	retval = pack_and_send_cmd(*veos_sock_fd, pt_req);
+	if (-1 != retval)
+		goto hndl_return;
+
+	VE_PTRACE_DEBUG("Reconnecting stale socket fd: %d", *veos_sock_fd);
+	put_veos_sock_fd(pid, *veos_sock_fd, -EPIPE);
+	*veos_sock_fd = get_veos_sock_fd(pid);
+	if (*veos_sock_fd < 0) {
+		VE_PTRACE_DEBUG("Failed to reconnect with VEOS");
+		goto hndl_return;
+	}
+	retval = pack_and_send_cmd(*veos_sock_fd, pt_req);
+hndl_return:
+	VE_PTRACE_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Function is used to communicate with VEOS and start the VE process
  * for the given pid.
@@ -486,7 +647,7 @@ int ve_start_process(pid_t pid)
 	}
 
 	/* Command send to VEOS for starting VE process */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(START_PROCESS) Communication Fails");
 		retval = -EFAULT;
@@ -504,8 +665,7 @@ int ve_start_process(pid_t pid)
 	VE_PTRACE_DEBUG("VEOS(START_PROCESS) Success for PID: %d", pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -542,7 +702,7 @@ int ve_stop_process(pid_t pid, bool seized_stop)
 	}
 
 	/* Command send to VEOS for stopping VE process */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(STOP_PROCESS) Communication Fails");
 		retval = -EFAULT;
@@ -560,8 +720,7 @@ int ve_stop_process(pid_t pid, bool seized_stop)
 	VE_PTRACE_DEBUG("VEOS(STOP_PROCESS) Success for PID: %d", pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -596,7 +755,7 @@ int ve_ptrace_attach(pid_t pid)
 	}
 
 	/* Command send to VEOS for stopping VE process */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(ATTACH) Communication Fails");
 		retval = -EFAULT;
@@ -613,8 +772,7 @@ int ve_ptrace_attach(pid_t pid)
 	VE_PTRACE_DEBUG("VEOS(ATTACH) Success for PID: %d", pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -657,7 +815,7 @@ int ve_ptrace_peekdata(pid_t pid, void *addr, void *data)
 	}
 
 	/* Command send to VEOS for reading content at the given VEMVA */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(PEEKDATA) Communication Fails");
 		retval = -EFAULT;
@@ -679,8 +837,7 @@ int ve_ptrace_peekdata(pid_t pid, void *addr, void *data)
 			addr, pt_req.data, pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -720,7 +877,7 @@ int ve_ptrace_pokedata(pid_t pid, void *addr, void *data)
 	}
 
 	/* Command send to VEOS for writing content at the given VEMVA */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(POKEDATA) Communication Fails");
 		retval = -EFAULT;
@@ -738,8 +895,131 @@ int ve_ptrace_pokedata(pid_t pid, void *addr, void *data)
 			addr, data, pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
+hndl_return:
+	VE_PTRACE_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Function is used to communicate with VEOS to read a range of
+ * VE memory of the tracee into the tracer's buffer.
+ *
+ * VEOS transfers the whole range with a single DMA request. The range
+ * and the tracer buffer have to be 8 byte aligned.
+ *
+ * @param[in] pid PID of VE tracee process
+ * @param[in] addr Pointer to tracee virtual address
+ * @param[out] data Buffer to fill with content of VE memory
+ * @param[in] len Length of the range in bytes
+ *
+ * @return 0 on success, -errno on failure.
+ */
+int ve_ptrace_peekdata_range(pid_t pid, void *addr, void *data, size_t len)
+{
+	int retval = -1;
+	int veos_sock_fd = -1;
+	ptrace_req pt_req;
+
+	VE_PTRACE_TRACE("Entering");
+	VE_PTRACE_DEBUG("Requesting VEOS(PEEKDATA_RANGE) for PID: %d", pid);
+
+	memset(&pt_req, 0, sizeof(ptrace_req));
+	pt_req.ptrace_cmd = PEEKDATA_RANGE;
+	pt_req.pid = pid;
+	pt_req.addr = (uint64_t)addr;
+	pt_req.data = (uint64_t)data;
+	pt_req.len = len;
+
+	/* Unix domain socket used as IPC */
+	veos_sock_fd = get_veos_sock_fd(pid);
+	if (veos_sock_fd < 0) {
+		VE_PTRACE_DEBUG("Failed to create socket with VEOS");
+		retval = -errno;
+		goto hndl_return;
+	}
+
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
+	if (-1 == retval) {
+		VE_PTRACE_DEBUG("VEOS(PEEKDATA_RANGE) Communication Fails");
+		retval = -EFAULT;
+		goto hndl_return1;
+	}
+
+	/* Get the response from VEOS */
+	retval = recv_and_unpack_cmd(veos_sock_fd, NULL);
+	if (0 > retval) {
+		VE_PTRACE_DEBUG("VEOS(PEEKDATA_RANGE) fails for PID: %d", pid);
+		goto hndl_return1;
+	}
+
+	VE_PTRACE_DEBUG("PEEKDATA_RANGE at Address: %p of %lu bytes for PID: %d",
+			addr, len, pid);
+	retval = 0;
+hndl_return1:
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
+hndl_return:
+	VE_PTRACE_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Function is used to communicate with VEOS to write the
+ * tracer's buffer to a range of VE memory of the tracee.
+ *
+ * VEOS transfers the whole range with a single DMA request. The range
+ * and the tracer buffer have to be 8 byte aligned.
+ *
+ * @param[in] pid PID of VE tracee process
+ * @param[in] addr Pointer to tracee virtual address
+ * @param[in] data Buffer holding content to store
+ * @param[in] len Length of the range in bytes
+ *
+ * @return 0 on success, -errno on failure.
+ */
+int ve_ptrace_pokedata_range(pid_t pid, void *addr, void *data, size_t len)
+{
+	int retval = -1;
+	int veos_sock_fd = -1;
+	ptrace_req pt_req;
+
+	VE_PTRACE_TRACE("Entering");
+	VE_PTRACE_DEBUG("Requesting VEOS(POKEDATA_RANGE) for PID: %d", pid);
+
+	memset(&pt_req, 0, sizeof(ptrace_req));
+	pt_req.ptrace_cmd = POKEDATA_RANGE;
+	pt_req.pid = pid;
+	pt_req.addr = (uint64_t)addr;
+	pt_req.data = (uint64_t)data;
+	pt_req.len = len;
+
+	/* Unix domain socket used as IPC */
+	veos_sock_fd = get_veos_sock_fd(pid);
+	if (veos_sock_fd < 0) {
+		VE_PTRACE_DEBUG("Failed to create socket with VEOS");
+		retval = -errno;
+		goto hndl_return;
+	}
+
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
+	if (-1 == retval) {
+		VE_PTRACE_DEBUG("VEOS(POKEDATA_RANGE) Communication Fails");
+		retval = -EFAULT;
+		goto hndl_return1;
+	}
+
+	/* Get the response from VEOS */
+	retval = recv_and_unpack_cmd(veos_sock_fd, NULL);
+	if (0 > retval) {
+		VE_PTRACE_DEBUG("VEOS(POKEDATA_RANGE) fails for PID: %d", pid);
+		goto hndl_return1;
+	}
+
+	VE_PTRACE_DEBUG("POKEDATA_RANGE at Address: %p of %lu bytes for PID: %d",
+			addr, len, pid);
+	retval = 0;
+hndl_return1:
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -783,7 +1063,7 @@ int ve_ptrace_peekuser(pid_t pid, void *addr, void *data)
 
 	/* Command send to VEOS for reading content at
 	 * the given VE user register */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(PEEKUSER) Communication Fails");
 		retval = -EFAULT;
@@ -805,8 +1085,7 @@ int ve_ptrace_peekuser(pid_t pid, void *addr, void *data)
 			addr, pt_req.data, pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -847,7 +1126,7 @@ int ve_ptrace_pokeuser(pid_t pid, void *addr, void *data)
 
 	/* Command send to VEOS for writing content at
 	 * the given VE user register */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(POKEUSER) Communication Fails");
 		retval = -EFAULT;
@@ -865,8 +1144,7 @@ int ve_ptrace_pokeuser(pid_t pid, void *addr, void *data)
 			addr, data, pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -904,7 +1182,7 @@ int ve_ptrace_getregs(pid_t pid, void *data)
 	}
 
 	/* Command send to VEOS to get the VE user register set */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(GETREGS) Communication Fails");
 		retval = -EFAULT;
@@ -922,8 +1200,7 @@ int ve_ptrace_getregs(pid_t pid, void *data)
 			pid, data);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -962,7 +1239,7 @@ int ve_ptrace_setregs(pid_t pid, void *data)
 
 	/* Command send to VEOS to set the given content
 	 * of VE user register set */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(SETREGS) Communication Fails");
 		retval = -EFAULT;
@@ -980,8 +1257,7 @@ int ve_ptrace_setregs(pid_t pid, void *data)
 			pid, data);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1019,7 +1295,7 @@ int ve_ptrace_getvregs(pid_t pid, void *data)
 	}
 
 	/* Command send to VEOS to get the VE vector register set */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(GETVREGS) Communication Fails");
 		retval = -EFAULT;
@@ -1037,8 +1313,7 @@ int ve_ptrace_getvregs(pid_t pid, void *data)
 			pid, data);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1077,7 +1352,7 @@ int ve_ptrace_setvregs(pid_t pid, void *data)
 
 	/* Command send to VEOS to set the given content
 	 * of VE vector register set */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(SETVREGS) Communication Fails");
 		retval = -EFAULT;
@@ -1095,8 +1370,7 @@ int ve_ptrace_setvregs(pid_t pid, void *data)
 			pid, data);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1313,7 +1587,7 @@ int ve_ptrace_detach(pid_t pid)
 	/* Command send to VEOS to detach the VE process from
 	 * tracing.
 	 */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(DETACH) Communication Fails");
 		retval = -EFAULT;
@@ -1330,8 +1604,7 @@ int ve_ptrace_detach(pid_t pid)
 	VE_PTRACE_DEBUG("VEOS(DETACH) Success for PID: %d", pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1370,7 +1643,7 @@ int ve_ptrace_seize(pid_t pid, void *data)
 	}
 
 	/* Command send to VEOS for attaching VE process using PTRACE_SEIZE */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(SEIZE) Communication Fails");
 		retval = -EFAULT;
@@ -1387,8 +1660,7 @@ int ve_ptrace_seize(pid_t pid, void *data)
 	VE_PTRACE_DEBUG("VEOS(SEIZE) Success for PID: %d", pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1426,7 +1698,7 @@ int ve_ptrace_syscall(pid_t pid, bool on)
 	}
 
 	/* Command send to VEOS to enable/disable syscall tracing */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(SYSCALL) Communication Fails");
 		retval = -EFAULT;
@@ -1445,8 +1717,7 @@ int ve_ptrace_syscall(pid_t pid, bool on)
 			(char *)((on)?"Enabled":"Disabled"), pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1484,7 +1755,7 @@ int ve_ptrace_singlestep(pid_t pid, bool on)
 	}
 
 	/* Command send to VEOS to enable/disable singlestep tracing */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(SINGLESTEP) Communication Fails");
 		retval = -EFAULT;
@@ -1503,8 +1774,7 @@ int ve_ptrace_singlestep(pid_t pid, bool on)
 			(char *)((on)?"Enabled":"Disabled"), pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1552,7 +1822,7 @@ int ve_ptrace_setoptions(pid_t pid, void *data)
 	}
 
 	/* Command send to VEOS to set ptrace options for VE process */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(SETOPTIONS) Communication Fails");
 		retval = -EFAULT;
@@ -1570,8 +1840,7 @@ int ve_ptrace_setoptions(pid_t pid, void *data)
 	VE_PTRACE_DEBUG("SETOPTIONS %lx for PID: %d", (uint64_t)data, pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -1620,7 +1889,7 @@ int ve_ptrace_geteventmsg(pid_t pid, void *data)
 	/* Command send to VEOS to get the ptrace event
 	 * message for VE process.
 	 */
-	retval = pack_and_send_cmd(veos_sock_fd, pt_req);
+	retval = send_cmd_to_veos(pid, &veos_sock_fd, pt_req);
 	if (-1 == retval) {
 		VE_PTRACE_DEBUG("VEOS(GETEVENTMSG) Communication Fails");
 		retval = -EFAULT;
@@ -1641,8 +1910,7 @@ int ve_ptrace_geteventmsg(pid_t pid, void *data)
 	VE_PTRACE_DEBUG("GETEVENTMSG: %ld for PID: %d", pt_req.data, pid);
 	retval = 0;
 hndl_return1:
-	VE_PTRACE_DEBUG("Closed Socket fd: %d", veos_sock_fd);
-	close(veos_sock_fd);
+	put_veos_sock_fd(pid, veos_sock_fd, retval);
 hndl_return:
 	VE_PTRACE_TRACE("Exiting");
 	return retval;
@@ -35,6 +35,9 @@
 #define MAX_PROTO_MSG_SIZE	4096
 #define PTRACE_REQUEST		1
 #define MIN(X, Y)		X < Y ? X:Y
+#define VEOS_SOCK_CACHE_SIZE	8
+/* Max length of a PEEKDATA_RANGE or POKEDATA_RANGE request */
+#define PTRACE_RANGE_MAX	(64 * 1024 * 1024)
 
 /**
  * @brief VE Ptrace requests
@@ -58,6 +61,8 @@ enum ptrace_req_cmd {
 	SETOPTIONS,		/*!< VE ptrace options */
 	GETEVENTMSG,		/*!< Get ptrace event that message */
 	CHECK_PID,		/*!< Check VE process exists or not */
+	PEEKDATA_RANGE,		/*!< Get content of a range of VE memory */
+	POKEDATA_RANGE,		/*!< Write content to a range of VE memory */
 	PTRACE_INVAL = -1	/*!< Invalid Request */
 };
 
@@ -69,10 +74,13 @@ typedef struct ptrace_request_struct {
 	pid_t pid;			/*!< PID of VE Tracee */
 	uint64_t addr;			/*!< Address to access */
 	uint64_t data;			/*!< Address to data */
+	uint64_t len;			/*!< Length of memory range */
 } ptrace_req;
 
 int veos_sock(int);
 int get_veos_sock_fd(pid_t);
+void put_veos_sock_fd(pid_t, int, int);
+int send_cmd_to_veos(pid_t, int *, ptrace_req);
 int check_ve_pid(int, pid_t);
 int find_ve_process_node_number(pid_t);
 ssize_t veos_write_buf(int, void *, ssize_t);
@@ -84,6 +92,8 @@ int ve_stop_process(pid_t, bool);
 int ve_ptrace_attach(pid_t);
 int ve_ptrace_peekdata(pid_t, void *, void *);
 int ve_ptrace_pokedata(pid_t, void *, void *);
+int ve_ptrace_peekdata_range(pid_t, void *, void *, size_t);
+int ve_ptrace_pokedata_range(pid_t, void *, void *, size_t);
 int ve_ptrace_peekuser(pid_t, void *, void *);
 int ve_ptrace_pokeuser(pid_t, void *, void *);
 int ve_ptrace_getregs(pid_t, void *);
@@ -31,6 +31,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <limits.h>
 #include "ve_ptrace.h"
 #include "ptrace_comm.h"
 #include "ptrace_log.h"
@@ -542,3 +543,221 @@ long ve_ptrace(enum __ptrace_request request, ...)
 
 	return retval;
 }
+
+/**
+ * @brief Read one chunk of VE memory of a traced VE process.
+ *
+ * The chunk is read with a single request to VEOS. An unaligned chunk is
+ * read through an aligned bounce buffer. The aligned span of the chunk
+ * must not exceed PTRACE_RANGE_MAX.
+ *
+ * @param[in] pid VE tracee process pid
+ * @param[in] addr Tracee virtual address to read from
+ * @param[out] buf Buffer to fill
+ * @param[in] len Number of bytes to read
+ *
+ * @return 0 on success, negative of errno on failure.
+ */
+static int ve_ptrace_read_chunk(pid_t pid, uint64_t addr, void *buf,
+		size_t len)
+{
+	int retval = -1;
+	uint64_t start = 0, end = 0;
+	void *bounce = NULL;
+
+	start = VE_PTRACE_WORD_DOWN(addr);
+	end = VE_PTRACE_WORD_UP(addr + len);
+
+	if ((start == addr) && (end == addr + len) &&
+			(VE_PTRACE_WORD_DOWN((uint64_t)buf) == (uint64_t)buf))
+		return ve_ptrace_peekdata_range(pid, (void *)addr, buf, len);
+
+	bounce = malloc(end - start);
+	if (NULL == bounce) {
+		VE_PTRACE_ERR("Internal Memory Allocation Failed");
+		return -ENOMEM;
+	}
+	retval = ve_ptrace_peekdata_range(pid, (void *)start, bounce,
+			end - start);
+	if (0 == retval)
+		memcpy(buf, bounce + (addr - start), len);
+	free(bounce);
+	return retval;
+}
+
+/**
+ * @brief Write one chunk of VE memory of a traced VE process.
+ *
+ * The chunk is written with a single request to VEOS. For an unaligned
+ * chunk the partial words at both ends are read first and merged. The
+ * aligned span of the chunk must not exceed PTRACE_RANGE_MAX.
+ *
+ * @param[in] pid VE tracee process pid
+ * @param[in] addr Tracee virtual address to write to
+ * @param[in] buf Buffer holding content to write
+ * @param[in] len Number of bytes to write
+ *
+ * @return 0 on success, negative of errno on failure.
+ */
+static int ve_ptrace_write_chunk(pid_t pid, uint64_t addr, const void *buf,
+		size_t len)
+{
+	int retval = -1;
+	uint64_t start = 0, end = 0;
+	void *bounce = NULL;
+
+	start = VE_PTRACE_WORD_DOWN(addr);
+	end = VE_PTRACE_WORD_UP(addr + len);
+
+	if ((start == addr) && (end == addr + len) &&
+			(VE_PTRACE_WORD_DOWN((uint64_t)buf) == (uint64_t)buf))
+		return ve_ptrace_pokedata_range(pid, (void *)addr,
+				(void *)buf, len);
+
+	bounce = malloc(end - start);
+	if (NULL == bounce) {
+		VE_PTRACE_ERR("Internal Memory Allocation Failed");
+		return -ENOMEM;
+	}
+
+	/* Preserve the bytes of partial words outside of the range */
+	retval = 0;
+	if (start != addr)
+		retval = ve_ptrace_peekdata_range(pid, (void *)start, bounce,
+				sizeof(uint64_t));
+	if ((0 == retval) && (end != addr + len))
+		retval = ve_ptrace_peekdata_range(pid,
+				(void *)(end - sizeof(uint64_t)),
+				bounce + (end - start - sizeof(uint64_t)),
+				sizeof(uint64_t));
+	if (0 == retval) {
+		memcpy(bounce + (addr - start), buf, len);
+		retval = ve_ptrace_pokedata_range(pid, (void *)start, bounce,
+				end - start);
+	}
+	free(bounce);
+	return retval;
+}
+
+/**
+ * @brief Get the length of the next chunk of a range transfer.
+ *
+ * Chunks after the first one start on a word boundary, so that the
+ * aligned span of every chunk fits in PTRACE_RANGE_MAX.
+ *
+ * @param[in] addr Tracee virtual address of the chunk
+ * @param[in] len Number of bytes left in the range
+ *
+ * @return Length of the chunk in bytes.
+ */
+static size_t ve_ptrace_chunk_len(uint64_t addr, size_t len)
+{
+	size_t max = PTRACE_RANGE_MAX - (addr - VE_PTRACE_WORD_DOWN(addr));
+
+	return (len < max) ? len : max;
+}
+
+/**
+ * @brief Read a range of VE memory of a traced VE process.
+ *
+ * Unlike PTRACE_PEEKDATA which transfers one word per request, the range
+ * is read with one request to VEOS per PTRACE_RANGE_MAX bytes. If a
+ * request fails after some bytes were read, the number of bytes read so
+ * far is returned.
+ *
+ * @param[in] pid VE tracee process pid
+ * @param[in] addr Tracee virtual address to read from
+ * @param[out] buf Buffer to fill
+ * @param[in] len Number of bytes to read
+ *
+ * @return Number of bytes read on success, on error -1 is returned and
+ * errno is set appropriately.
+ */
+ssize_t ve_ptrace_read_memory(pid_t pid, void *addr, void *buf, size_t len)
+{
+	ssize_t retval = -1;
+	int ret = 0;
+	size_t done = 0, chunk = 0;
+
+	VE_PTRACE_TRACE("Entering");
+
+	if (!buf || ((uint64_t)addr + len < (uint64_t)addr) ||
+			(len > SSIZE_MAX)) {
+		errno = EINVAL;
+		goto hndl_return;
+	}
+
+	while (done < len) {
+		chunk = ve_ptrace_chunk_len((uint64_t)addr + done, len - done);
+		ret = ve_ptrace_read_chunk(pid, (uint64_t)addr + done,
+				buf + done, chunk);
+		if (0 > ret) {
+			VE_PTRACE_ERR("Reading VE memory failed for PID: %d"
+					" at offset %lu", pid, done);
+			break;
+		}
+		done += chunk;
+	}
+	if (0 > ret && !done) {
+		errno = -ret;
+		goto hndl_return;
+	}
+
+	retval = done;
+hndl_return:
+	VE_PTRACE_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Write a range of VE memory of a traced VE process.
+ *
+ * Unlike PTRACE_POKEDATA which transfers one word per request, the range
+ * is written with one request to VEOS per PTRACE_RANGE_MAX bytes. If a
+ * request fails after some bytes were written, the number of bytes
+ * written so far is returned.
+ *
+ * @param[in] pid VE tracee process pid
+ * @param[in] addr Tracee virtual address to write to
+ * @param[in] buf Buffer holding content to write
+ * @param[in] len Number of bytes to write
+ *
+ * @return Number of bytes written on success, on error -1 is returned
+ * and errno is set appropriately.
+ */
+ssize_t ve_ptrace_write_memory(pid_t pid, void *addr, const void *buf,
+		size_t len)
+{
+	ssize_t retval = -1;
+	int ret = 0;
+	size_t done = 0, chunk = 0;
+
+	VE_PTRACE_TRACE("Entering");
+
+	if (!buf || ((uint64_t)addr + len < (uint64_t)addr) ||
+			(len > SSIZE_MAX)) {
+		errno = EINVAL;
+		goto hndl_return;
+	}
+
+	while (done < len) {
+		chunk = ve_ptrace_chunk_len((uint64_t)addr + done, len - done);
+		ret = ve_ptrace_write_chunk(pid, (uint64_t)addr + done,
+				buf + done, chunk);
+		if (0 > ret) {
+			VE_PTRACE_ERR("Writing VE memory failed for PID: %d"
+					" at offset %lu", pid, done);
+			break;
+		}
+		done += chunk;
+	}
+	if (0 > ret && !done) {
+		errno = -ret;
+		goto hndl_return;
+	}
+
+	retval = done;
+hndl_return:
+	VE_PTRACE_TRACE("Exiting");
+	return retval;
+}
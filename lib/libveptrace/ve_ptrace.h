@@ -28,6 +28,7 @@
 #define __VE_PTRACE_H
 
 #include <stdint.h>
+#include <sys/types.h>
 #include <sys/ptrace.h>
 
 typedef uint64_t reg_t;
@@ -105,4 +106,7 @@ struct ve_user_vregs {
 };
 
 long ve_ptrace(enum __ptrace_request request, ...);
+ssize_t ve_ptrace_read_memory(pid_t pid, void *addr, void *buf, size_t len);
+ssize_t ve_ptrace_write_memory(pid_t pid, void *addr, const void *buf,
+		size_t len);
 #endif
@@ -45,6 +45,8 @@ extern pthread_mutexattr_t chkmutex;	/* PTHREAD_MUTEX_ERRORCHECK_NP */
 
 #define MAX_VE_NODE		8	/* connected to same VH */
 #define MAX_THREADS		20	/* worker threads */
+#define MIN_THREADS		4	/* worker threads kept while idle */
+#define IVED_WORK_QUEUE_SIZE	256	/* accepted sockets waiting for a worker */
 #define BUFFER_LENGTH		256
 #define PID_FILE		"pid_file.txt"
 
@@ -60,17 +62,16 @@ extern pthread_mutexattr_t chkmutex;	/* PTHREAD_MUTEX_ERRORCHECK_NP */
 #define VE_STAT_STOP	2	/* It is set when VESHM resources are used by
 				   others but VEOS stops. */
 
-#define BOOT_TIMEOUT	 120	/* seconds. Wait time while IVED boots. */
-#define OS_LOCK_TIMEOUT	  30	/* seconds. Wait time for OS locking. */
+#define IVED_PROC_HASH_SIZE	256	/* Buckets of process index per OS */
+#define IVED_VESHM_HASH_SIZE	64	/* Buckets of VESHM index per process */
 
+#define IVED_PID_HASH(pid)	((unsigned int)(pid) % IVED_PROC_HASH_SIZE)
 
-/*
- * flags 
- */
+#define BOOT_TIMEOUT	 120	/* seconds. Wait time while IVED boots. */
+#define OS_LOCK_TIMEOUT	  30	/* seconds. Wait time for OS locking. */
+#define THREAD_IDLE_TIMEOUT 30	/* seconds. An idle worker above MIN_THREADS
+				   exits after it. */
 
-#define THREAD_STOP		-1
-#define THREAD_WAIT_FOR_USE     0
-#define THREAD_IN_USE		1
 
 /*
  * Data structures 
@@ -78,11 +79,22 @@ extern pthread_mutexattr_t chkmutex;	/* PTHREAD_MUTEX_ERRORCHECK_NP */
 
 struct cr_page_info;
 
+/**
+ * @brief Hash index of VESHM trackers in a having/attaching list.
+ * It is protected by proc_lock of the process.
+ */
+struct veshm_tracker_index{
+	struct list_head by_area[IVED_VESHM_HASH_SIZE];	/*!< VEMVA and size */
+	struct list_head by_uuid[IVED_VESHM_HASH_SIZE];	/*!< UUID of VESHM */
+};
+
 /** 
  * @brief Process informtaion per os. 
  */
 struct process_info{
 	struct list_head list;
+	struct list_head pid_hash;	/*!< Link of OS's index by PID */
+	struct list_head uuid_hash;	/*!< Link of OS's index by UUID */
 	pthread_mutex_t proc_lock;	/*!< lock for process_info */
 	int	proc_stat;		/*!< Process status */
 	pid_t	pid;
@@ -94,6 +106,8 @@ struct process_info{
 	int	attach_veshm_num;	/*!< # of attaching_veshm_info items */
 	struct list_head having_veshm_info;	/*!< Head of having list */
 	struct list_head attaching_veshm_info;	/*!< Head of attaching list */
+	struct veshm_tracker_index having_veshm_index;
+	struct veshm_tracker_index attaching_veshm_index;
 
 	/* CR */
 	struct cr_page_info *local_crd[4]; /*!< Using local CRs for MPI mode */
@@ -117,6 +131,10 @@ struct veos_info{
 	/* Process */
 	struct list_head proc_info_list;	/*!< Head of process info */
 	int	proc_info_num;		/*!< Number of processes */
+	struct list_head proc_pid_hash[IVED_PROC_HASH_SIZE];
+				/*!< Index of process info by PID */
+	struct list_head proc_uuid_hash[IVED_PROC_HASH_SIZE];
+				/*!< Index of process info by UUID */
 	/* VESHM */
 	struct list_head veshm_mem_info_list;	/*!< Head of VESHM mem info */
 	int	veshm_mem_num;		/*!< # of existing VESHM in a node */
@@ -130,9 +148,6 @@ struct veos_info{
  */
 typedef struct ived_thread_arg{		/* often named pti */
 	int socket_descriptor;		/* descriptor to read/write */
-	int tid_used;			/* if thread is used or not */
-	pthread_mutex_t mtx;
-	pthread_cond_t cond;
 	struct ucred	cred;		/*!< credential */
 	uint flag;			/*!< status flag of thread */
 
@@ -144,6 +159,32 @@ typedef struct ived_thread_arg{		/* often named pti */
 } ived_thread_arg_t;
 
 
+/**
+ * @brief Queue of accepted sockets and the worker pool serving it.
+ * All members are protected by lock.
+ */
+struct ived_work_queue{
+	pthread_mutex_t lock;
+	pthread_cond_t	work_cv;	/*!< Signaled when a socket is queued */
+	pthread_cond_t	space_cv;	/*!< Signaled when a socket is dequeued */
+	pthread_cond_t	exit_cv;	/*!< Signaled when a worker exits */
+	int	sock[IVED_WORK_QUEUE_SIZE];	/*!< Ring of accepted sockets */
+	struct timespec queued[IVED_WORK_QUEUE_SIZE];
+					/*!< Time when a socket is queued */
+	int	head;			/*!< Index of the oldest socket */
+	int	depth;			/*!< # of queued sockets */
+	int	nr_threads;		/*!< # of worker threads */
+	int	nr_idle;		/*!< # of workers waiting for a socket */
+
+	/* Statistics */
+	int	max_depth;		/*!< Maximum depth of the queue */
+	uint64_t nr_requests;		/*!< # of served requests */
+	uint64_t wait_ns;		/*!< Total time in the queue */
+	uint64_t service_ns;		/*!< Total service time */
+	uint64_t max_service_ns;	/*!< Maximum service time */
+};
+
+
 /**
  * @brief RPC command and function list
  */
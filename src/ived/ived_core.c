@@ -196,6 +196,26 @@ erase_ived_resource_user(struct ived_resource_user *erase_ent,
 }
 
 
+/**
+ * @brief Get a hash bucket of UUID
+ *
+ * @param [in]	uuid	UUID
+ * @param [in]	size	Number of buckets
+ *
+ * @return Bucket number
+ */
+unsigned int
+ived_hash_uuid(uuid_t uuid, unsigned int size)
+{
+	int i;
+	unsigned int hash = 0;
+
+	for (i = 0; i < sizeof(uuid_t); i++){
+		hash = hash * 31 + uuid[i];
+	}
+	return (hash % size);
+}
+
 /** For test **/
 int
 dump_os_info(struct veos_info *os_info)
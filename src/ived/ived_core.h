@@ -42,6 +42,8 @@ create_ived_resource_user(struct list_head *, pthread_mutex_t *,
 int erase_ived_resource_user(struct ived_resource_user *, 
 			     struct list_head *, pthread_mutex_t *);
 
+unsigned int ived_hash_uuid(uuid_t, unsigned int);
+
 /* test */
 int dump_os_info(struct veos_info *);
 int dump_proc_info(struct process_info *);
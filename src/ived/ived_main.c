@@ -30,7 +30,6 @@
 #include <getopt.h>
 #include <libgen.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -64,9 +63,7 @@
 #include "cr_core.h"
 
 char *ived_sock_file = NULL;
-static ived_thread_arg_t *pt_info;
-static pthread_t *worker_tid;
-static sem_t worker_sem;
+static struct ived_work_queue work_queue;
 static volatile sig_atomic_t thread_running = 0;
 
 struct veos_info veos_info[MAX_VE_NODE];
@@ -135,13 +132,12 @@ initialize_ived()
 		}
 	}
 
-	/* Initialize semaphore */
-	ret = sem_init(&worker_sem, 0, MAX_THREADS);
-	if ( ret != 0 ){
-		IVED_CRIT(log4cat_main, "Initializing IVED failed: %s", 
-			  strerror(ret));
-		return (-1);
-	}
+	/* Initialize work queue */
+	memset(&work_queue, 0, sizeof(work_queue));
+	pthread_mutex_init(&work_queue.lock, NULL);
+	pthread_cond_init(&work_queue.work_cv, NULL);
+	pthread_cond_init(&work_queue.space_cv, NULL);
+	pthread_cond_init(&work_queue.exit_cv, NULL);
 
 	/* data structures */
 	for (i=0; i< MAX_VE_NODE; i++){
@@ -158,6 +154,10 @@ initialize_ived()
 			return (-1);
 		}
 		INIT_LIST_HEAD(&veos_info[i].proc_info_list);
+		for (j=0; j < IVED_PROC_HASH_SIZE; j++){
+			INIT_LIST_HEAD(&veos_info[i].proc_pid_hash[j]);
+			INIT_LIST_HEAD(&veos_info[i].proc_uuid_hash[j]);
+		}
 		INIT_LIST_HEAD(&veos_info[i].veshm_mem_info_list);
 
 		veos_info[i].cr_page_info = (struct cr_page_info *)malloc
@@ -470,36 +470,111 @@ err_ret:
 
 
 /**
- * @brief Mark worker thread as usable.
+ * @brief Get elapsed time in nanoseconds.
+ *
+ * @param [in] from  Start time
+ * @param [in] to    End time
+ *
+ * @return Elapsed time in nanoseconds
+ */
+static uint64_t
+ived_elapsed_ns(struct timespec *from, struct timespec *to)
+{
+	return((uint64_t)(to->tv_sec - from->tv_sec) * 1000000000ULL
+	       + to->tv_nsec - from->tv_nsec);
+}
+
+
+/**
+ * @brief Dump statistics of the work queue
+ * NOTE: Before entering this function, a caller must acquire work_queue.lock.
+ */
+static void
+dump_work_queue_stat()
+{
+	IVED_INFO(log4cat_main,
+		  "Work queue: threads:%d idle:%d depth:%d max depth:%d",
+		  work_queue.nr_threads, work_queue.nr_idle,
+		  work_queue.depth, work_queue.max_depth);
+	IVED_INFO(log4cat_main,
+		  "Work queue: requests:%"PRIu64" avg wait:%"PRIu64"ns "
+		  "avg service:%"PRIu64"ns max service:%"PRIu64"ns",
+		  work_queue.nr_requests,
+		  (work_queue.nr_requests == 0) ? 0 :
+		  work_queue.wait_ns / work_queue.nr_requests,
+		  (work_queue.nr_requests == 0) ? 0 :
+		  work_queue.service_ns / work_queue.nr_requests,
+		  work_queue.max_service_ns);
+}
+
+
+/**
+ * @brief Serve a request on an accepted socket
+ *
+ * This function checks socket's credential.
+ * If this function failed, it sends a return message to a client.
  * 
  * @param [in]     pti	 Pointer of thread information	
- *
- * @returne0
  */
-static int
-change_thread_unused(ived_thread_arg_t *pti)
+static void
+ived_serve_request(ived_thread_arg_t *pti)
 {
-	if (pti == NULL){
-		IVED_CRIT(log4cat_main, "Argument is NULL.");
-		abort();
-	}
-	errno = 0;
-	pthread_mutex_lock(&pti->mtx);
-	pti->tid_used = THREAD_WAIT_FOR_USE;
+	int ret;
+	int ucred_size = sizeof(struct ucred);
+	int rpc_retval = 0;	/* Return value of RPC message */
+	int rpc_reterr = 0;	/* Return error of RPC message */
+
+	IVED_TRACE(log4cat_main, "[%u] socket descriptor number is %d",
+		   (unsigned int)pthread_self(), pti->socket_descriptor);
+
 	pti->socket_not_close = 0;
-	pthread_mutex_unlock(&pti->mtx);
 
-	return(0);
+	ret = getsockopt(pti->socket_descriptor, SOL_SOCKET, 
+			 SO_PEERCRED, &(pti->cred), 
+			 (socklen_t *)&ucred_size);
+	if (ret != 0 ){
+		IVED_ERROR(log4cat_main, "Getting credential failed.(%s)",
+			   strerror(errno));
+		rpc_retval = IVED_REQ_NG;
+		rpc_reterr = -ECANCELED;
+	}
+	if (pti->cred.uid != ROOT_USR){
+		IVED_DEBUG(log4cat_main, "Credential check failed.");
+		rpc_retval = IVED_REQ_NG;
+		rpc_reterr = -EACCES;
+	}
+
+	if (rpc_retval == IVED_REQ_NG){
+		/* Cancel a request */
+		IVED_DEBUG(log4cat_main, "Connection failed");
+		ived_send_int64(pti->socket_descriptor, 
+				rpc_retval, rpc_reterr);
+		close(pti->socket_descriptor);
+		pti->socket_descriptor = -1;
+		return;
+	}
+
+	process_request(pti);
+
+	if (pti->socket_not_close == 0){
+		/* If a request is IVED_OS_REG, socket_not_close is
+		 * set 1.  The socket is reused for a request from IVED. */
+		close(pti->socket_descriptor);
+		pti->socket_descriptor = -1;
+	}
+
+	IVED_DEBUG(log4cat_main, "Request Handled and thread released.\n");
 }
 
 
 /**
  * @brief  worker thread function
  *
- * It is started by the main thread. This function checks socket's credential.
- * If this function failed, it sends a return message to a client.
+ * It is started by the main thread. It takes accepted sockets from the
+ * work queue and serves them. A worker exits if it is idle for
+ * THREAD_IDLE_TIMEOUT seconds and more than MIN_THREADS workers exist.
  *
- * @param [in]   arg Argument to worker thread which is REQ packet
+ * @param [in]   arg Thread information allocated by ived_create_worker()
  *
  * @return 0 on success, 1 on failure
  */
@@ -510,19 +585,12 @@ ived_thread_start(void *arg)
 	int retval=0;		/* return value of this function */
 	ived_thread_arg_t *pti = (ived_thread_arg_t *)(void *)arg;
 	pthread_t selfid = pthread_self();
-	int ucred_size = sizeof(struct ucred);
 	sigset_t set;
-
-	int rpc_retval = 0;	/* Return value of RPC message */
-	int rpc_reterr = 0;	/* Return error of RPC message */
+	struct timespec timeout, start, end;
+	uint64_t wait_ns, service_ns;
 
 	IVED_DEBUG(log4cat_main, "tid %u is started.", (unsigned int)selfid);
 
-	if (pti == NULL){
-		IVED_CRIT(log4cat_main, "Thread data is invalid.");
-		goto pti_error;
-	}
-
 	/* Ignore signals */
 	sigemptyset(&set);
 	sigaddset(&set, SIGINT);
@@ -532,95 +600,167 @@ ived_thread_start(void *arg)
 	ret = pthread_sigmask(SIG_BLOCK, &set, NULL);
 	assert( ret == 0 );
 
-	pthread_mutex_init(&pti->mtx, NULL);
-	pthread_cond_init(&pti->cond, NULL);
-
 	ret = get_rpc_buf(&pti->telegram_buf, IVED_BUF_MAX_SIZE);
 	if (ret != 0){
 		IVED_CRIT(log4cat_main, "Allocating a buffer failed");
-		goto pti_error;
+		pthread_mutex_lock(&work_queue.lock);
+		goto thread_end;
 	}
 	memset(pti->telegram_buf, 0, IVED_BUF_MAX_SIZE);
 
-	while (thread_running) {
-		pthread_mutex_lock(&pti->mtx);
-
-		/* wait until awaken */
-		while (pti->tid_used != THREAD_IN_USE) {
-			pthread_cond_wait(&pti->cond, &pti->mtx);
-			if (pti->tid_used == THREAD_STOP) {
-				pthread_mutex_unlock(&pti->mtx);
-				IVED_INFO(log4cat_main, "[%u] Thread is shutting down.",
-					  (uint)pthread_self());
+	pthread_mutex_lock(&work_queue.lock);
+	while (1) {
+		/* wait until a socket is queued */
+		while (work_queue.depth == 0 && thread_running){
+			clock_gettime(CLOCK_REALTIME, &timeout);
+			timeout.tv_sec += THREAD_IDLE_TIMEOUT;
+			work_queue.nr_idle++;
+			ret = pthread_cond_timedwait(&work_queue.work_cv,
+						     &work_queue.lock,
+						     &timeout);
+			work_queue.nr_idle--;
+			if (ret == ETIMEDOUT && work_queue.depth == 0
+			    && work_queue.nr_threads > MIN_THREADS){
+				IVED_DEBUG(log4cat_main,
+					   "[%u] Idle thread exits.",
+					   (uint)selfid);
+				dump_work_queue_stat();
 				goto thread_end;
 			}
 		}
-
-		pthread_mutex_unlock(&pti->mtx);
-		IVED_TRACE(log4cat_main, "[%u] socket descriptor number is %d",
-			   (unsigned int)selfid, pti->socket_descriptor);
-
-		ret = getsockopt(pti->socket_descriptor, SOL_SOCKET, 
-				 SO_PEERCRED, &(pti->cred), 
-				 (socklen_t *)&ucred_size);
-		if (ret != 0 ){
-			IVED_ERROR(log4cat_main, "Getting credential failed.(%s)",
-				   strerror(errno));
-			rpc_retval = IVED_REQ_NG;
-			rpc_reterr = -ECANCELED;
+		if (thread_running == 0){
+			IVED_INFO(log4cat_main, "[%u] Thread is shutting down.",
+				  (uint)selfid);
+			goto thread_end;
 		}
-		if (pti->cred.uid != ROOT_USR){
-			IVED_DEBUG(log4cat_main, "Credential check failed.");
-			rpc_retval = IVED_REQ_NG;
-			rpc_reterr = -EACCES;
-		}
-
-		if (rpc_retval == IVED_REQ_NG){
-			IVED_DEBUG(log4cat_main, "Connection failed");
-			ived_send_int64(pti->socket_descriptor, 
-					rpc_retval, rpc_reterr);
-			close(pti->socket_descriptor);
-			pti->socket_descriptor = -1;
-
-			rpc_retval = 0;
-			rpc_reterr = 0;
-
-			/* Cancel a request */
-			change_thread_unused(pti);
-			sem_post(&worker_sem);
 
-			continue;
-		}
+		pti->socket_descriptor = work_queue.sock[work_queue.head];
+		start = work_queue.queued[work_queue.head];
+		work_queue.head = (work_queue.head + 1) % IVED_WORK_QUEUE_SIZE;
+		work_queue.depth--;
+		pthread_cond_signal(&work_queue.space_cv);
+		pthread_mutex_unlock(&work_queue.lock);
 
-		process_request(pti);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		wait_ns = ived_elapsed_ns(&start, &end);
+		start = end;
 
-		if (pti->socket_not_close == 0){
-			/* If a request is IVED_OS_REG, socket_not_close is
-			 * set 1.  The socket is reused for a request from IVED. */
-			close(pti->socket_descriptor);
-			pti->socket_descriptor = -1;
-		}
+		ived_serve_request(pti);
 
-		/* Finish a request */
-		change_thread_unused(pti);
-		sem_post(&worker_sem);
+		clock_gettime(CLOCK_MONOTONIC, &end);
 
-		IVED_DEBUG(log4cat_main, 
-			   "Request Handled and thread released.\n");
+		pthread_mutex_lock(&work_queue.lock);
+		work_queue.nr_requests++;
+		service_ns = ived_elapsed_ns(&start, &end);
+		work_queue.wait_ns += wait_ns;
+		work_queue.service_ns += service_ns;
+		if (work_queue.max_service_ns < service_ns)
+			work_queue.max_service_ns = service_ns;
 	}
 
 thread_end:
-	pthread_mutex_destroy(&pti->mtx);
-	pthread_cond_destroy(&pti->cond);
+	work_queue.nr_threads--;
+	pthread_cond_signal(&work_queue.exit_cv);
+	pthread_mutex_unlock(&work_queue.lock);
+
 	if (pti->telegram_buf != NULL){
 		free(pti->telegram_buf);
 	}
+	free(pti);
 
-pti_error:
 	pthread_exit(&retval);
 }
 
 
+/**
+ * @brief Create a worker thread
+ * NOTE: Before entering this function, a caller must acquire work_queue.lock.
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int
+ived_create_worker()
+{
+	int ret;
+	pthread_t tid;
+	pthread_attr_t attr;
+	ived_thread_arg_t *pti = NULL;
+
+	pti = (ived_thread_arg_t *)calloc(1, sizeof(ived_thread_arg_t));
+	if (pti == NULL){
+		IVED_ERROR(log4cat_main, "Creating a worker failed: %s",
+			   strerror(errno));
+		return(-1);
+	}
+	pti->socket_descriptor = -1;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	ret = pthread_create(&tid, &attr, ived_thread_start, (void *)pti);
+	pthread_attr_destroy(&attr);
+	if (ret != 0){
+		IVED_ERROR(log4cat_main, "Creating a worker failed: %s",
+			   strerror(ret));
+		free(pti);
+		return(-1);
+	}
+	work_queue.nr_threads++;
+
+	IVED_DEBUG(log4cat_main, "Worker threads: %d", work_queue.nr_threads);
+	return(0);
+}
+
+
+/**
+ * @brief Pass an accepted socket to worker threads.
+ * If all workers are busy, a new worker is created up to MAX_THREADS.
+ * If the queue is full, this function waits until a worker takes a socket.
+ *
+ * @param [in] a_sock	Accepted socket
+ *
+ * @return 0 on success, -1 on failure (The socket is closed.)
+ */
+static int
+ived_enqueue_work(int a_sock)
+{
+	int tail;
+	struct timespec timeout;
+
+	pthread_mutex_lock(&work_queue.lock);
+	while (work_queue.depth == IVED_WORK_QUEUE_SIZE && thread_running){
+		/* Wake up periodically to check thread_running */
+		clock_gettime(CLOCK_REALTIME, &timeout);
+		timeout.tv_sec += 1;
+		pthread_cond_timedwait(&work_queue.space_cv, &work_queue.lock,
+				       &timeout);
+	}
+	if (thread_running == 0){
+		pthread_mutex_unlock(&work_queue.lock);
+		close(a_sock);
+		return(-1);
+	}
+
+	tail = (work_queue.head + work_queue.depth) % IVED_WORK_QUEUE_SIZE;
+	work_queue.sock[tail] = a_sock;
+	clock_gettime(CLOCK_MONOTONIC, &work_queue.queued[tail]);
+	work_queue.depth++;
+	if (work_queue.max_depth < work_queue.depth)
+		work_queue.max_depth = work_queue.depth;
+
+	if (work_queue.depth > work_queue.nr_idle
+	    && work_queue.nr_threads < MAX_THREADS){
+		/* If it failed, existing workers serve the socket later. */
+		ived_create_worker();
+	}
+	pthread_cond_signal(&work_queue.work_cv);
+	pthread_mutex_unlock(&work_queue.lock);
+
+	IVED_TRACE(log4cat_main, "Queued socket:%d depth:%d", 
+		   a_sock, work_queue.depth);
+	return(0);
+}
+
+
 /**
  * @brief  This function cleanups the resources required
  * for the VE node.
@@ -637,17 +777,21 @@ ived_shutdown()
 
 	IVED_INFO(log4cat_main, "[%u] Start IVED shutdown.", 
 		  (unsigned int) pthread_self());
-	for (i = 0; i < MAX_THREADS; i++) {
-		pthread_mutex_lock(&pt_info[i].mtx);
-		pt_info[i].tid_used = THREAD_STOP;
-		pthread_cond_signal(&pt_info[i].cond);
-		pthread_mutex_unlock(&pt_info[i].mtx);
-	}
 
 	/* Wait worker threads' exit */
-	for (i = 0; i < MAX_THREADS; i++) {
-		pthread_join(worker_tid[i], NULL);
+	pthread_mutex_lock(&work_queue.lock);
+	thread_running = 0;
+	pthread_cond_broadcast(&work_queue.work_cv);
+	while (work_queue.nr_threads > 0)
+		pthread_cond_wait(&work_queue.exit_cv, &work_queue.lock);
+
+	/* Drop connections which are not served */
+	for (; work_queue.depth > 0; work_queue.depth--){
+		close(work_queue.sock[work_queue.head]);
+		work_queue.head = (work_queue.head + 1) % IVED_WORK_QUEUE_SIZE;
 	}
+	dump_work_queue_stat();
+	pthread_mutex_unlock(&work_queue.lock);
 
 	/* Clear lock/cond of veos data structures */
 	for (i=0; i< MAX_VE_NODE; i++){
@@ -656,7 +800,10 @@ ived_shutdown()
 		pthread_cond_destroy(&veos_info[i].os_cv);
 	}
 
-	sem_destroy(&worker_sem);
+	pthread_mutex_destroy(&work_queue.lock);
+	pthread_cond_destroy(&work_queue.work_cv);
+	pthread_cond_destroy(&work_queue.space_cv);
+	pthread_cond_destroy(&work_queue.exit_cv);
 
 	IVED_INFO(log4cat_main, "ived shutdown succeeded.");
 	log4c_fini();
@@ -683,7 +830,6 @@ sigint_handler(int arg)
 void 
 ived_main_thread() 
 {
-	int i;
 	int l_sock;
 	int a_sock;
 	struct sigaction act;
@@ -739,9 +885,6 @@ ived_main_thread()
 			if (thread_running == 0)
 				goto ived_terminate; 
 
-			sem_wait(&worker_sem);
-
-			IVED_TRACE(log4cat_main, "Get semaphore.") ;
 			errno = 0;
 			a_sock = accept(l_sock, NULL, NULL);
 			if (a_sock == -1) {
@@ -759,29 +902,8 @@ ived_main_thread()
 			break;
 		}
 
-		IVED_TRACE(log4cat_main, "[%u] PASS", (uint)pthread_self());
-		/* find unused thread and assign socket number */
-		for (i = 0; i < MAX_THREADS; i++) {
-			pthread_mutex_lock(&pt_info[i].mtx);
-			if ((pt_info[i].tid_used == THREAD_WAIT_FOR_USE)){
-				/* thread waiting for use is found */
-				/* mark as in use */
-				pt_info[i].tid_used = THREAD_IN_USE;
-
-				/* set socket descriptor */
-				pt_info[i].socket_descriptor = a_sock;
-
-				/* wake the thread up */
-				pthread_cond_signal(&pt_info[i].cond);
-				pthread_mutex_unlock(&pt_info[i].mtx);
-				break;
-			} else {
-				/* unlock and try other one */
-				pthread_mutex_unlock(&pt_info[i].mtx);
-			}
-		}
-
-		IVED_TRACE(log4cat_main, "[%u] PASS", (uint)pthread_self());
+		/* pass the socket to a worker thread */
+		ived_enqueue_work(a_sock);
 	}
 
 ived_error:
@@ -874,32 +996,17 @@ main(int argc, char *argv[])
 		exit(EXIT_FAILURE);
 	}
 
-	/* allocate tid */
-	worker_tid = (pthread_t *)malloc(MAX_THREADS * sizeof(pthread_t));
-	if (worker_tid == NULL){
-		IVED_FATAL(log4cat_main, "Initializing failed: %s",
-			   strerror(errno));
-		exit(EXIT_FAILURE);
-	}
-	IVED_DEBUG(log4cat_main, "worker_tid = %p", worker_tid);
-
-	/* allocate thread info structure */
-	pt_info = (ived_thread_arg_t *)malloc
-		(MAX_THREADS * sizeof(ived_thread_arg_t));
-	if (pt_info == NULL){
-		IVED_FATAL(log4cat_main, "Initializing failed: %s",
-			   strerror(errno));
-		exit(EXIT_FAILURE);
-	}
-	IVED_DEBUG(log4cat_main, "ptinfo = %p", pt_info);
-
 	/* create threads */
 	thread_running = 1;
-	for (i = 0; i < MAX_THREADS; i++) {
-		pthread_create(&worker_tid[i], NULL, ived_thread_start,
-			       (void *)(ived_thread_arg_t *)&pt_info[i]);
-		pt_info[i].tid_used = THREAD_WAIT_FOR_USE;
+	pthread_mutex_lock(&work_queue.lock);
+	for (i = 0; i < MIN_THREADS; i++) {
+		ret = ived_create_worker();
+		if (ret != 0){
+			IVED_FATAL(log4cat_main, "Initializing failed.");
+			exit(EXIT_FAILURE);
+		}
 	}
+	pthread_mutex_unlock(&work_queue.lock);
 
 	ived_main_thread();
 	return(EXIT_SUCCESS);
@@ -1323,7 +1430,7 @@ get_procinfo_struct(struct veos_info *osdata, int pid, uuid_t uuid_proc,
 	int flag_uuid;
 	struct process_info *entry = NULL;
 	struct process_info *ret_ent = NULL;
-	struct list_head *list_p;
+	struct list_head *list_p, *bucket;
 	int found = 0;
 
 	assert(osdata != NULL);
@@ -1342,8 +1449,27 @@ get_procinfo_struct(struct veos_info *osdata, int pid, uuid_t uuid_proc,
 	else
 		flag_uuid = 1;
 
-	list_for_each(list_p, &(osdata->proc_info_list)){
-		entry = list_entry(list_p, struct process_info, list);
+	/* PID and UUID of a linked process are not changed, so they are
+	 * compared before acquiring proc_lock. */
+	if (flag_uuid == 0){
+		bucket = &osdata->proc_pid_hash[IVED_PID_HASH(pid)];
+	} else {
+		bucket = &osdata->proc_uuid_hash
+			[ived_hash_uuid(uuid_proc, IVED_PROC_HASH_SIZE)];
+	}
+
+	list_for_each(list_p, bucket){
+		if (flag_uuid == 0){
+			entry = list_entry(list_p, struct process_info,
+					   pid_hash);
+			if (entry->pid != pid)
+				continue;
+		} else {
+			entry = list_entry(list_p, struct process_info,
+					   uuid_hash);
+			if (uuid_compare(entry->uuid_proc, uuid_proc) != 0)
+				continue;
+		}
 
 		ret = pthread_mutex_lock(&entry->proc_lock);
 		if (ret != 0){
@@ -1375,8 +1501,12 @@ get_procinfo_struct(struct veos_info *osdata, int pid, uuid_t uuid_proc,
 		entry->pid = UNUSED;
 		pthread_mutex_init(&entry->proc_lock, &chkmutex);
 		INIT_LIST_HEAD(&entry->list);
+		INIT_LIST_HEAD(&entry->pid_hash);
+		INIT_LIST_HEAD(&entry->uuid_hash);
 		INIT_LIST_HEAD(&entry->having_veshm_info);
 		INIT_LIST_HEAD(&entry->attaching_veshm_info);
+		init_veshm_tracker_index(&entry->having_veshm_index);
+		init_veshm_tracker_index(&entry->attaching_veshm_index);
 		INIT_LIST_HEAD(&entry->using_cr_info);
 
 		pthread_mutex_lock(&entry->proc_lock);
@@ -1441,6 +1571,8 @@ erase_procinfo_struct(struct veos_info *os_info, struct process_info *proc_info)
 
 	os_info->proc_info_num--;
 	list_del(&proc_info->list);
+	list_del(&proc_info->pid_hash);
+	list_del(&proc_info->uuid_hash);
 
 	free(proc_info);
 	return(0);
@@ -1967,6 +2099,11 @@ ived_register_procdata(ived_thread_arg_t *pti, RpcIvedArg *request)
 
 	os_info->proc_info_num++;
 	list_add(&proc_info->list , &os_info->proc_info_list);
+	list_add(&proc_info->pid_hash,
+		 &os_info->proc_pid_hash[IVED_PID_HASH(pid)]);
+	list_add(&proc_info->uuid_hash,
+		 &os_info->proc_uuid_hash[ived_hash_uuid(proc_info->uuid_proc,
+							 IVED_PROC_HASH_SIZE)]);
 
 	rpc_retval = IVED_REQ_OK;
 
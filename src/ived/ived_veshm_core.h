@@ -99,6 +99,8 @@ struct veshm_memory_info{
  */
 struct veshm_info_tracker{
 	struct list_head list;
+	struct list_head area_hash;	/*!< Link of index by VEMVA and size */
+	struct list_head uuid_hash;	/*!< Link of index by UUID of VESHM */
 	struct veshm_memory_info *veshm_info;
 };
 
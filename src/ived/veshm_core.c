@@ -174,6 +174,93 @@ erase_veshm_attach_proc(struct veshm_memory_info *veshm_info,
 }
 
 
+/**
+ * @brief Initialize a hash index of VESHM trackers
+ *
+ * @param [in]	index	Index to initialize
+ */
+void
+init_veshm_tracker_index(struct veshm_tracker_index *index)
+{
+	int i;
+
+	for (i = 0; i < IVED_VESHM_HASH_SIZE; i++){
+		INIT_LIST_HEAD(&index->by_area[i]);
+		INIT_LIST_HEAD(&index->by_uuid[i]);
+	}
+}
+
+/**
+ * @brief Get a hash bucket of VESHM area
+ *
+ * @param [in]	vemva	VEMVA of VESHM
+ * @param [in]	size	Size of VESHM
+ *
+ * @return Bucket number
+ */
+static unsigned int
+veshm_area_hash(uint64_t vemva, uint64_t size)
+{
+	return ((unsigned int)((vemva >> SHFT_2M) ^ (size >> SHFT_2M))
+		% IVED_VESHM_HASH_SIZE);
+}
+
+/**
+ * @brief Get a hash index of a having / attaching list
+ *
+ * @param [in]	head		List head of a target list
+ * @param [in]	proc_info	Process which has the list
+ *
+ * @return Pointer to the index
+ */
+static struct veshm_tracker_index *
+veshm_tracker_index(struct list_head *head, struct process_info *proc_info)
+{
+	if (head == &proc_info->having_veshm_info)
+		return (&proc_info->having_veshm_index);
+	return (&proc_info->attaching_veshm_index);
+}
+
+/**
+ * @brief Add a having / attaching VESHM information to hash indexes
+ *
+ * A tracker is created before its VESHM information is filled, so a
+ * caller adds it to indexes after VEMVA, size and UUID of the VESHM
+ * are set.
+ * NOTE: Before entering this function, a caller must acquire a lock.
+ * proc_lock
+ *
+ * @param [in]	head		List head of a list having the tracker
+ * @param [in]	proc_info	Process which has the list
+ * @param [in]	entry		Tracker to add
+ *
+ * @return 0 on success, -1 on failure
+ */
+int
+index_veshm_tracker(struct list_head *head, struct process_info *proc_info,
+		    struct veshm_info_tracker *entry)
+{
+	struct veshm_tracker_index *index;
+	struct veshm_memory_info *veshm;
+
+	if (head == NULL || proc_info == NULL || entry == NULL
+	    || entry->veshm_info == NULL){
+		IVED_CRIT(log4cat_veshm, "Argument is NULL.");
+		return (-1);
+	}
+
+	index = veshm_tracker_index(head, proc_info);
+	veshm = entry->veshm_info;
+
+	list_del_init(&entry->area_hash);
+	list_del_init(&entry->uuid_hash);
+	list_add(&entry->area_hash, &index->by_area
+		 [veshm_area_hash(veshm->start_vemva, veshm->size)]);
+	list_add(&entry->uuid_hash, &index->by_uuid
+		 [ived_hash_uuid(veshm->uuid_veshm, IVED_VESHM_HASH_SIZE)]);
+	return (0);
+}
+
 /**
  * @brief Pickup a having / attaching VESHM information by UUID of VESHM
  * This function searchs the specified VESHM and returns a having / attaching
@@ -195,6 +282,7 @@ search_veshm_tracker_uuid(struct list_head *head,
 	struct list_head *list_p;
 	struct veshm_info_tracker *entry = NULL;
 	struct veshm_memory_info *veshm = NULL;
+	struct veshm_tracker_index *index;
 	int existing = 0;
 
 	IVED_TRACE(log4cat_veshm, "[%u] PASS", (uint)pthread_self());
@@ -211,8 +299,11 @@ search_veshm_tracker_uuid(struct list_head *head,
 		goto err_ret;
 	}
 
-	list_for_each(list_p, head){
-		entry = list_entry(list_p, struct veshm_info_tracker, list);
+	index = veshm_tracker_index(head, proc_info);
+	list_for_each(list_p, &index->by_uuid
+		      [ived_hash_uuid(uuid_veshm, IVED_VESHM_HASH_SIZE)]){
+		entry = list_entry(list_p, struct veshm_info_tracker,
+				   uuid_hash);
 		veshm = entry->veshm_info;
 		if ( uuid_compare(veshm->uuid_veshm, uuid_veshm) == 0){
 			existing = 1;
@@ -255,6 +346,7 @@ search_veshm_tracker(struct list_head *head, struct process_info *proc_info,
 	struct list_head *list_p;
 	struct veshm_info_tracker *entry = NULL;
 	struct veshm_memory_info *veshm = NULL;
+	struct veshm_tracker_index *index;
 	int existing = 0;
 
 	if (head == NULL || proc_info == NULL){
@@ -266,8 +358,10 @@ search_veshm_tracker(struct list_head *head, struct process_info *proc_info,
 		goto err_ret;
 	}
 
-	list_for_each(list_p, head){
-		entry = list_entry(list_p, struct veshm_info_tracker, list);
+	index = veshm_tracker_index(head, proc_info);
+	list_for_each(list_p, &index->by_area[veshm_area_hash(vemva, size)]){
+		entry = list_entry(list_p, struct veshm_info_tracker,
+				   area_hash);
 		veshm = entry->veshm_info;
 		if ( veshm->pid_of_owner == owner_pid
 		     && veshm->start_vemva == vemva 
@@ -333,6 +427,8 @@ create_having_veshm_tracker(struct process_info *proc_info)
 
 	entry->veshm_info = new_veshm;
 	INIT_LIST_HEAD(&entry->list);
+	INIT_LIST_HEAD(&entry->area_hash);
+	INIT_LIST_HEAD(&entry->uuid_hash);
 	proc_info->own_veshm_num++;
 	list_add(&entry->list, &proc_info->having_veshm_info);
 
@@ -389,6 +485,8 @@ create_attaching_veshm_tracker(struct process_info *proc_info)
 	proc_info->attach_veshm_num++;
 
 	INIT_LIST_HEAD(&entry->list);
+	INIT_LIST_HEAD(&entry->area_hash);
+	INIT_LIST_HEAD(&entry->uuid_hash);
 	list_add(&entry->list, &proc_info->attaching_veshm_info);
 
 	IVED_DEBUG(log4cat_veshm, "[%u] entry:%p", (uint)pthread_self(), entry);
@@ -426,6 +524,8 @@ erase_veshm_tracker(struct veshm_info_tracker *erase_ent, int *counter)
 
 	(*counter)--;
 	list_del(&erase_ent->list);
+	list_del(&erase_ent->area_hash);
+	list_del(&erase_ent->uuid_hash);
 	free(erase_ent);
 
 	return(0);
@@ -50,6 +50,12 @@ erase_veshm_attach_proc(struct veshm_memory_info *,
 struct veshm_info_tracker *
 create_attaching_veshm_tracker(struct process_info *); 
 
+void init_veshm_tracker_index(struct veshm_tracker_index *);
+
+int
+index_veshm_tracker(struct list_head *, struct process_info *,
+		    struct veshm_info_tracker *);
+
 struct veshm_info_tracker *
 search_veshm_tracker_uuid(struct list_head *, struct process_info *, 
 			  uuid_t);
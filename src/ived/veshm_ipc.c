@@ -297,6 +297,9 @@ ived_veshm_open(ived_thread_arg_t *pti, RpcVeshmArg *request)
 		veshm_info->n_pci_address = req_n_pci_address; 
 
 		veshm_info->os_info	   = os_info;
+
+		index_veshm_tracker(&proc_info->having_veshm_info, proc_info,
+				    having_veshm);
 	}
 
 	if ( isset_flag(req_mode_flag, VE_REQ_DEV )){
@@ -477,6 +480,15 @@ ived_veshm_attach(ived_thread_arg_t *pti, RpcVeshmArg *request)
 		rpc_reterr = -EINVAL;
 		goto err_ret_lock_veshm;
 	}
+	/* A requester specified the VESHM it attached before */
+	if ((request->attach_arg)->has_uuid_veshm
+	    && (request->attach_arg)->uuid_veshm.len == sizeof(uuid_t)
+	    && uuid_compare(veshm_info->uuid_veshm,
+			    (request->attach_arg)->uuid_veshm.data) != 0){
+		IVED_DEBUG(log4cat_veshm, "%s", strerror(ESTALE));
+		rpc_reterr = -ESTALE;
+		goto err_ret_lock_veshm;
+	}
 	if (veshm_info->uid_of_owner != req_user_uid){
 		IVED_DEBUG(log4cat_veshm, "%s", strerror(EACCES));
 		rpc_reterr = -EACCES;
@@ -572,6 +584,8 @@ ived_veshm_attach(ived_thread_arg_t *pti, RpcVeshmArg *request)
 		goto err_ret;
 	}
 	attach_veshm->veshm_info = veshm_info;
+	index_veshm_tracker(&user_proc_info->attaching_veshm_info,
+			    user_proc_info, attach_veshm);
 
 	dump_tracker(attach_veshm);
 	dump_proc_info(user_proc_info);
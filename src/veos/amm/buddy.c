@@ -634,6 +634,46 @@ void buddy_free(struct buddy_mempool *mp, struct block *block)
 }
 
 
+/**
+* @brief This function takes free blocks inside a range out of VE memory
+*	pool, so that they are not allocated while the range is compacted.
+*	Isolated blocks are returned to mempool by buddy_free().
+*
+* @param[in] mp VE buddy mempool.
+* @param[in] start start address of range, aligned to range size.
+* @param[in] order order of range.
+* @param[out] isolated list to which isolated blocks are added.
+*
+* @return return total size of isolated blocks.
+*/
+size_t buddy_isolate(struct buddy_mempool *mp, uint64_t start,
+		unsigned long order, struct list_head *isolated)
+{
+	unsigned long j = 0;
+	size_t sz = 0;
+	struct block *curr_blk = NULL, *tmp_blk = NULL;
+
+	VEOS_TRACE("invoked");
+	VEOS_DEBUG("isolate free blks in range %lx of order %ld",
+			start, order);
+
+	for (j = mp->min_order; (j < order) && (j <= mp->pool_order); j++) {
+		list_for_each_entry_safe(curr_blk, tmp_blk,
+				&mp->frb->free[j], link) {
+			if ((curr_blk->start >> order) != (start >> order))
+				continue;
+			list_del(&curr_blk->link);
+			if (mp->frb->fr_cnt[j])
+				--mp->frb->fr_cnt[j];
+			list_add_tail(&curr_blk->link, isolated);
+			sz += (1UL << j);
+		}
+	}
+
+	VEOS_TRACE("returned(%lx)", sz);
+	return sz;
+}
+
 /**
 * @brief This function will intialize the buddy mempool.
 *
@@ -118,4 +118,6 @@ uint64_t roundup_pow_of_two(uint64_t);
 void veos_dump_ve_pages(void);
 size_t get_size_to_be_free(size_t extra_sz, int order, int count);
 size_t calc_free_sz(struct buddy_mempool *mp, int pgmod);
+size_t buddy_isolate(struct buddy_mempool *mp, uint64_t start,
+		unsigned long order, struct list_head *isolated);
 #endif
@@ -75,3 +75,39 @@ int amm_dma_xfer(int srctype, uint64_t src_addr, int src_pid,
 
 	return retval;
 }
+
+/**
+* @brief Vectored DMA transfer request to DMA library.
+*
+* @param[in] srctype source address type.
+* @param[in] src_pid source process identifier.
+* @param[in] dsttype destination type.
+* @param[in] dst_pid destination process identifier.
+* @param[in] seg array of segments to transfer.
+* @param[in] nseg number of segments.
+* @param[in] node_id Node ID.
+*
+* @return On success returns 0 and -1 on error.
+*/
+int amm_dma_xfer_vec(int srctype, int src_pid, int dsttype, int dst_pid,
+		ve_dma_seg_t *seg, int nseg, int node_id)
+{
+	int retval = 0;
+	ve_dma_hdl *dh = NULL;
+	ve_dma_status_t st = 0;
+	struct ve_node_struct *vnode_info = VE_NODE(node_id);
+
+	dh = vnode_info->dh;
+
+	VEOS_DEBUG("Vectored DMA Transfer From(PID:%d) To(PID:%d) "
+			"of %d segments", src_pid, dst_pid, nseg);
+
+	st = ve_dma_xfer_p_va_vec(dh, srctype, src_pid, dsttype, dst_pid,
+			seg, nseg);
+	if (st != VE_DMA_STATUS_OK) {
+		VEOS_DEBUG("DMA error (%d)", st);
+		retval = -1;
+	}
+
+	return retval;
+}
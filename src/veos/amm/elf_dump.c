@@ -609,8 +609,8 @@ static void fill_prstatus(struct elf_prstatus *prstatus,
 
 	struct timeval tp = {0};
 
-	tp.tv_sec = p->exec_time/SECS_TO_MICROSECONDS;
-	tp.tv_usec = p->exec_time%SECS_TO_MICROSECONDS;
+	tp.tv_sec = p->exec_time / SECS_TO_NANOSECONDS;
+	tp.tv_usec = (p->exec_time % SECS_TO_NANOSECONDS) / USECS_TO_NANOSECONDS;
 
 	prstatus->pr_info.si_signo = prstatus->pr_cursig = signr;
 	prstatus->pr_sigpend = (unsigned long)p->sigpending;
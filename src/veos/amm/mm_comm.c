@@ -25,6 +25,7 @@
  * @author AMM
  */
 #include <unistd.h>
+#include <stddef.h>
 #include <fcntl.h>
 #include <search.h>
 #include <sys/stat.h>
@@ -1210,6 +1211,136 @@ int amm_handle_dma_req(veos_thread_arg_t *pti)
 	else
 		VEOS_DEBUG("DMA transfer done (pid %d)", pid);
 
+send_ack:
+	if (pti->fast_req) {
+		ret = psm_pseudo_send_fast_ack(pti, ret, NULL, 0);
+		goto hndl_error;
+	}
+
+	ve_dma_req_ack.has_syscall_retval = true;
+	ve_dma_req_ack.syscall_retval = ret;
+
+	pseudo_msg_len = pseudo_veos_message__get_packed_size(&ve_dma_req_ack);
+
+	msg_len = pseudo_veos_message__pack(&ve_dma_req_ack, (uint8_t *)ack);
+	if (msg_len != pseudo_msg_len) {
+		VEOS_DEBUG("packing protobuf msg error (expected length: %ld returned length: %ld)",
+				pseudo_msg_len, msg_len);
+		ret = -1;
+		goto hndl_error;
+	}
+	ret = psm_pseudo_send_cmd(sd, ack, pseudo_msg_len);
+	if (ret < pseudo_msg_len) {
+		VEOS_DEBUG("error while sending ack (expected bytes: %ld Transferred bytes: %d)",
+				pseudo_msg_len, ret);
+		ret = -1;
+	}
+
+hndl_error:
+	if (tsk)
+		put_ve_task_struct(tsk);
+	VEOS_TRACE("returned");
+	return ret;
+}
+
+/**
+* @brief This is request interface for vectored dma memory.
+*
+*	All segments of the request are transferred with one DMA request
+*	list, so the pseudo process pays one round trip and one DMA
+*	completion for a whole scatter/gather list.
+*
+* @param[in] pti containing REQ info.
+*
+* @return On Success return 0 and -1 on failure.
+*/
+int amm_handle_dma_vec_req(veos_thread_arg_t *pti)
+{
+	int ret = 0;
+	int64_t length = -1;
+	uint64_t idx = 0;
+	size_t size = 0;
+	int sd = pti->socket_descriptor;
+	struct ve_task_struct *tsk = NULL;
+	char ack[MAX_PROTO_MSG_SIZE] = {0};
+	ssize_t pseudo_msg_len = -1, msg_len = -1;
+	struct dma_vec_args dma_param = {0};
+	ve_dma_seg_t seg[DMA_VEC_MAX_SEG];
+	pid_t pid = -1;
+
+	VEOS_TRACE("invoked thread arg pti(%p)", pti);
+	PseudoVeosMessage ve_dma_req_ack = PSEUDO_VEOS_MESSAGE__INIT;
+
+	pid = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->pseudo_pid;
+
+	length = (((PseudoVeosMessage *)(pti->pseudo_proc_msg))->
+			pseudo_msg).len;
+	if ((length < (int64_t)offsetof(struct dma_vec_args, seg)) ||
+			(length > (int64_t)sizeof(struct dma_vec_args))) {
+		VEOS_DEBUG("Invalid message length %ld", length);
+		ret = -EINVAL;
+		goto send_ack;
+	}
+	memcpy(&dma_param,
+			(((PseudoVeosMessage *)(pti->pseudo_proc_msg))->
+			 pseudo_msg).data,
+			length);
+
+	if ((dma_param.nseg == 0) || (dma_param.nseg > DMA_VEC_MAX_SEG) ||
+			(length != (int64_t)(offsetof(struct dma_vec_args, seg) +
+			dma_param.nseg * sizeof(struct dma_vec_seg)))) {
+		VEOS_DEBUG("Invalid number of segments %lu (length %ld)",
+				dma_param.nseg, length);
+		ret = -EINVAL;
+		goto send_ack;
+	}
+
+	VEOS_DEBUG("DMA.SRCTYPE : %d, DMA.DSTTYPE : %d, DMA.NSEG : %lu",
+			dma_param.srctype, dma_param.dsttype, dma_param.nseg);
+
+	/* Only transfer between VE memory and pseudo process is allowed */
+	if (!((dma_param.srctype == VE_DMA_VHVA &&
+			dma_param.dsttype == VE_DMA_VEMVA) ||
+			(dma_param.srctype == VE_DMA_VEMVA &&
+			dma_param.dsttype == VE_DMA_VHVA))) {
+		ret = -EINVAL;
+		goto send_ack;
+	}
+
+	tsk = find_ve_task_struct(pid);
+	if (NULL == tsk) {
+		ret = -ESRCH;
+		VEOS_DEBUG("Error (%s) while getting task structure for pid %d",
+				strerror(-ret), pid);
+		goto send_ack;
+	}
+
+	pthread_mutex_lock_unlock(&tsk->p_ve_mm->thread_group_mm_lock,
+			LOCK, "Failed to acquire mm-thread-group-lock");
+	for (idx = 0; idx < dma_param.nseg; idx++) {
+		seg[idx].srcaddr = dma_param.seg[idx].srcaddr;
+		seg[idx].dstaddr = dma_param.seg[idx].dstaddr;
+		seg[idx].length = dma_param.seg[idx].size;
+
+		/*Check if VHVA of this segment is mapped with a file*/
+		size = is_addr_file_backed((dma_param.srctype == VE_DMA_VHVA) ?
+				seg[idx].srcaddr : seg[idx].dstaddr, tsk);
+		if (!size)
+			VEOS_DEBUG("segment %lu is not file backed", idx);
+		else if (seg[idx].length > size)
+			seg[idx].length = size;
+	}
+	pthread_mutex_lock_unlock(&tsk->p_ve_mm->thread_group_mm_lock,
+			UNLOCK, "Failed to release mm-thread-group-lock");
+
+	ret = amm_dma_xfer_vec(dma_param.srctype, pid, dma_param.dsttype, pid,
+			seg, dma_param.nseg, tsk->node_id);
+	if (0 > ret) {
+		VEOS_ERROR("error while vectored DMA transfer (pid:%d)", pid);
+		ret = -EFAULT;
+	} else
+		VEOS_DEBUG("vectored DMA transfer done (pid %d)", pid);
+
 send_ack:
 	ve_dma_req_ack.has_syscall_retval = true;
 	ve_dma_req_ack.syscall_retval = ret;
@@ -1247,7 +1378,7 @@ hndl_error:
 */
 int amm_handle_process_vm_rw_req(veos_thread_arg_t *pti)
 {
-	int ret = 0;
+	int64_t ret = 0;
 	int length = -1;
 	int sd = pti->socket_descriptor;
 	struct ve_task_struct *tsk = NULL;
@@ -1264,7 +1395,7 @@ int amm_handle_process_vm_rw_req(veos_thread_arg_t *pti)
 
 	length = (((PseudoVeosMessage *)(pti->pseudo_proc_msg))->
 			pseudo_msg).len;
-	if (length <= 0) {
+	if (length != sizeof(struct ve_process_rw_info)) {
 		VEOS_DEBUG("Invalid message length %d", length);
 		ret = -EINVAL;
 		goto send_ack;
@@ -1286,14 +1417,11 @@ int amm_handle_process_vm_rw_req(veos_thread_arg_t *pti)
 				strerror(-ret), pid);
 		goto send_ack;
 	}
-	VEOS_DEBUG("base_rvemva = 0x%lx, r_len = 0x%lx, len = %ld"
-			" lcov_offeset = 0x%lx, rcov_offest = 0x%lx"
-			" remote_vemva = 0x%lx local_vemva = 0x%lx"
-			"vm_rw = %d",
-			ve_process_rw_info.base_rvemva, ve_process_rw_info.r_len,
-			ve_process_rw_info.len, ve_process_rw_info.lcov_offset,
-			ve_process_rw_info.rcov_offest, ve_process_rw_info.remote_vemva,
-			ve_process_rw_info.local_vemva,
+	VEOS_DEBUG("r_pid = %d, local_iov = 0x%lx, liovcnt = %ld"
+			" remote_iov = 0x%lx, riovcnt = %ld vm_rw = %d",
+			ve_process_rw_info.r_pid,
+			ve_process_rw_info.local_iov, ve_process_rw_info.liovcnt,
+			ve_process_rw_info.remote_iov, ve_process_rw_info.riovcnt,
 			ve_process_rw_info.vm_rw);
 
 	/* Get the information of /proc/## for the given remote pid */
@@ -1324,7 +1452,7 @@ int amm_handle_process_vm_rw_req(veos_thread_arg_t *pti)
 
 ok:
 
-	ret = amm_do_processs_vm_rw(tsk, ve_process_rw_info);
+	ret = amm_do_processs_vm_rw(tsk, &ve_process_rw_info);
 	if (0 > ret)
 		VEOS_ERROR("error while transferring date between process address space (pid %d)", pid);
 	else
@@ -1346,7 +1474,7 @@ send_ack:
 	}
 	ret = psm_pseudo_send_cmd(sd, ack, pseudo_msg_len);
 	if (ret < pseudo_msg_len) {
-		VEOS_DEBUG("error while sending ack (expected bytes: %ld Transferred bytes: %d)",
+		VEOS_DEBUG("error while sending ack (expected bytes: %ld Transferred bytes: %ld)",
 				pseudo_msg_len, ret);
 		ret = -1;
 	}
@@ -33,6 +33,7 @@
 #include "veos.h"
 #include "buddy.h"
 #include "pmap.h"
+#include "ve_migrate.h"
 
 /*
    Supported Vmflags
@@ -256,7 +257,7 @@ error:
 int veos_meminfo(struct velib_meminfo *mem_info)
 {
 	struct ve_node_struct *vnode = VE_NODE(0);
-	uint64_t i, count = 0;
+	uint64_t i, count = 0, cached = 0;
 	int ret = 0;
 
 	VEOS_TRACE("invoked with meminfo %p", mem_info);
@@ -270,17 +271,24 @@ int veos_meminfo(struct velib_meminfo *mem_info)
 	/* Total VE memory in Bytes */
 	mem_info->kb_main_total = (vnode->mem).ve_mem_size;
 
+	/* Pages held by page caches are counted as free */
+	cached = vnode->cached_pg_num_2M +
+		(HUGE_PAGE_IDX * vnode->cached_pg_num_64M);
+
 	/* Total VE memory used in Bytes */
 	mem_info->kb_main_used = (vnode->mp->small_page_used +
-		(HUGE_PAGE_IDX * vnode->mp->huge_page_used)) * PAGE_SIZE_2MB;
+		(HUGE_PAGE_IDX * vnode->mp->huge_page_used) - cached)
+		* PAGE_SIZE_2MB;
 
 	/* Total VE memory free in Bytes*/
 	mem_info->kb_main_free = (vnode->mp->total_pages -
 			(vnode->mp->small_page_used +
-		(HUGE_PAGE_IDX * vnode->mp->huge_page_used))) * PAGE_SIZE_2MB;
+		(HUGE_PAGE_IDX * vnode->mp->huge_page_used)) + cached)
+		* PAGE_SIZE_2MB;
 
 	/*Total VE memory used by HUGEPAGE in Bytes*/
-	mem_info->kb_hugepage_used = (vnode->mp->huge_page_used * PAGE_SIZE_64MB);
+	mem_info->kb_hugepage_used = ((vnode->mp->huge_page_used -
+			vnode->cached_pg_num_64M) * PAGE_SIZE_64MB);
 
 
 	for (i = 0; i < vnode->nr_pages; i++) {
@@ -298,6 +306,55 @@ error:
 	return ret;
 }
 
+/**
+* @brief Function will populate the field of struct velib_mempool_info.
+*
+* @param[out] pool Pointer to struct velib_mempool_info.
+*
+* @return 0 on success, negative of errno on failure.
+*/
+int veos_mempool_info(struct velib_mempool_info *pool)
+{
+	struct ve_node_struct *vnode = VE_NODE(0);
+	struct ve_migrate_stat mig_stat;
+	uint64_t cached = 0;
+
+	VEOS_TRACE("invoked with pool %p", pool);
+
+	if (NULL == pool) {
+		VEOS_DEBUG("Invalid input argument");
+		return -EINVAL;
+	}
+
+	/* Free VE memory which is dirty or cleared (ready) in Bytes.
+	 * Pages in buddy allocator and page caches are always cleared. */
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Fail to acquire ve page lock");
+	cached = vnode->cached_pg_num_2M +
+		(HUGE_PAGE_IDX * vnode->cached_pg_num_64M);
+	pool->kb_dirty = vnode->dirty_pg_num_2M * PAGE_SIZE_2MB
+		+ vnode->dirty_pg_num_64M * PAGE_SIZE_64MB;
+	pool->kb_ready_large = calc_free_sz(vnode->mp, PG_2M);
+	pool->kb_ready_large += cached * PAGE_SIZE_2MB;
+	pool->kb_ready_huge = calc_free_sz(vnode->mp, PG_HP)
+		+ vnode->cached_pg_num_64M * PAGE_SIZE_64MB;
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Fail to release ve page lock");
+
+	/* Per mille of ready memory which can not be used as 64MB pages */
+	if (pool->kb_ready_large)
+		pool->frag_index = ((pool->kb_ready_large -
+			pool->kb_ready_huge) * 1000) / pool->kb_ready_large;
+	else
+		pool->frag_index = 0;
+
+	amm_migrate_get_stat(&mig_stat);
+	pool->nr_compacted = mig_stat.nr_compacted;
+
+	VEOS_TRACE("returned");
+	return 0;
+}
+
 /**
 * @brief Function will populate the max rss field of struct ve_rusage.
 *
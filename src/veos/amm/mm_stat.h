@@ -35,6 +35,7 @@ void veos_sysinfo(int node_id, struct sysinfo *val);
 int veos_pidstat_info(int, struct velib_pidstat *);
 int veos_pidstatm_info(int, struct velib_pidstatm *);
 int veos_meminfo(struct velib_meminfo *);
+int veos_mempool_info(struct velib_mempool_info *);
 int veos_getrusage(int who, struct ve_rusage *ve_r,
 		struct ve_task_struct *tsk);
 int veos_pmap(int pid, struct ve_mapheader *);
@@ -365,6 +365,8 @@ int64_t veos_get_vhsaa_pciatb(vemaa_t vemaa, pid_t pid)
 
 /**
 * @brief This function will set pci entries.
+*	Pages are checked before any of them is pinned, and entries which map
+*	the same VE page are pinned as a run with one ref count update.
 * @param[in] start_entry Start entry number.
 * @param[in] count Number entries to be set.
 * @param[in] page_base array of page base to be set int entry.
@@ -375,31 +377,47 @@ int alloc_pcientry(uint64_t start_entry,
 		uint64_t count, uint64_t *page_base)
 {
 	int idx = 0, entry_cnt = 0;
+	uint64_t nr = 0;
 	struct ve_node_struct *vnode_info = VE_NODE(0);
+	struct ve_page *page = NULL;
 	int ret = 0;
 
 	VEOS_TRACE("invoked with start_entry(0x%lx) count(%ld) page_base(%p)",
 			start_entry, count, page_base);
 
+	/* Check all pages at first, so that a failure leaves no reference */
+	for (entry_cnt = 0; entry_cnt < count; entry_cnt++) {
+		if (NULL == VE_PAGE(vnode_info,
+				pfnum(page_base[entry_cnt], PG_2M))) {
+			ret = -EINVAL;
+			VEOS_DEBUG("Error(%s) VE page 0x%lx is not allocated",
+				strerror(-ret), page_base[entry_cnt]);
+			return ret;
+		}
+	}
+
 	pthread_mutex_lock_unlock(&vnode_info->pciatb_lock, LOCK,
 			"Failed to acquire pci lock");
 
-	for (idx = start_entry; idx <
-			(start_entry + count); idx++, entry_cnt++) {
-		vnode_info->pciatb[idx].data =
-			page_base[entry_cnt] & PCIATB_PAGE_BASE_MASK;
-		VEOS_DEBUG("Setting PCIATB[%d] with PAGE_BASE (0x%lx)",
-			idx, vnode_info->pciatb[idx].data);
+	for (entry_cnt = 0; entry_cnt < count; entry_cnt += nr) {
+		/* A run is entries which map the same VE page */
+		page = VE_PAGE(vnode_info, pfnum(page_base[entry_cnt], PG_2M));
+		for (nr = 0; (entry_cnt + nr) < count; nr++) {
+			if (page != VE_PAGE(vnode_info,
+				pfnum(page_base[entry_cnt + nr], PG_2M)))
+				break;
+			idx = start_entry + entry_cnt + nr;
+			vnode_info->pciatb[idx].data =
+				page_base[entry_cnt + nr] & PCIATB_PAGE_BASE_MASK;
+			VEOS_DEBUG("Setting PCIATB[%d] with PAGE_BASE (0x%lx)",
+				idx, vnode_info->pciatb[idx].data);
+		}
 		/*Increament ref count*/
-
-		ret = common_get_put_page(page_base[entry_cnt],
-				GET_PAGE, true);
+		ret = common_get_page_nr(page_base[entry_cnt], nr, true);
 		if (ret < 0) {
 			VEOS_DEBUG("Error(%s) to inc ref count",
 				strerror(-ret));
-			pthread_mutex_lock_unlock(&vnode_info->pciatb_lock, UNLOCK,
-					"Failed to release pci lock");
-			return ret;
+			goto rollback;
 		}
 	}
 
@@ -410,6 +428,18 @@ int alloc_pcientry(uint64_t start_entry,
 			"Failed to release pci lock");
 	VEOS_TRACE("returned(%d)", entry_cnt);
 	return entry_cnt;
+
+rollback:
+	/* Drop references of pinned runs and clear s/w image */
+	for (idx = 0; idx < (entry_cnt + nr); idx++) {
+		vnode_info->pciatb[start_entry + idx].data = INVALID_ENTRY;
+		if (idx < entry_cnt)
+			common_get_put_page(page_base[idx], PUT_PAGE, true);
+	}
+	pthread_mutex_lock_unlock(&vnode_info->pciatb_lock, UNLOCK,
+			"Failed to release pci lock");
+	VEOS_TRACE("returned(%d)", ret);
+	return ret;
 }
 /**
 * @brief This function will free the allocated PCI entries
@@ -451,6 +481,43 @@ int veos_free_pcientry(uint64_t start_entry, uint64_t size)
 	return 0;
 }
 
+/**
+* @brief This function will free a run of allocated PCI entries.
+*	The run is returned to the buddy allocator as the largest aligned
+*	blocks which fit in it, instead of entry by entry.
+*	Caller must hold buddy_mempool_lock of pci_mempool.
+*
+* @param[in] start_entry First entry number of the run.
+* @param[in] entry_cnt Number of entries of the run.
+*
+* @return return 0 on success and negative of errno on failure.
+*/
+int veos_free_pcientry_run(uint64_t start_entry, uint64_t entry_cnt)
+{
+	struct ve_node_struct *vnode_info = VE_NODE(0);
+	uint64_t idx = start_entry, end = start_entry + entry_cnt;
+	uint64_t blk_cnt = 0;
+	int ret = 0;
+
+	VEOS_TRACE("invoked with start_entry(%ld) entry_cnt(%ld)",
+		start_entry, entry_cnt);
+
+	while (idx < end) {
+		/* Largest block which is aligned at idx */
+		blk_cnt = idx ? (idx & (~idx + 1)) : ((uint64_t)1 << 63);
+		while (blk_cnt > (end - idx))
+			blk_cnt >>= 1;
+		ret = veos_free_pcientry(idx,
+			blk_cnt * vnode_info->pci_bar01_pgsz);
+		if (ret < 0)
+			return ret;
+		idx += blk_cnt;
+	}
+
+	VEOS_TRACE("returned(0)");
+	return 0;
+}
+
 /**
 * @brief This function will check whether allocation is possible or not.
 *
@@ -519,7 +586,6 @@ int free_unused_entry(uint64_t start_entry,
 {
 	struct ve_node_struct *vnode = VE_NODE(0);
 	uint64_t total_entry = 0, req_entry = 0, extra_entry = 0;
-	uint64_t idx = 0;
 	int ret = 0;
 
 	VEOS_TRACE("invoked to free unused entry with "
@@ -537,16 +603,14 @@ int free_unused_entry(uint64_t start_entry,
 	pthread_mutex_lock_unlock(&vnode->pci_mempool->buddy_mempool_lock,
 			LOCK, "Failed to acquire pci buddy lock");
 	if (extra_entry) {
-		for (idx = (start_entry + req_entry);
-				idx < (start_entry + total_entry); idx++) {
-			ret = veos_free_pcientry(idx, vnode->pci_bar01_pgsz);
-			if (ret < 0) {
-				VEOS_DEBUG("Error(%s) in freeing pciatb entry(%ld)",
-					strerror(-ret), idx);
-				pthread_mutex_lock_unlock(&vnode->pci_mempool->buddy_mempool_lock,
-						UNLOCK, "Failed to release pci buddy lock");
-				return ret;
-			}
+		ret = veos_free_pcientry_run(start_entry + req_entry,
+				extra_entry);
+		if (ret < 0) {
+			VEOS_DEBUG("Error(%s) in freeing pciatb entry(%ld)",
+				strerror(-ret), start_entry + req_entry);
+			pthread_mutex_lock_unlock(&vnode->pci_mempool->buddy_mempool_lock,
+					UNLOCK, "Failed to release pci buddy lock");
+			return ret;
 		}
 		VEOS_DEBUG("PCIATB(%ld)extra entries are freed", extra_entry);
 	} else {
@@ -1118,7 +1182,7 @@ pci_failed:
  */
 int64_t veos_delete_pciatb(uint64_t entry, size_t size)
 {
-	uint64_t entry_cnt = 0, idx = 0;
+	uint64_t entry_cnt = 0, idx = 0, run_start = 0, end = 0;
 	uint64_t page_base = -1;
 	size_t pci_pgsize = -1;
 	struct ve_node_struct *vnode_info = VE_NODE(0);
@@ -1148,52 +1212,62 @@ int64_t veos_delete_pciatb(uint64_t entry, size_t size)
 		entry_cnt = size >> HUGE_PSHFT;
 
 
+	/* First check whether entries are in range */
+	if ((entry + entry_cnt - 1) > vnode_info->pci_mempool->total_pages) {
+		ret = -EINVAL;
+		VEOS_DEBUG("Error(%s)invalid pciatb entry",
+				strerror(-ret));
+		return ret;
+	}
+
 	pthread_mutex_lock_unlock(&vnode_info->pciatb_lock, LOCK,
 			"Failed to acquire pci lock");
-	/* Calculate the page bage from PCI
-	 * entry and decrement the ref count*/
-	for (idx = entry; idx < (entry + entry_cnt); idx++) {
-		/* First check whether entries
-		 * is already allocated or not*/
-		if (idx > vnode_info->pci_mempool->total_pages) {
-			ret = -EINVAL;
-			VEOS_DEBUG("Error(%s)invalid pciatb entry",
-					strerror(ret));
-			pthread_mutex_lock_unlock(&vnode_info->pciatb_lock,
-					UNLOCK,	"Failed to release pci lock");
-			return ret;
-		}
-		if (vnode_info->pciatb[idx].data == INVALID_ENTRY) {
-			VEOS_DEBUG("Entry :%ld is Invalid", idx);
-			continue;
-		}
-		/*Decreament the ref count of VE page*/
-		page_base = GET_PCIATB_PB(&vnode_info->pciatb[idx]);
-		/*Invalidating pci s/w entry*/
-		vnode_info->pciatb[idx].data = INVALID_ENTRY;
-		ret = amm_put_page(page_base * PAGE_SIZE_2MB);
-		if (ret < 0) {
-			VEOS_DEBUG("Error(%s) in inc ref count",
+	/* Calculate the page bage from PCI entry and decrement the ref
+	 * count. Valid entries are freed as a run at a time. */
+	run_start = entry;
+	end = entry + entry_cnt;
+	for (idx = entry; idx <= end; idx++) {
+		if ((idx < end) &&
+			(vnode_info->pciatb[idx].data != INVALID_ENTRY)) {
+			/*Decreament the ref count of VE page*/
+			page_base = GET_PCIATB_PB(&vnode_info->pciatb[idx]);
+			/*Invalidating pci s/w entry*/
+			vnode_info->pciatb[idx].data = INVALID_ENTRY;
+			ret = amm_put_page(page_base * PAGE_SIZE_2MB);
+			if (ret >= 0)
+				continue;
+			VEOS_DEBUG("Error(%s) in dec ref count",
 					strerror(-ret));
-			pthread_mutex_lock_unlock(&vnode_info->pciatb_lock,
-					UNLOCK,	"Failed to release pci lock");
-			return ret;
+			/* Free the run before this entry and stop */
+			end = idx;
+		} else if (idx < end) {
+			VEOS_DEBUG("Entry :%ld is Invalid", idx);
 		}
-		/*free the perticuler entry*/
-		pthread_mutex_lock_unlock(&vnode_info->pci_mempool->buddy_mempool_lock,
-				LOCK, "Failed to acquire pci buddy lock");
-		ret = veos_free_pcientry(idx, vnode_info->pci_bar01_pgsz);
-		if (ret < 0) {
+
+		/*free the run of entries*/
+		if (idx > run_start) {
+			pthread_mutex_lock_unlock(&vnode_info->pci_mempool->buddy_mempool_lock,
+					LOCK, "Failed to acquire pci buddy lock");
+			if (0 > veos_free_pcientry_run(run_start, idx - run_start)) {
+				pthread_mutex_lock_unlock(&vnode_info->pci_mempool->
+						buddy_mempool_lock, UNLOCK,
+						"Failed to release pci buddy lock");
+				veos_abort("pci buddy mempool inconsistent due to calloc failure");
+			}
 			pthread_mutex_lock_unlock(&vnode_info->pci_mempool->
 					buddy_mempool_lock, UNLOCK,
 					"Failed to release pci buddy lock");
-			veos_abort("pci buddy mempool inconsistent due to calloc failure");
+			VEOS_TRACE("PCI Entries %ld-%ld has been free",
+					run_start, idx - 1);
 		}
+		run_start = idx + 1;
+	}
 
-		pthread_mutex_lock_unlock(&vnode_info->pci_mempool->
-				buddy_mempool_lock, UNLOCK,
-				"Failed to release pci buddy lock");
-		VEOS_TRACE("PCI Entries %ld has been free", idx);
+	if (ret < 0) {
+		veos_set_pciatb(vnode_info->pciatb, entry, end - entry + 1);
+		pthread_mutex_lock_unlock(&vnode_info->pciatb_lock,
+				UNLOCK,	"Failed to release pci lock");
+		return ret;
 	}
 
 	/*update H/w PCI entries*/
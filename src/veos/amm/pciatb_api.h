@@ -151,6 +151,7 @@ int pciatb_dump(void);
 int alloc__pcientry(uint64_t start_entry,
 		uint64_t count, uint64_t *page_base);
 int veos_free_pcientry(uint64_t start_entry, size_t size);
+int veos_free_pcientry_run(uint64_t, uint64_t);
 int mk_pci_pgent(uint64_t, uint64_t, struct ve_mm_struct *, size_t, int,
 			uint64_t *, uint64_t, bool);
 int free_unused_entry(uint64_t, size_t, size_t);
@@ -24,9 +24,11 @@
  * @author AMM
  */
 #include <unistd.h>
+#include <sched.h>
 #include <sys/mman.h>
 #include "ve_shm.h"
 #include "ve_mem.h"
+#include "ve_migrate.h"
 #include "mm_common.h"
 #include "veos.h"
 #include "libved.h"
@@ -419,6 +421,8 @@ void veos_amm_fini(void)
 		VEOS_DEBUG("no dump information available");
 		return;
 	}
+	amm_fini_page_cache(vnode);
+
 	veos_delloc_memory(vnode->zeroed_pfn, PG_HP);
 	--vnode->mp->huge_page_used;
 
@@ -692,6 +696,22 @@ int veos_amm_init(vedl_handle *handle)
 		goto error;
 	}
 
+	/*Initialise free page caches*/
+	ret = amm_init_page_cache(vnode);
+	if (0 > ret) {
+		VEOS_DEBUG("Error (%s) in initializing page caches",
+			strerror(-ret));
+		goto error;
+	}
+
+	/*Create thread of page migration*/
+	ret = amm_migrate_init();
+	if (0 > ret) {
+		VEOS_DEBUG("Error (%s) in initializing page migration",
+			strerror(-ret));
+		goto error;
+	}
+
 	/*Allocate pcientry for VDSO page*/
 	ret = veos_alloc_vdso_pcientry(0, 1);
 	if (0 > ret) {
@@ -1451,6 +1471,279 @@ mprot_error:
 
 }
 
+/**
+* @brief This function initializes free VE page caches.
+*	One cache is created per host CPU, up to PG_CACHE_NUM.
+*
+* @param[in] vnode VE node struct.
+*
+* @return On success returns 0 and negative of errno on failure.
+*/
+int amm_init_page_cache(struct ve_node_struct *vnode)
+{
+	int idx = 0;
+	long nr_cpu = 0;
+
+	VEOS_TRACE("invoked");
+
+	nr_cpu = sysconf(_SC_NPROCESSORS_CONF);
+	if (nr_cpu <= 0)
+		nr_cpu = 1;
+	vnode->nr_pg_cache = (nr_cpu < PG_CACHE_NUM) ? nr_cpu : PG_CACHE_NUM;
+
+	vnode->pg_cache = calloc(vnode->nr_pg_cache,
+			sizeof(struct ve_page_cache));
+	if (NULL == vnode->pg_cache) {
+		VEOS_CRIT("calloc error while allocating page caches");
+		vnode->nr_pg_cache = 0;
+		return -ENOMEM;
+	}
+	for (idx = 0; idx < vnode->nr_pg_cache; idx++)
+		pthread_mutex_init(&vnode->pg_cache[idx].lock, NULL);
+	vnode->cached_pg_num_2M = 0;
+	vnode->cached_pg_num_64M = 0;
+
+	VEOS_DEBUG("%d free page caches initialized", vnode->nr_pg_cache);
+	VEOS_TRACE("returned");
+	return 0;
+}
+
+/**
+* @brief This function removes the ve_pages[] entry made for a cached page
+*	by amm_refill_page_cache().
+*	Caller must hold ve_pages_node_lock.
+*
+* @param[in] vnode VE node struct.
+* @param[in] pgno Page number of the cached page.
+* @param[in] pgmod Page mode of the cached page.
+*/
+static void amm_put_cached_page_entry(struct ve_node_struct *vnode,
+		pgno_t pgno, int pgmod)
+{
+	int idx = 0;
+
+	free(vnode->ve_pages[pgno]);
+	vnode->ve_pages[pgno] = NULL;
+	if (pgmod != PG_2M) {
+		for (idx = 1; idx < HUGE_PAGE_IDX; idx++)
+			vnode->ve_pages[pgno + idx] = NULL;
+	}
+}
+
+/**
+* @brief This function returns pages held by a page cache to buddy
+*	allocator.
+*	Caller must hold cache lock and must not hold ve_pages_node_lock.
+*
+* @param[in] vnode VE node struct.
+* @param[in] cache Page cache to be drained.
+*
+* @return Number of drained pages.
+*/
+static int __amm_drain_page_cache(struct ve_node_struct *vnode,
+		struct ve_page_cache *cache)
+{
+	int cnt = 0;
+
+	if (!cache->nr_2m && !cache->nr_64m)
+		return 0;
+
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	while (cache->nr_2m) {
+		amm_put_cached_page_entry(vnode, cache->pg_2m[--cache->nr_2m],
+				PG_2M);
+		veos_delloc_memory(cache->pg_2m[cache->nr_2m], PG_2M);
+		--vnode->mp->small_page_used;
+		__sync_fetch_and_sub(&vnode->cached_pg_num_2M, 1);
+		cnt++;
+	}
+	while (cache->nr_64m) {
+		amm_put_cached_page_entry(vnode,
+				cache->pg_64m[--cache->nr_64m], PG_HP);
+		veos_delloc_memory(cache->pg_64m[cache->nr_64m], PG_HP);
+		--vnode->mp->huge_page_used;
+		__sync_fetch_and_sub(&vnode->cached_pg_num_64M, 1);
+		cnt++;
+	}
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+	return cnt;
+}
+
+/**
+* @brief This function returns pages held by all page caches to buddy
+*	allocator. It is called when buddy allocator runs short of memory.
+*	Caller must not hold ve_pages_node_lock.
+*
+* @return Number of drained pages.
+*/
+int amm_drain_page_cache(void)
+{
+	int idx = 0, cnt = 0;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	VEOS_TRACE("invoked");
+
+	for (idx = 0; idx < vnode->nr_pg_cache; idx++) {
+		pthread_mutex_lock_unlock(&vnode->pg_cache[idx].lock, LOCK,
+				"Failed to acquire page cache lock");
+		cnt += __amm_drain_page_cache(vnode, &vnode->pg_cache[idx]);
+		pthread_mutex_lock_unlock(&vnode->pg_cache[idx].lock, UNLOCK,
+				"Failed to release page cache lock");
+	}
+
+	VEOS_DEBUG("%d pages drained from page caches", cnt);
+	VEOS_TRACE("returned");
+	return cnt;
+}
+
+/**
+* @brief This function drains and frees all page caches.
+*
+* @param[in] vnode VE node struct.
+*/
+void amm_fini_page_cache(struct ve_node_struct *vnode)
+{
+	int idx = 0;
+
+	if (NULL == vnode->pg_cache)
+		return;
+
+	amm_drain_page_cache();
+	for (idx = 0; idx < vnode->nr_pg_cache; idx++)
+		pthread_mutex_destroy(&vnode->pg_cache[idx].lock);
+	free(vnode->pg_cache);
+	vnode->pg_cache = NULL;
+	vnode->nr_pg_cache = 0;
+}
+
+/**
+* @brief This function refills a page cache from buddy allocator.
+*	The ve_pages[] entry of each page is made here under
+*	ve_pages_node_lock, so that taking a page from the cache needs only
+*	the cache lock. A cached page has ref_count 0 and is not mapped by
+*	any process.
+*	Caller must hold cache lock and must not hold ve_pages_node_lock.
+*
+* @param[in] vnode VE node struct.
+* @param[in] cache Page cache to be refilled.
+* @param[in] pgmod Page mode of pages to be refilled.
+*
+* @return Number of pages taken from buddy allocator.
+*/
+static int amm_refill_page_cache(struct ve_node_struct *vnode,
+		struct ve_page_cache *cache, int pgmod)
+{
+	int cnt = 0, batch = 0, order = 0, idx = 0;
+	int *nr = NULL;
+	pgno_t pgno = 0, *pgs = NULL;
+	void *vemaa = NULL;
+
+	if (pgmod == PG_2M) {
+		nr = &cache->nr_2m;
+		pgs = cache->pg_2m;
+		batch = PG_CACHE_BATCH_2M;
+		order = size_to_order(PAGE_SIZE_2MB);
+	} else {
+		nr = &cache->nr_64m;
+		pgs = cache->pg_64m;
+		batch = PG_CACHE_BATCH_64M;
+		order = size_to_order(PAGE_SIZE_64MB);
+	}
+
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	while (*nr < batch && !terminate_flag) {
+		vemaa = buddy_alloc(vnode->mp, order);
+		if (BUDDY_FAILED == vemaa)
+			break;
+		pgno = (pgno_t)((uint64_t)vemaa >> PSSHFT);
+		/* Head entry of huge page is set before its tail entries */
+		if (0 > __page_entry(vnode->mp, pgno, pgmod, order)) {
+			veos_delloc_memory(pgno, pgmod);
+			break;
+		}
+		if (pgmod != PG_2M) {
+			for (idx = 1; idx < HUGE_PAGE_IDX; idx++)
+				vnode->ve_pages[pgno + idx] =
+					(struct ve_page *)-1;
+		}
+		pgs[(*nr)++] = pgno;
+		if (pgmod == PG_2M) {
+			++vnode->mp->small_page_used;
+			__sync_fetch_and_add(&vnode->cached_pg_num_2M, 1);
+		} else {
+			++vnode->mp->huge_page_used;
+			__sync_fetch_and_add(&vnode->cached_pg_num_64M, 1);
+		}
+		cnt++;
+	}
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+
+	VEOS_DEBUG("%d %s taken from buddy to page cache",
+			cnt, pgmod_to_pgstr(pgmod));
+	return cnt;
+}
+
+/**
+* @brief This function allocates a VE physical page from the page cache
+*	of host CPU on which the caller runs.
+*	The cache is refilled from buddy allocator when it is empty. The
+*	ve_pages[] entry of a cached page is already made, so a cache hit
+*	takes only the cache lock.
+*
+* @param[out] map Holds page number that is allocated.
+* @param[in] pgmod page mode for the memory allocation.
+*
+* @return On success returns 0, -ENOMEM if the cache can not be refilled.
+*/
+static int amm_alloc_cached_page(pgno_t *map, int pgmod)
+{
+	int cpu = 0;
+	int *nr = NULL;
+	pgno_t pgno = 0, *pgs = NULL;
+	struct ve_page_cache *cache = NULL;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	if (!vnode->nr_pg_cache)
+		return -ENOMEM;
+
+	cpu = sched_getcpu();
+	if (cpu < 0)
+		cpu = 0;
+	cache = &vnode->pg_cache[cpu % vnode->nr_pg_cache];
+
+	if (pgmod == PG_2M) {
+		nr = &cache->nr_2m;
+		pgs = cache->pg_2m;
+	} else {
+		nr = &cache->nr_64m;
+		pgs = cache->pg_64m;
+	}
+
+	pthread_mutex_lock_unlock(&cache->lock, LOCK,
+			"Failed to acquire page cache lock");
+	if (!*nr && !amm_refill_page_cache(vnode, cache, pgmod)) {
+		pthread_mutex_lock_unlock(&cache->lock, UNLOCK,
+				"Failed to release page cache lock");
+		return -ENOMEM;
+	}
+	pgno = pgs[--(*nr)];
+	if (pgmod == PG_2M)
+		__sync_fetch_and_sub(&vnode->cached_pg_num_2M, 1);
+	else
+		__sync_fetch_and_sub(&vnode->cached_pg_num_64M, 1);
+	pthread_mutex_lock_unlock(&cache->lock, UNLOCK,
+			"Failed to release page cache lock");
+
+	map[0] = pgno;
+	VEOS_DEBUG("Allocated %s %ld from page cache %d",
+			pgmod_to_pgstr(pgmod), pgno, cpu % vnode->nr_pg_cache);
+	return 0;
+}
+
 /**
 * @brief This function will allocated VE physical pages according to count.
 *
@@ -1466,7 +1759,8 @@ int alloc_ve_pages(uint64_t count, pgno_t *map, int pgmod)
 	size_t mem_sz = 0;
 	struct block *curr_blk = NULL, *tmp_blk = NULL;
 	struct ve_node_struct *vnode = VE_NODE(0);
-	int is_wait = 0;
+	int is_wait = 0, drained = 0, sync_empty = 0;
+	size_t shortage = 0, sync_cleared = 0, cleared = 0;
 
 	VEOS_TRACE("invoked");
 	VEOS_DEBUG("allocate %lu %s to map(%p)",
@@ -1481,6 +1775,13 @@ int alloc_ve_pages(uint64_t count, pgno_t *map, int pgmod)
 	VEOS_DEBUG("allocating %lx size VE memory",
 			mem_sz);
 
+	/* Single page is taken from page cache if possible */
+	if (count == 1) {
+		ret = amm_alloc_cached_page(map, pgmod);
+		if (ret != -ENOMEM)
+			return ret;
+	}
+
 	/*Get buddy lock here*/
 	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
 			"Failed to acquire ve_page lock");
@@ -1513,6 +1814,19 @@ int alloc_ve_pages(uint64_t count, pgno_t *map, int pgmod)
 			/*returning allocated block to buddy mempool*/
 			buddy_free(vnode->mp, curr_blk);
 		}
+		/* Return pages held by page caches and retry */
+		if (!drained) {
+			drained = 1;
+			pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock,
+					UNLOCK,
+					"Failed to release ve_page lock");
+			cleared = amm_drain_page_cache();
+			pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock,
+					LOCK,
+					"Failed to acquire ve_page lock");
+			if (cleared)
+				continue;
+		}
 		for (;;) {
 			is_wait = calc_usable_dirty_page(vnode, mem_sz, pgmod);
 			if (is_wait == 1)
@@ -1524,9 +1838,32 @@ int alloc_ve_pages(uint64_t count, pgno_t *map, int pgmod)
 						"Failed to release ve_page lock");
 				return ret;
 			}
+
+			/* If shortage is small, clear dirty pages on this
+			 * thread rather than waiting behind the others in
+			 * the dirty page list. */
+			shortage = mem_sz - calc_free_sz(vnode->mp, pgmod);
+			if (!sync_empty &&
+				(sync_cleared + shortage) <= SYNC_CLEAR_MAX) {
+				pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock,
+						UNLOCK,
+						"Failed to release ve_page lock");
+				cleared = amm_clear_dirty_page_sync(shortage);
+				pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock,
+						LOCK,
+						"Failed to acquire ve_page lock");
+				sync_cleared += cleared;
+				if (!cleared)
+					sync_empty = 1;
+				/* The clearing thread may have freed pages and
+				 * signaled pg_allc_cond while the lock was
+				 * released, so check the shortage again. */
+				continue;
+			}
 			VEOS_DEBUG("wait to clearing dirty page");
 			pthread_cond_wait(&vnode->pg_allc_cond,
 					&vnode->ve_pages_node_lock);
+			sync_empty = 0;
 		}
 	}
 
@@ -1802,6 +2139,53 @@ hndl_exit:
 	pthread_exit(NULL);
 }
 
+/**
+ * @brief This function clears dirty pages on the calling thread and
+ *	returns them to buddy allocator.
+ *	An allocation which is short of a little memory uses this instead of
+ *	waiting for the clearing thread.
+ *	Caller must not hold ve_pages_node_lock.
+ *
+ * @param[in] need Size of memory to be cleared.
+ *
+ * @return Size of cleared memory. 0 if dirty page list is empty.
+ */
+size_t amm_clear_dirty_page_sync(size_t need)
+{
+	pgno_t pgno;
+	int pgmod = 0;
+	size_t pgsz = 0, cleared = 0;
+	struct ve_dirty_pg_list *dirt_pg_head = NULL;
+
+	VEOS_TRACE("invoked to clear 0x%lx", need);
+
+	while (cleared < need) {
+		pthread_mutex_lock_unlock(&dirty_page.ve_dirty_pg_lock, LOCK,
+				"Failed to acquire dirty_page lock");
+		if (list_empty(&dirty_page.dirty_pg_list.head)) {
+			pthread_mutex_lock_unlock(&dirty_page.ve_dirty_pg_lock,
+					UNLOCK, "Failed to release dirty_page lock");
+			break;
+		}
+		dirt_pg_head = list_next_entry(&dirty_page.dirty_pg_list, head);
+		pgno = dirt_pg_head->pgno;
+		pgsz = dirt_pg_head->pgsz;
+		pgmod = dirt_pg_head->pgmod;
+		list_del(&dirt_pg_head->head);
+		free(dirt_pg_head);
+		pthread_mutex_lock_unlock(&dirty_page.ve_dirty_pg_lock, UNLOCK,
+				"Failed to release dirty_page lock");
+
+		VEOS_DEBUG("Cleaning dirty page synchronously: pgno=%ld, pgsz=%ld",
+			   pgno, pgsz);
+		clear_and_dealloc_page(pgno, pgsz, pgmod);
+		cleared += pgsz;
+	}
+
+	VEOS_TRACE("returned(0x%lx)", cleared);
+	return cleared;
+}
+
 /**
  * @brief This function will free the physical page and
  *	return freed page to buddy allocator.
@@ -1896,6 +2280,9 @@ uint64_t ve_node_page_used_count(int node_id)
 	 */
 	used_cnt =  ((vnode->mp->small_page_used +
 				(vnode->mp->huge_page_used * HUGE_PAGE_IDX)));
+	/* Pages held by page caches are not used */
+	used_cnt -= (vnode->cached_pg_num_2M +
+			(vnode->cached_pg_num_64M * HUGE_PAGE_IDX));
 
 	VEOS_DEBUG("total node pages in use %ld", used_cnt);
 
@@ -1924,7 +2311,9 @@ int  ve_node_page_free_count(int node_id)
 
 	free_cnt =  (vnode->mp->total_pages -
 			(vnode->mp->small_page_used +
-			 (vnode->mp->huge_page_used * HUGE_PAGE_IDX)));
+			 (vnode->mp->huge_page_used * HUGE_PAGE_IDX)) +
+			(vnode->cached_pg_num_2M +
+			 (vnode->cached_pg_num_64M * HUGE_PAGE_IDX)));
 
 	VEOS_DEBUG("Total free page :%d", free_cnt);
 
@@ -2001,6 +2390,152 @@ vp_ret:
 	return ret;
 }
 
+/**
+* @brief This function pins pages of VEMAA runs in bulk.
+*
+* @param[in] run runs of VE physical address to be pinned.
+* @param[in] nr_run number of runs.
+*
+* @return on success return 0 and negative of errno on failure.
+*
+* @note Pages are either all pinned or none of them is pinned.
+*/
+static int veos_get_page_runs(struct ve_phys_run *run, int nr_run)
+{
+	struct ve_node_struct *vnode = VE_NODE(0);
+	vemaa_t pb = 0;
+	size_t pgsz = 0;
+	int i = 0;
+	bool check = true;
+
+	/* First pass checks every page, second pass takes references */
+	while (1) {
+		for (i = 0; i < nr_run; i++) {
+			pgsz = pgmod_to_pgsz(run[i].pgmod);
+			for (pb = ROUN_DN(run[i].vemaa, pgsz);
+					pb < run[i].vemaa + run[i].size;
+					pb += pgsz) {
+				if (!check) {
+					common_get_put_page(pb, GET_PAGE,
+							false);
+				} else if (NULL == VE_PAGE(vnode,
+						pfnum(pb, PG_2M))) {
+					VEOS_DEBUG("VE page %ld is not "
+						"allocated", pfnum(pb, PG_2M));
+					return -EINVAL;
+				}
+			}
+		}
+		if (!check)
+			break;
+		check = false;
+	}
+	return 0;
+}
+
+/**
+* @brief This function will convert VE virtual address range into runs of
+* VE physical address.
+*
+*	The task is looked up and its ATB is walked in place only once for
+*	the whole range, instead of once per page as veos_virt_to_phy() does.
+*	Consecutive pages are merged in one run when they are physically
+*	contiguous and have same protection and page mode.
+*
+* @param[in] vaddr VE virtual address of start of range.
+* @param[in] size size of range in bytes.
+* @param[in] pid process pid.
+* @param[in] inc_ref this will indicate whether to increase ref count of
+*            all pages in range or not.
+* @param[out] run array to be filled with runs of VE physical address.
+* @param[in] nr_run number of entries in run.
+*
+* @return on success return number of runs filled and negative of errno
+* on failure.
+*/
+int veos_virt_to_phy_range(vemva_t vaddr, size_t size, pid_t pid,
+		bool inc_ref, struct ve_phys_run *run, int nr_run)
+{
+	ret_t ret = 0;
+	int nr = 0;
+	int prot = 0;
+	int pgmod = 0;
+	size_t len = 0;
+	vemaa_t pb = 0;
+	vemva_t cur = vaddr;
+	vemva_t end = vaddr + size;
+	struct ve_task_struct *tsk = NULL;
+	struct ve_phys_run *last = NULL;
+
+	VEOS_TRACE("invoked");
+
+	VEOS_DEBUG("get vemaa for vemva %lx size %lx of tsk:pid(%d), inc(%d)",
+		vaddr, size, pid, inc_ref);
+
+	if (!size || !run || 0 >= nr_run) {
+		ret = -EINVAL;
+		goto vp_ret;
+	}
+
+	tsk = find_ve_task_struct((pid_t)pid);
+	if (NULL == tsk) {
+		ret = -ESRCH;
+		VEOS_DEBUG("Error (%s) while getting tsk with pid %d",
+			strerror(-ret), pid);
+		goto vp_ret;
+	}
+
+	pthread_mutex_lock_unlock(&tsk->p_ve_mm->thread_group_mm_lock, LOCK,
+			"Failed to acquire thread-group-mm-lock");
+	while (cur < end) {
+		ret = (uint64_t)__veos_virt_to_phy(cur, &tsk->p_ve_mm->atb,
+				&prot, &pgmod);
+		if (0 > ret) {
+			VEOS_DEBUG("Error (%s) in vemva 0x%lx to vemaa "
+				"translation", strerror(-ret), cur);
+			goto unlock;
+		}
+		pb = ret;
+		len = ROUN_DN(cur, pgmod_to_pgsz(pgmod)) +
+			pgmod_to_pgsz(pgmod) - cur;
+		if (len > end - cur)
+			len = end - cur;
+
+		if (last && last->vemaa + last->size == pb &&
+				last->prot == prot && last->pgmod == pgmod) {
+			last->size += len;
+		} else {
+			if (nr == nr_run) {
+				VEOS_DEBUG("vemva range 0x%lx-0x%lx needs more "
+					"than %d runs", vaddr, end, nr_run);
+				ret = -ENOSPC;
+				goto unlock;
+			}
+			last = &run[nr++];
+			last->vemaa = pb;
+			last->size = len;
+			last->prot = prot;
+			last->pgmod = pgmod;
+		}
+		cur += len;
+	}
+
+	ret = inc_ref ? veos_get_page_runs(run, nr) : 0;
+	if (0 == ret)
+		ret = nr;
+
+	VEOS_DEBUG("tsk:pid(%d) vemva 0x%lx size 0x%lx mapped with %d runs",
+		pid, vaddr, size, nr);
+unlock:
+	pthread_mutex_lock_unlock(&tsk->p_ve_mm->thread_group_mm_lock, UNLOCK,
+			"Failed to release thread-group-mm-lock");
+vp_ret:
+	if (tsk)
+		put_ve_task_struct(tsk);
+	VEOS_TRACE("returned");
+	return ret;
+}
+
 /**
 * @brief This function will give page mode info given VE virtual address range.
 *
@@ -2386,6 +2921,13 @@ struct mapping_desc *init_mapping_desc(
 *	 atomic_op == 1 then it will increase ref count;
 *	 atomic_op == 0 then it will decrease ref count;
 *
+*	Caller holds a reference or a mapping of the page, so the page can
+*	not be freed under it and ref counts are updated without the node
+*	lock. Only the put which may drop the last reference takes
+*	ve_pages_node_lock: a count reaches zero only under the lock, so the
+*	put which finds both ref counts zero hands the page off to the dirty
+*	page scrubber exactly once.
+*
 * @param[in] pgaddr VE physical address of page whose ref count is to be increase/decrease.
 *
 * @param[in] atomic_op this will decide whether to Increase/Decrease ref count.
@@ -2399,119 +2941,126 @@ int common_get_put_page(vemaa_t pb, uint8_t atomic_op, bool is_amm)
 	 * here we are considering Node 0 hard coded.
 	 */
 	struct ve_node_struct *vnode = VE_NODE(0);
+	struct ve_page *page = NULL;
+	uint64_t *cnt = NULL;
+	uint64_t old = 0, prev = 0;
 	ret_t ret = 0;
 
 	VEOS_TRACE("invoked");
 
-	/*Get lock on ve_node_struct*/
-	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
-			"Fail to acquire ve page lock");
-
 	pgnum = pfnum(pb, PG_2M);
 
 	/* If ve_page array contains -1,
 	 * its means that it is tail of huge page*/
-	if (NULL == vnode->ve_pages[pgnum]) {
+	page = vnode->ve_pages[pgnum];
+	if (NULL == page) {
 		VEOS_DEBUG("get/put operation invoked on unallocated VE page %ld",
 				pgnum);
 		ret = -EINVAL;
 		goto func_return;
 	}
-	if (vnode->ve_pages[pgnum] == (struct ve_page *)-1) {
+	if (page == (struct ve_page *)-1) {
 		VEOS_DEBUG("VE page %ld is tailof huge page",
 			pgnum);
 		pgnum = ROUN_DN(pgnum, HUGE_PAGE_IDX);
 		VEOS_DEBUG("Huge VE page is %ld", pgnum);
+		page = vnode->ve_pages[pgnum];
 	}
+	cnt = is_amm ? &page->ref_count : &page->dma_ref_count;
 
 	if (GET_PAGE == atomic_op) {
 		/*
 		 * Increament the ref count of page
 		 * This is built in function given by GCC to perform
 		 * atomic operation on memory*/
-		if (is_amm)  {
-			VEOS_DEBUG("VE page %ld refcnt before inc is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				ref_count);
-
-			__sync_fetch_and_add(&vnode->
-				ve_pages[pgnum]->ref_count, 1);
-
-			VEOS_DEBUG("VE page %ld refcnt after inc is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				ref_count);
-		} else {
-			VEOS_DEBUG("VE page %ld dma refcnt before inc is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				dma_ref_count);
-
-			__sync_fetch_and_add(&vnode->
-				ve_pages[pgnum]->dma_ref_count, 1);
+		old = __sync_fetch_and_add(cnt, 1);
+		VEOS_DEBUG("VE page %ld %s after inc is %ld", pgnum,
+			is_amm ? "refcnt" : "dma refcnt", old + 1);
+		goto func_return;
+	}
 
-			VEOS_DEBUG("VE page %ld dma refcnt after inc is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				dma_ref_count);
+	/* Drop a reference which is not the last one without lock */
+	old = *cnt;
+	while (old > 1) {
+		prev = __sync_val_compare_and_swap(cnt, old, old - 1);
+		if (prev == old) {
+			VEOS_DEBUG("VE page %ld %s after dec is %ld", pgnum,
+				is_amm ? "refcnt" : "dma refcnt", old - 1);
+			goto func_return;
 		}
-	} else {
-		/*Decreament the ref count of page*/
-		if (is_amm) {
-			VEOS_DEBUG("VE page %ld refcnt before dec is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				ref_count);
-
-			if (0 == vnode->ve_pages[pgnum]->ref_count) {
-				VEOS_DEBUG("VE page ref count is zero and unavailable for DMA");
-				ret = -EINVAL;
-				goto func_return;
-			}
-			__sync_fetch_and_sub(&vnode->
-				ve_pages[pgnum]->ref_count, 1);
-
-			VEOS_DEBUG("VE page %ld refcnt after dec is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				ref_count);
-			if ((0 == VE_PAGE(vnode, pgnum)->ref_count)
-			    && !(VE_PAGE(vnode, pgnum)->flag & PG_SHM)
-			    && !(VE_PAGE(vnode, pgnum)->flag & MAP_ANON)
-			    && ((VE_PAGE(vnode, pgnum)->flag & MAP_SHARED)
-				|| !(VE_PAGE(vnode, pgnum)->perm & PROT_WRITE))) {
-				clear_page_array_entry(VE_PAGE(vnode, pgnum)->
-						       private_data, pgnum);
-			}
-		} else {
-			VEOS_DEBUG("VE page %ld dma refcnt before dec is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				dma_ref_count);
-
-			if (vnode->ve_pages[pgnum]->dma_ref_count == 0) {
-				VEOS_DEBUG("VE page dma refcnt is already zero");
-				ret = -EINVAL;
-				goto func_return;
-			}
-			__sync_fetch_and_sub(&vnode->
-				ve_pages[pgnum]->dma_ref_count, 1);
+		old = prev;
+	}
 
-			VEOS_DEBUG("VE page %ld dma refcnt after dec is %ld",
-				pgnum, VE_PAGE(vnode, pgnum)->
-				dma_ref_count);
-		}
+	/* Last reference may be dropped, so decrement under lock */
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Fail to acquire ve page lock");
+	if (0 == *cnt) {
+		VEOS_DEBUG("VE page %ld %s is already zero", pgnum,
+			is_amm ? "refcnt" : "dma refcnt");
+		ret = -EINVAL;
+		goto unlock;
+	}
+	old = __sync_fetch_and_sub(cnt, 1);
+	VEOS_DEBUG("VE page %ld %s after dec is %ld", pgnum,
+		is_amm ? "refcnt" : "dma refcnt", old - 1);
 
-		/*if ref count page is zero then free that page*/
-		if ((0 == VE_PAGE(vnode, pgnum)->ref_count) &&
-			!(VE_PAGE(vnode, pgnum)->flag & PG_SHM) &&
-			(0 == VE_PAGE(vnode, pgnum)->dma_ref_count))
-				veos_free_page(pgnum);
+	if (is_amm && (0 == page->ref_count)
+	    && !(page->flag & PG_SHM)
+	    && !(page->flag & MAP_ANON)
+	    && ((page->flag & MAP_SHARED)
+		|| !(page->perm & PROT_WRITE))) {
+		clear_page_array_entry(page->private_data, pgnum);
 	}
 
-	/*Release lock from ve_node_struct*/
-func_return:
+	/*if ref count page is zero then free that page*/
+	if ((0 == page->ref_count) && !(page->flag & PG_SHM) &&
+			(0 == page->dma_ref_count))
+		veos_free_page(pgnum);
+unlock:
 	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
 			"Fail to release ve page lock");
+func_return:
 	VEOS_TRACE("returned");
 	return ret;
 }
 
 
+/**
+* @brief This function will increase ref count of a page by nr at once.
+*	It is used when several entries of a translation table map the same
+*	VE page, e.g. a 64MB page registered by 2MB PCIATB entries.
+*
+* @param[in] pb VE physical address of page whose ref count is to be increase.
+* @param[in] nr Number of references to be taken.
+* @param[in] is_amm Increase ref_count if true, dma_ref_count if false.
+*
+* @return return 0 on success and negative of errno on failure.
+*/
+int common_get_page_nr(vemaa_t pb, uint64_t nr, bool is_amm)
+{
+	struct ve_node_struct *vnode = VE_NODE(0);
+	struct ve_page *page = NULL;
+	uint64_t old = 0;
+
+	VEOS_TRACE("invoked");
+
+	page = VE_PAGE(vnode, pfnum(pb, PG_2M));
+	if (NULL == page) {
+		VEOS_DEBUG("get operation invoked on unallocated VE page 0x%lx",
+				pb);
+		return -EINVAL;
+	}
+
+	old = __sync_fetch_and_add(is_amm ? &page->ref_count :
+			&page->dma_ref_count, nr);
+	VEOS_DEBUG("VE page 0x%lx %s after inc is %ld", pb,
+		is_amm ? "refcnt" : "dma refcnt", old + nr);
+
+	VEOS_TRACE("returned");
+	return 0;
+}
+
+
 /**
 * @brief This function will increase the ref count of pages associated with DMA tranfer.
 *
@@ -3826,121 +4375,259 @@ hndl_return:
 	return rest_size;
 }
 
+/**
+ * @brief Transfer one unaligned process_vm_rw segment through VH buffer.
+ *
+ * @param[in] seg segment to transfer
+ * @param[in] src_pid pid of source process
+ * @param[in] dst_pid pid of destination process
+ *
+ * @return On success return 0, negative of errno on failure.
+ */
+static int amm_process_vm_rw_bounce(ve_dma_seg_t *seg, pid_t src_pid,
+		pid_t dst_pid)
+{
+	int ret = 0;
+	void *r_buff = NULL;
+
+	r_buff = malloc(seg->length);
+	if (NULL == r_buff) {
+		ret = -errno;
+		VEOS_CRIT("Error (%s) while allocting remote"
+				"buff", strerror(-ret));
+		return ret;
+	}
+	ret = amm_recv_data(src_pid, seg->srcaddr, seg->length, r_buff);
+	if (0 > ret) {
+		VEOS_DEBUG("Failed to recv the data");
+		goto hndl_return;
+	}
+	ret = amm_send_data(dst_pid, seg->dstaddr, seg->length, r_buff);
+	if (0 > ret)
+		VEOS_DEBUG("Failed to send the data");
+hndl_return:
+	free(r_buff);
+	return ret;
+}
+
+/**
+ * @brief Transfer a run of aligned process_vm_rw segments by DMA.
+ *
+ * @details The run is posted as one vectored DMA request. If it fails,
+ *	the segments are transferred again one at a time so that the
+ *	number of bytes which reached the destination is known.
+ *
+ * @param[in] seg first segment of the run
+ * @param[in] nseg number of segments in the run
+ * @param[in] src_pid pid of source process
+ * @param[in] dst_pid pid of destination process
+ * @param[out] done number of bytes transferred
+ *
+ * @return 0 if the whole run is transferred, -1 otherwise.
+ */
+static int amm_process_vm_rw_dma(ve_dma_seg_t *seg, uint64_t nseg,
+		pid_t src_pid, pid_t dst_pid, size_t *done)
+{
+	uint64_t i = 0;
+
+	*done = 0;
+	if (0 == amm_dma_xfer_vec(VE_DMA_VEMVA, src_pid, VE_DMA_VEMVA,
+				dst_pid, seg, nseg, 0)) {
+		for (i = 0; i < nseg; i++)
+			*done += seg[i].length;
+		return 0;
+	}
+
+	VEOS_DEBUG("Failed to transfer %ld segments, retrying one by one",
+			nseg);
+	for (i = 0; i < nseg; i++) {
+		if (0 > amm_dma_xfer(VE_DMA_VEMVA, seg[i].srcaddr, src_pid,
+					VE_DMA_VEMVA, seg[i].dstaddr, dst_pid,
+					seg[i].length, 0))
+			return -1;
+		*done += seg[i].length;
+	}
+	return 0;
+}
+
 /**
  * @brief This is generic handler for process_vm_rw if will read/write
  *	operation to/from  specified pid.
  *
- * @param[in] task Pointer of ve_task_struct of the VE process
+ * @details Local and remote iovec arrays are read from the VE memory of
+ *	the calling process and paired up into segments, which are
+ *	transferred in iovec order. Consecutive segments whose addresses
+ *	and length are 8 byte aligned are transferred directly between the
+ *	two processes by one vectored DMA request, so that all their
+ *	descriptors are in flight at once. The others are transferred
+ *	through VH buffer. As process_vm_readv(2) does, a failure after
+ *	some data was transferred returns the number of bytes transferred
+ *	so far.
+ *
+ * @param[in] tsk Pointer of ve_task_struct of the VE process
  * @param[in] ve_process_rw_info Structure which contain the information.
  *
- * @return On success return 0, -1 on failure.
+ * @return On success return the number of bytes transferred,
+ *	negative of errno when no byte was transferred.
  */
-int amm_do_processs_vm_rw(struct ve_task_struct *tsk,
-		struct ve_process_rw_info ve_process_rw_info)
+int64_t amm_do_processs_vm_rw(struct ve_task_struct *tsk,
+		struct ve_process_rw_info *ve_process_rw_info)
 {
-	vemva_t l_vemva = 0, r_vemva = 0, b_rvemva = 0;
-	uint64_t len = 0;
+	struct iovec *liov = NULL, *riov = NULL;
+	ve_dma_seg_t *seg = NULL;
+	struct ve_rw_check_iovec rw_args;
+	uint64_t liovcnt = ve_process_rw_info->liovcnt;
+	uint64_t riovcnt = ve_process_rw_info->riovcnt;
+	uint64_t li = 0, ri = 0, loff = 0, roff = 0;
+	uint64_t nseg = 0, start = 0, i = 0;
+	pid_t r_pid = ve_process_rw_info->r_pid;
+	pid_t src_pid = 0, dst_pid = 0;
+	vemva_t l_vemva = 0, r_vemva = 0;
+	size_t len = 0, done = 0;
+	int64_t total = 0, ret = 0;
+	bool fault = false;
 
 	VEOS_TRACE("invoked");
-	l_vemva = ve_process_rw_info.lcov_offset +
-		ve_process_rw_info.local_vemva;
-	r_vemva = ve_process_rw_info.rcov_offest +
-		ve_process_rw_info.remote_vemva;
-	b_rvemva = ve_process_rw_info.base_rvemva;
-	len = ve_process_rw_info.r_len;
-	int ret;
-	struct ve_rw_check_iovec rw_args;
-	void *r_buff = NULL;
 
-	/* check r/w permission on remote VEMVA */
-	if (b_rvemva == r_vemva) {
-		rw_args.vaddr = b_rvemva;
-		rw_args.len = len;
-		rw_args.pid = ve_process_rw_info.r_pid;
-		rw_args.type = ve_process_rw_info.vm_rw;
-		ret = amm_rw_check_permission(tsk, rw_args);
-		if (0 > ret) {
-			VEOS_DEBUG("Fail to check permission");
-			return -1;
-		}
+	if (liovcnt > IOV_MAX || riovcnt > IOV_MAX) {
+		VEOS_DEBUG("Invalid iovec count l:%ld r:%ld", liovcnt, riovcnt);
+		return -EINVAL;
 	}
-	rw_args.vaddr = l_vemva;
-	rw_args.len = ve_process_rw_info.len;
-	rw_args.pid = tsk->pid;
-	rw_args.type = !(ve_process_rw_info.vm_rw);
+	if (!liovcnt || !riovcnt)
+		return 0;
 
-	/*
-	 * We Do not need to check protection here when
-	 * DMA will check protection internally. Which will be done
-	 * under task refs #230
-	 */
-	ret = amm_rw_check_permission(tsk, rw_args);
-	if (0 > ret) {
-		VEOS_DEBUG("Fail to check permission");
-		return -1;
+	liov = malloc(sizeof(struct iovec) * liovcnt);
+	riov = malloc(sizeof(struct iovec) * riovcnt);
+	/* pairing up iovecs yields at most liovcnt + riovcnt segments */
+	seg = malloc(sizeof(ve_dma_seg_t) * (liovcnt + riovcnt));
+	if (NULL == liov || NULL == riov || NULL == seg) {
+		ret = -errno;
+		VEOS_CRIT("Error (%s) while allocating iovec buffers",
+				strerror(-ret));
+		goto hndl_return;
 	}
 
-	if (ve_process_rw_info.vm_rw) {
-		/* Here we are first recv data from local vemva to
-		 * VH buffer than we will write the data from VH buffer
-		 * to remote VEMVA
-		 */
-		r_buff = malloc(len);
-		if (NULL == r_buff) {
-			ret = -ret;
-			VEOS_CRIT("Error (%s) while allocting remote"
-					"buff",	strerror(-ret));
-			return -ret;
-		}
-		/*MEMSET*/
-		memset(r_buff, '\0', len);
-		ret = amm_recv_data(tsk->pid, l_vemva,
-				ve_process_rw_info.len, r_buff);
-		if (0 > ret) {
-			VEOS_DEBUG("Failed to recv the data");
-			free(r_buff);
-			return ret;
+	if (0 > amm_recv_data(tsk->pid, ve_process_rw_info->local_iov,
+				sizeof(struct iovec) * liovcnt, liov) ||
+			0 > amm_recv_data(tsk->pid,
+				ve_process_rw_info->remote_iov,
+				sizeof(struct iovec) * riovcnt, riov)) {
+		VEOS_DEBUG("Failed to recv iovec arrays");
+		ret = -EFAULT;
+		goto hndl_return;
+	}
+	for (i = 0; i < liovcnt; i++) {
+		if (0 > (ssize_t)liov[i].iov_len) {
+			ret = -EINVAL;
+			goto hndl_return;
 		}
-		ret = amm_send_data(ve_process_rw_info.r_pid, r_vemva,
-				ve_process_rw_info.len,	r_buff);
-		if (0 > ret) {
-			VEOS_DEBUG("Failed to send the data");
-			free(r_buff);
-			return ret;
+	}
+	for (i = 0; i < riovcnt; i++) {
+		if (0 > (ssize_t)riov[i].iov_len) {
+			ret = -EINVAL;
+			goto hndl_return;
 		}
+	}
+
+	if (ve_process_rw_info->vm_rw) {
+		src_pid = tsk->pid;
+		dst_pid = r_pid;
 	} else {
-		/* Here we are first recv data from remote vemva to
-		 * VH buffer than we will write data from VH buffer
-		 * to local VEMVA
-		 */
-		r_buff = malloc(len);
-		if (NULL == r_buff) {
-			ret = -ret;
-			VEOS_CRIT("Error (%s) while allocting remote"
-					"buff",	strerror(-ret));
-			return -ret;
+		src_pid = r_pid;
+		dst_pid = tsk->pid;
+	}
+
+	for (ri = 0; ri < riovcnt && li < liovcnt && !fault; ri++) {
+		if (0 == riov[ri].iov_len)
+			continue;
+		/* check r/w permission on remote VEMVA */
+		rw_args.vaddr = (vemva_t)riov[ri].iov_base;
+		rw_args.len = riov[ri].iov_len;
+		rw_args.pid = r_pid;
+		rw_args.type = ve_process_rw_info->vm_rw;
+		if (0 > amm_rw_check_permission(tsk, rw_args)) {
+			VEOS_DEBUG("Fail to check permission");
+			fault = true;
+			break;
 		}
-		/*MEMSET*/
-		memset(r_buff, '\0', len);
-		ret = amm_recv_data(ve_process_rw_info.r_pid, r_vemva,
-				ve_process_rw_info.len, r_buff);
-		if (0 > ret) {
-			VEOS_DEBUG("Failed to recv the data");
-			free(r_buff);
-			return ret;
+		for (roff = 0; roff < riov[ri].iov_len && li < liovcnt;) {
+			if (loff >= liov[li].iov_len) {
+				li++;
+				loff = 0;
+				continue;
+			}
+			len = riov[ri].iov_len - roff;
+			if (len > liov[li].iov_len - loff)
+				len = liov[li].iov_len - loff;
+			l_vemva = (vemva_t)liov[li].iov_base + loff;
+			r_vemva = (vemva_t)riov[ri].iov_base + roff;
+
+			rw_args.vaddr = l_vemva;
+			rw_args.len = len;
+			rw_args.pid = tsk->pid;
+			rw_args.type = !(ve_process_rw_info->vm_rw);
+			if (0 > amm_rw_check_permission(tsk, rw_args)) {
+				VEOS_DEBUG("Fail to check permission");
+				fault = true;
+				break;
+			}
+			if (ve_process_rw_info->vm_rw) {
+				seg[nseg].srcaddr = l_vemva;
+				seg[nseg].dstaddr = r_vemva;
+			} else {
+				seg[nseg].srcaddr = r_vemva;
+				seg[nseg].dstaddr = l_vemva;
+			}
+			seg[nseg].length = len;
+			nseg++;
+			roff += len;
+			loff += len;
 		}
-		ret = amm_send_data(tsk->pid, l_vemva,
-				ve_process_rw_info.len,	r_buff);
-		if (0 > ret) {
-			VEOS_DEBUG("Failed to send the data");
-			free(r_buff);
-			return ret;
+	}
+	/* Nothing to transfer is not an error unless the first non-empty
+	 * segment failed its permission check */
+	if (0 == nseg) {
+		ret = fault ? -EFAULT : 0;
+		goto hndl_return;
+	}
+
+	/* transfer segments in iovec order, batching each run of
+	 * aligned segments into one DMA request */
+	for (i = 0; i <= nseg; i++) {
+		if (i < nseg && IS_ALIGNED(seg[i].srcaddr, 8) &&
+				IS_ALIGNED(seg[i].dstaddr, 8) &&
+				IS_ALIGNED(seg[i].length, 8))
+			continue;
+		if (i > start) {
+			ret = amm_process_vm_rw_dma(&seg[start], i - start,
+					src_pid, dst_pid, &done);
+			total += done;
+			if (0 > ret)
+				goto hndl_partial;
 		}
+		if (i == nseg)
+			break;
+		ret = amm_process_vm_rw_bounce(&seg[i], src_pid, dst_pid);
+		if (0 > ret)
+			goto hndl_partial;
+		total += seg[i].length;
+		start = i + 1;
 	}
-	if (r_buff)
-		free(r_buff);
-	return 0;
+	ret = total;
+	goto hndl_return;
+
+hndl_partial:
+	VEOS_DEBUG("Transfer stopped after %ld bytes", total);
+	ret = total ? total : -EFAULT;
+
+hndl_return:
+	free(liov);
+	free(riov);
+	free(seg);
+	VEOS_TRACE("returned(%ld)", ret);
+	return ret;
 }
+
 /**
  * @brief This function check write permission of given address for specified
  *	process.
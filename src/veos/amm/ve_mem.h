@@ -72,6 +72,14 @@
 
 #define CHUNK_512MB	0x20000000
 
+#define PG_CACHE_NUM		16	/*!< Max number of free page caches */
+#define PG_CACHE_BATCH_2M	8	/*!< 2MB pages taken from buddy at once */
+#define PG_CACHE_BATCH_64M	2	/*!< 64MB pages taken from buddy at once */
+
+/* Max shortage of memory which an allocation clears dirty pages for
+ * by itself, instead of waiting for the clearing thread */
+#define SYNC_CLEAR_MAX	(2 * PAGE_SIZE_64MB)
+
 #define SMALL_PSHFT	12      /*<!Shift for small page*/
 #define LARGE_PSHFT	21	/*<!Shift for large page*/
 #define HUGE_PSHFT	26	/*<!Shift for huge page*/
@@ -218,6 +226,31 @@ struct ve_page {
 	pthread_mutex_t ve_page_lock; /*!< mutex lock*/
 };
 
+/**
+* @brief Cache of free VE pages taken from buddy allocator in batch.
+*	Single page allocation takes a page from the cache of host CPU
+*	on which the thread runs, without acquiring ve_pages_node_lock.
+*	Pages in the cache are counted as used in buddy mempool and already
+*	have their ve_pages[] entries.
+*/
+struct ve_page_cache {
+	pthread_mutex_t lock;	/*!< Lock for this cache */
+	int nr_2m;		/*!< Number of cached 2MB pages */
+	int nr_64m;		/*!< Number of cached 64MB pages */
+	pgno_t pg_2m[PG_CACHE_BATCH_2M];	/*!< Cached 2MB pages */
+	pgno_t pg_64m[PG_CACHE_BATCH_64M];	/*!< Cached 64MB pages */
+};
+
+/**
+* @brief Run of physically contiguous VE memory with same attributes
+*/
+struct ve_phys_run {
+	vemaa_t vemaa;	/*!< VEMAA of first byte of run */
+	size_t size;	/*!< Size of run in bytes */
+	int prot;	/*!< Protection of pages in run */
+	int pgmod;	/*!< Page mode of pages in run */
+};
+
 /*File Backed Handling Related APIs*/
 ret_t amm_do_file_back_handling(vemva_t, struct file_desc *,
 		off_t, off_t, int, struct ve_task_struct *,
@@ -255,14 +288,17 @@ int amm_do_mmap(vemva_t, size_t, prot_t, flag_t,
 int amm_do_munmap(vemva_t, size_t, struct ve_task_struct *, bool);
 int amm_do_mprotect(vemva_t, ssize_t, uint64_t,
 				struct ve_task_struct *);
-int amm_do_processs_vm_rw(struct ve_task_struct *task,
-		struct ve_process_rw_info ve_process_rw_info);
+int64_t amm_do_processs_vm_rw(struct ve_task_struct *task,
+		struct ve_process_rw_info *ve_process_rw_info);
 int check_write_permisssion(vemva_t va_addr, pid_t pid);
 int amm_rw_check_permission(struct ve_task_struct *tsk,
 		struct ve_rw_check_iovec rw_agrs);
 int ve_node_page_free_count(int);
 uint64_t ve_node_page_used_count(int);
 int alloc_ve_pages(uint64_t, pgno_t *, int);
+int amm_init_page_cache(struct ve_node_struct *);
+void amm_fini_page_cache(struct ve_node_struct *);
+int amm_drain_page_cache(void);
 int calc_usable_dirty_page(struct ve_node_struct *vnode,
 			   size_t mem_sz, int pgmod);
 void amm_wake_alloc_page(void);
@@ -273,6 +309,7 @@ void amm_copy_atb_vfork(atb_reg_t *, atb_reg_t *, struct veshm_struct *);
 int amm_copy_phy_page(uint64_t, uint64_t, uint64_t);
 ret_t amm_clear_page(uint64_t, size_t);
 int amm_dma_xfer(int, uint64_t, int, int, uint64_t, int, uint64_t, int);
+int amm_dma_xfer_vec(int, int, int, int, ve_dma_seg_t *, int, int);
 int vemva_to_vemaa(pid_t, uint64_t, uint64_t *);
 int amm_initialize_zeroed_page(vemaa_t);
 bool ve_elf_core_dump(struct dump_params *);
@@ -282,8 +319,11 @@ int veos_put_page(vemaa_t);
 int amm_get_page(vemaa_t *);
 int amm_put_page(vemaa_t);
 int common_get_put_page(vemaa_t, uint8_t, bool);
+int common_get_page_nr(vemaa_t, uint64_t, bool);
 int veos_free_page(vemaa_t);
 int64_t veos_virt_to_phy(vemva_t, pid_t, bool, int *);
+int veos_virt_to_phy_range(vemva_t, size_t, pid_t, bool,
+		struct ve_phys_run *, int);
 void veos_amm_fini(void);
 void sync_at_exit(struct ve_task_struct *);
 int sync_vhva(vemaa_t, vhva_t, struct ve_task_struct *);
@@ -298,6 +338,7 @@ int dirty_page_init(struct ve_node_struct *vnode, pthread_t *th);
 int add_dirty_page(pgno_t pgno, size_t pgsz, int pgmod);
 void veos_amm_clear_mem_thread(void);
 int clear_and_dealloc_page(pgno_t pgno, size_t pgsz, int pgmod);
+size_t amm_clear_dirty_page_sync(size_t);
 
 /*VEMVA share*/
 int veos_share_vemva_region(pid_t, vemva_t, pid_t,
@@ -0,0 +1,556 @@
+/*
+ * Copyright (C) 2017-2018 NEC Corporation
+ * This file is part of the VEOS.
+ *
+ * The VEOS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * The VEOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with the VEOS; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file ve_migrate.c
+ * @brief AMM functions which migrate VE pages in background.
+ *
+ *	When buddy free lists are fragmented into 2MB orders, movable
+ *	private pages are moved out of mostly free 64MB ranges, so that
+ *	the ranges become free 64MB blocks again (compaction).
+ *
+ * @internal
+ * @author AMM
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include "ve_migrate.h"
+#include "ve_mem.h"
+#include "mm_common.h"
+#include "veos.h"
+#include "buddy.h"
+#include "task_sched.h"
+
+static pthread_t migrate_th;
+static struct ve_migrate_stat migrate_stat;
+int veos_compact_level = COMPACT_LEVEL_DEFAULT;
+
+/**
+* @brief This function stops scheduling and request handling on VE node
+*	while pages of VE processes are migrated.
+*/
+static void amm_migrate_freeze(void)
+{
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	/* node_sem is acquired before ve_relocate_lock as scheduler does */
+	while (-1 == sem_wait(&vnode->node_sem)) {
+		if (EINTR != errno)
+			veos_abort("Failed to acquire VE node semaphore"
+					" for page migration");
+	}
+	pthread_rwlock_lock_unlock(&vnode->ve_relocate_lock, WRLOCK,
+			"Failed to acquire ve_relocate_lock write lock");
+}
+
+/**
+* @brief This function restarts scheduling and request handling on VE node
+*	stopped by amm_migrate_freeze().
+*/
+static void amm_migrate_thaw(void)
+{
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	pthread_rwlock_lock_unlock(&vnode->ve_relocate_lock, UNLOCK,
+			"Failed to release ve_relocate_lock write lock");
+	sem_post(&vnode->node_sem);
+}
+
+/**
+* @brief This function copies a 2MB page into a new page, remaps the ATB
+*	entry to the new page and releases the old page.
+*	Caller must hold thread_group_mm_lock and must have halted all
+*	threads of the thread group.
+*
+* @param[in] pte ATB entry which maps the old page.
+* @param[in] old_pgno Page number of old page.
+* @param[in] new_pgno Page number of new page which is not referenced yet.
+*
+* @return On success returns 0 and negative of errno on failure.
+*	On failure, new page is released and ATB entry is not changed.
+*/
+static int amm_migrate_pte(atb_entry_t *pte, pgno_t old_pgno,
+		pgno_t new_pgno)
+{
+	int ret = 0;
+	vemaa_t pb[2] = {0};
+	struct ve_page *old_page = NULL, *new_page = NULL;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	/* Attributes are copied first, since amm_put_page() looks at them */
+	old_page = VE_PAGE(vnode, old_pgno);
+	new_page = VE_PAGE(vnode, new_pgno);
+	new_page->perm = old_page->perm;
+	new_page->flag = old_page->flag;
+	new_page->owner = old_page->owner;
+	pb[0] = pbaddr(new_pgno, PG_2M);
+	amm_get_page(pb);
+
+	ret = memcpy_petoe(pbaddr(old_pgno, PG_2M), pbaddr(new_pgno, PG_2M),
+			PAGE_SIZE_2MB);
+	if (0 > ret) {
+		VEOS_DEBUG("Error (%s) in page copy from %ld to %ld",
+				strerror(-ret), old_pgno, new_pgno);
+		amm_put_page(pbaddr(new_pgno, PG_2M));
+		return ret;
+	}
+
+	pg_clearpfn(pte);
+	pg_setpb(pte, new_pgno, PG_2M);
+
+	if (amm_put_page(pbaddr(old_pgno, PG_2M)))
+		VEOS_DEBUG("Error while freeing page %ld", old_pgno);
+
+	return 0;
+}
+
+/**
+* @brief This function takes a 2MB page from buddy allocator.
+*
+* @param[out] pgno Page number of allocated page.
+*
+* @return On success returns 0 and negative of errno on failure.
+*/
+static int amm_migrate_alloc_page(pgno_t *pgno)
+{
+	int ret = 0;
+	struct block *curr_blk = NULL, *tmp_blk = NULL;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	ret = veos_alloc_memory(vnode->mp, PAGE_SIZE_2MB, PG_2M);
+	if (0 == ret) {
+		ret = veos_page_entry(vnode->mp, PG_2M, pgno);
+	} else {
+		list_for_each_entry_safe(curr_blk, tmp_blk,
+				vnode->mp->alloc_req_list, link) {
+			list_del(&curr_blk->link);
+			buddy_free(vnode->mp, curr_blk);
+		}
+	}
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+
+	return ret;
+}
+
+/**
+* @brief This function checks whether pages of a VE process can be moved.
+*
+* @param[in] tsk Thread group leader of VE process.
+*
+* @return true if VE process is alive and not traced, else false.
+*/
+static bool amm_migrate_movable(struct ve_task_struct *tsk)
+{
+	return (tsk->p_ve_mm && !tsk->ptraced && !tsk->exit_status &&
+			(ZOMBIE != tsk->ve_task_state));
+}
+
+/**
+* @brief This function calculates fragmentation index of VE memory.
+*	Caller must hold ve_pages_node_lock.
+*
+* @param[in] mp VE buddy mempool.
+*
+* @return Per mille of free memory which can not be used as 64MB pages.
+*/
+static uint64_t amm_frag_index(struct buddy_mempool *mp)
+{
+	size_t free_2m = 0, free_hp = 0;
+
+	free_2m = calc_free_sz(mp, PG_2M);
+	free_hp = calc_free_sz(mp, PG_HP);
+	if (!free_2m)
+		return 0;
+
+	return ((free_2m - free_hp) * 1000) / free_2m;
+}
+
+/**
+* @brief This function builds reverse mapping from VE pages to ATB
+*	entries of VE processes whose pages can be moved.
+*	Caller must have frozen VE node and must hold init_task_lock.
+*
+* @param[out] rmap Reverse mapping indexed by page number.
+* @param[in] nr_pages Number of VE pages.
+*/
+static void amm_compact_build_rmap(struct ve_migrate_rmap *rmap,
+		uint64_t nr_pages)
+{
+	int dir = 0, ent = 0;
+	pgno_t pgno = 0;
+	atb_entry_t *pte = NULL;
+	struct list_head *p = NULL, *n = NULL;
+	struct ve_task_struct *tsk = NULL;
+	struct ve_mm_struct *mm = NULL;
+
+	list_for_each_safe(p, n, &ve_init_task.tasks) {
+		tsk = list_entry(p, struct ve_task_struct, tasks);
+		if (!amm_migrate_movable(tsk))
+			continue;
+		mm = tsk->p_ve_mm;
+		pthread_mutex_lock_unlock(&mm->thread_group_mm_lock, LOCK,
+				"Failed to acquire thread-group-mm-lock");
+		for (dir = 0; dir < ATB_DIR_NUM; dir++) {
+			if (!ps_isvalid(&mm->atb.dir[dir]) ||
+					(PG_2M != ps_getpgsz(&mm->atb.dir[dir])))
+				continue;
+			for (ent = 0; ent < ATB_ENTRY_MAX_SIZE; ent++) {
+				pte = &mm->atb.entry[dir][ent];
+				if (!pg_isvalid(pte) ||
+					(VE_ADDR_VEMAA != pg_gettype(pte)))
+					continue;
+				pgno = pg_getpb(pte, PG_2M);
+				if ((PG_BUS == pgno) || (pgno >= nr_pages))
+					continue;
+				/* Page mapped twice is not moved */
+				if (rmap[pgno].tsk)
+					rmap[pgno].tsk = COMPACT_RMAP_SHARED;
+				else {
+					rmap[pgno].tsk = tsk;
+					rmap[pgno].dir = dir;
+					rmap[pgno].ent = ent;
+				}
+			}
+		}
+		pthread_mutex_lock_unlock(&mm->thread_group_mm_lock, UNLOCK,
+				"Failed to release thread-group-mm-lock");
+	}
+}
+
+/**
+* @brief This function marks VE pages which are free in buddy allocator
+*	and belong to free blocks smaller than 64MB.
+*	Caller must hold ve_pages_node_lock.
+*
+* @param[in] mp VE buddy mempool.
+* @param[out] pg_free Free flag indexed by page number.
+* @param[in] nr_pages Number of VE pages.
+*/
+static void amm_compact_mark_free(struct buddy_mempool *mp, bool *pg_free,
+		uint64_t nr_pages)
+{
+	unsigned long order = 0;
+	pgno_t pgno = 0, idx = 0;
+	struct block *blk = NULL;
+
+	for (order = mp->min_order; (order < size_to_order(PAGE_SIZE_64MB)) &&
+			(order <= mp->pool_order); order++) {
+		list_for_each_entry(blk, &mp->frb->free[order], link) {
+			pgno = blk->start >> PSSHFT;
+			for (idx = 0; idx < ((1UL << order) >> PSSHFT); idx++)
+				if ((pgno + idx) < nr_pages)
+					pg_free[pgno + idx] = true;
+		}
+	}
+}
+
+/**
+* @brief This function checks whether a VE page can be moved by compaction.
+*
+* @param[in] rmap Reverse mapping of the page.
+* @param[in] pgno Page number.
+*
+* @return true if the page can be moved, else false.
+*/
+static bool amm_compact_movable(struct ve_migrate_rmap *rmap, pgno_t pgno)
+{
+	struct ve_page *page = NULL;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	page = vnode->ve_pages[pgno];
+	if ((NULL == page) || ((struct ve_page *)-1 == page))
+		return false;
+	if ((NULL == rmap->tsk) || (COMPACT_RMAP_SHARED == rmap->tsk))
+		return false;
+
+	return ((PAGE_SIZE_2MB == page->pgsz) && (1 == page->ref_count) &&
+			!page->dma_ref_count && (page->flag & MAP_ANON) &&
+			!(page->flag & (PG_SHM | PG_PTRACE | MAP_SHARED)) &&
+			!page->private_data);
+}
+
+/**
+* @brief This function moves pages out of a 64MB aligned range, so that
+*	the range becomes a free 64MB block.
+*	Caller must have frozen VE node and must hold init_task_lock.
+*
+* @param[in] rmap Reverse mapping indexed by page number.
+* @param[in] pg_free Free flag indexed by page number.
+* @param[in] base First page number of the range.
+* @param[in] max_move Max number of pages moved out of the range.
+*
+* @return Number of moved pages, 0 if the range is skipped,
+*	negative of errno on failure.
+*/
+static int amm_compact_range(struct ve_migrate_rmap *rmap, bool *pg_free,
+		pgno_t base, int max_move)
+{
+	int ret = 0, idx = 0, jdx = 0, nr_used = 0, moved = 0;
+	int dir_first = -1, dir_last = -1;
+	uint64_t core_set = 0;
+	size_t isolated_sz = 0;
+	pgno_t used[HUGE_PAGE_IDX] = {0};
+	pgno_t new_pgno = 0;
+	bool done[HUGE_PAGE_IDX] = {false};
+	struct list_head isolated;
+	struct block *curr_blk = NULL, *tmp_blk = NULL;
+	struct ve_task_struct *tsk = NULL;
+	struct ve_migrate_rmap *map = NULL;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	for (idx = 0; idx < HUGE_PAGE_IDX; idx++) {
+		if (pg_free[base + idx])
+			continue;
+		if ((nr_used == max_move) ||
+				!amm_compact_movable(&rmap[base + idx], base + idx))
+			return 0;
+		used[nr_used++] = base + idx;
+	}
+	if (!nr_used)
+		return 0;
+
+	VEOS_DEBUG("compact range of page %ld with %d used pages",
+			base, nr_used);
+
+	/* Free blocks in the range must not be allocated as new pages */
+	INIT_LIST_HEAD(&isolated);
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	isolated_sz = buddy_isolate(vnode->mp, pbaddr(base, PG_2M),
+			size_to_order(PAGE_SIZE_64MB), &isolated);
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+	if ((isolated_sz + (nr_used * PAGE_SIZE_2MB)) != PAGE_SIZE_64MB) {
+		VEOS_DEBUG("free blocks in range changed");
+		goto putback;
+	}
+
+	for (idx = 0; (idx < nr_used) && (0 <= ret); idx++) {
+		if (done[idx])
+			continue;
+		tsk = rmap[used[idx]].tsk;
+		pthread_mutex_lock_unlock(&tsk->p_ve_mm->thread_group_mm_lock,
+				LOCK, "Failed to acquire thread-group-mm-lock");
+		if (psm_halt_thread_group(tsk, &core_set)) {
+			pthread_mutex_lock_unlock(
+				&tsk->p_ve_mm->thread_group_mm_lock, UNLOCK,
+				"Failed to release thread-group-mm-lock");
+			ret = -ENOMEM;
+			break;
+		}
+		dir_first = dir_last = -1;
+		for (jdx = idx; jdx < nr_used; jdx++) {
+			map = &rmap[used[jdx]];
+			if (done[jdx] || (map->tsk != tsk))
+				continue;
+			ret = amm_migrate_alloc_page(&new_pgno);
+			if (0 > ret)
+				break;
+			ret = amm_migrate_pte(
+				&tsk->p_ve_mm->atb.entry[map->dir][map->ent],
+				used[jdx], new_pgno);
+			if (0 > ret)
+				break;
+			if ((0 > dir_first) || (map->dir < dir_first))
+				dir_first = map->dir;
+			if (map->dir > dir_last)
+				dir_last = map->dir;
+			done[jdx] = true;
+			moved++;
+		}
+		if (0 > dir_first)
+			psm_resume_thread_group(tsk, core_set, 0, 0);
+		else
+			psm_resume_thread_group(tsk, core_set, dir_first,
+					dir_last - dir_first + 1);
+		pthread_mutex_lock_unlock(&tsk->p_ve_mm->thread_group_mm_lock,
+				UNLOCK, "Failed to release thread-group-mm-lock");
+	}
+
+putback:
+	/* Range is merged into a 64MB block when moved pages are cleared */
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	list_for_each_entry_safe(curr_blk, tmp_blk, &isolated, link) {
+		list_del(&curr_blk->link);
+		buddy_free(vnode->mp, curr_blk);
+	}
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+
+	migrate_stat.nr_compact_moved += moved;
+	if (0 > ret) {
+		VEOS_DEBUG("Error (%s) in compacting range of page %ld",
+				strerror(-ret), base);
+		return ret;
+	}
+	return (moved == nr_used) ? moved : 0;
+}
+
+/**
+* @brief This function compacts VE memory when free memory is fragmented
+*	more than the threshold of veos_compact_level.
+*	Scheduling and request handling of the whole VE node are stopped
+*	while the pass runs, since pages of any VE process may be moved.
+*/
+static void amm_compact_pass(void)
+{
+	int ret = 0, level = veos_compact_level, nr_range = 0;
+	uint64_t nr_pages = 0, range = 0;
+	size_t free_2m = 0, free_hp = 0;
+	bool *pg_free = NULL;
+	struct ve_migrate_rmap *rmap = NULL;
+	struct ve_node_struct *vnode = VE_NODE(0);
+
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	migrate_stat.frag_index = amm_frag_index(vnode->mp);
+	free_2m = calc_free_sz(vnode->mp, PG_2M);
+	free_hp = calc_free_sz(vnode->mp, PG_HP);
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+
+	if (!level || (migrate_stat.frag_index < COMPACT_FRAG_THRESHOLD(level))
+			|| ((free_2m - free_hp) < PAGE_SIZE_64MB))
+		return;
+
+	nr_pages = vnode->nr_pages;
+	pg_free = (bool *)calloc(nr_pages, sizeof(bool));
+	rmap = (struct ve_migrate_rmap *)calloc(nr_pages,
+			sizeof(struct ve_migrate_rmap));
+	if ((NULL == pg_free) || (NULL == rmap)) {
+		VEOS_CRIT("calloc error while compacting VE memory");
+		goto hndl_free;
+	}
+
+	migrate_stat.nr_compact_pass++;
+	/* Pages held by page caches are not free in buddy allocator */
+	amm_drain_page_cache();
+
+	amm_migrate_freeze();
+	pthread_rwlock_lock_unlock(&init_task_lock, RDLOCK,
+			"failed to acquire init task lock");
+	amm_compact_build_rmap(rmap, nr_pages);
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, LOCK,
+			"Failed to acquire ve_page lock");
+	amm_compact_mark_free(vnode->mp, pg_free, nr_pages);
+	pthread_mutex_lock_unlock(&vnode->ve_pages_node_lock, UNLOCK,
+			"Failed to release ve_page lock");
+
+	for (range = 0; ((range + 1) * HUGE_PAGE_IDX <= nr_pages) &&
+			(nr_range < COMPACT_MAX_RANGE(level)); range++) {
+		ret = amm_compact_range(rmap, pg_free, range * HUGE_PAGE_IDX,
+				COMPACT_MAX_MOVE(level));
+		if (-ENOMEM == ret)
+			break;
+		if (0 < ret) {
+			nr_range++;
+			migrate_stat.nr_compacted++;
+		}
+	}
+	pthread_rwlock_lock_unlock(&init_task_lock, UNLOCK,
+			"failed to release init task lock");
+	amm_migrate_thaw();
+
+	VEOS_DEBUG("compaction pass %ld: fragmentation %ld, %ld ranges "
+			"compacted, %ld pages moved", migrate_stat.nr_compact_pass,
+			migrate_stat.frag_index, migrate_stat.nr_compacted,
+			migrate_stat.nr_compact_moved);
+hndl_free:
+	free(pg_free);
+	free(rmap);
+}
+
+/**
+* @brief This function copies statistics of VE page migration.
+*
+* @param[out] mig_stat Statistics of VE page migration.
+*/
+void amm_migrate_get_stat(struct ve_migrate_stat *mig_stat)
+{
+	memcpy(mig_stat, &migrate_stat, sizeof(migrate_stat));
+}
+
+/**
+* @brief This is the thread which migrates VE pages in background.
+*/
+void veos_amm_migrate_thread(void)
+{
+	int sec = 0;
+
+	VEOS_TRACE("invoked");
+	while (!terminate_flag) {
+		for (sec = 0; (sec < MIGRATE_INTERVAL) && !terminate_flag;
+				sec++)
+			sleep(1);
+		if (terminate_flag)
+			break;
+
+		if (pthread_rwlock_tryrdlock(&handling_request_lock)) {
+			VEOS_ERROR("failed to acquire request lock");
+			break;
+		}
+		amm_compact_pass();
+		pthread_rwlock_lock_unlock(&handling_request_lock, UNLOCK,
+				"failed to release handling_request_lock");
+	}
+	VEOS_DEBUG("page migration thread exiting");
+	VEOS_TRACE("returned");
+}
+
+/**
+* @brief This function creates the thread which migrates VE pages.
+*
+* @return On success returns 0 and negative of errno on failure.
+*/
+int amm_migrate_init(void)
+{
+	pthread_attr_t attr;
+	int ret = 0;
+
+	memset(&migrate_stat, 0, sizeof(migrate_stat));
+
+	ret = pthread_attr_init(&attr);
+	if (ret != 0) {
+		VEOS_CRIT("Faild to initialize pthread attribute: %s",
+			strerror(ret));
+		return -ret;
+	}
+	ret = pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (ret != 0) {
+		VEOS_CRIT("Faild to set detach state of pthread attribute: %s",
+			strerror(ret));
+		goto error;
+	}
+	ret = pthread_create(&migrate_th, &attr,
+			(void *)&veos_amm_migrate_thread, NULL);
+	if (ret != 0) {
+		VEOS_CRIT("Failed to create thread. %s", strerror(ret));
+		goto error;
+	}
+error:
+	pthread_attr_destroy(&attr);
+	return -ret;
+}
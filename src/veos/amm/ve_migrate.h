@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2017-2018 NEC Corporation
+ * This file is part of the VEOS.
+ *
+ * The VEOS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * The VEOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with the VEOS; if not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+/*
+ * @file ve_migrate.h
+ * @brief Header file for "ve_migrate.c" file
+ *
+ * @internal
+ * @author AMM
+ */
+
+#ifndef __AMM_MIGRATE_H
+#define __AMM_MIGRATE_H
+
+#include "ve_mem.h"
+#include "task_mgmt.h"
+
+#define MIGRATE_INTERVAL	10	/*!< Seconds between migration passes */
+
+/*
+ * A compaction pass freezes the whole VE node (node_sem and
+ * ve_relocate_lock write lock) while it moves pages, so each level bounds
+ * the pages moved in a pass: at most
+ * COMPACT_MAX_RANGE(level) * COMPACT_MAX_MOVE(level) 2MB copies.
+ */
+#define COMPACT_LEVEL_MIN	0	/*!< Compaction is disabled */
+#define COMPACT_LEVEL_MAX	3	/*!< Most aggressive compaction */
+#define COMPACT_LEVEL_DEFAULT	COMPACT_LEVEL_MIN
+/* Fragmentation index (per mille) from which compaction starts */
+#define COMPACT_FRAG_THRESHOLD(level)	(1000 - (250 * (level)))
+/* Max pages moved out of a 64MB range to make it free */
+#define COMPACT_MAX_MOVE(level)	(4 << ((level) - 1))
+/* Max 64MB ranges made free in a pass */
+#define COMPACT_MAX_RANGE(level)	(2 * (level))
+#define COMPACT_RMAP_SHARED	((struct ve_task_struct *)-1)
+
+/**
+* @brief Statistics of VE page migration
+*/
+struct ve_migrate_stat {
+	uint64_t nr_compact_pass;	/*!< Number of compaction passes */
+	uint64_t nr_compacted;		/*!< Number of 64MB ranges made free */
+	uint64_t nr_compact_moved;	/*!< Number of pages moved by
+					 * compaction */
+	uint64_t frag_index;		/*!< Last fragmentation index,
+					 * in per mille */
+};
+
+/**
+* @brief Reverse mapping from VE page to ATB entry, built for compaction
+*/
+struct ve_migrate_rmap {
+	struct ve_task_struct *tsk;	/*!< Thread group leader mapping page */
+	int dir;			/*!< ATB directory number */
+	int ent;			/*!< ATB entry number */
+};
+
+extern int veos_compact_level;
+
+int amm_migrate_init(void);
+void veos_amm_migrate_thread(void);
+void amm_migrate_get_stat(struct ve_migrate_stat *);
+#endif
@@ -58,6 +58,32 @@ typedef enum ve_dma_status {
 	VE_DMA_STATUS_ERROR,/*!< error occured */
 } ve_dma_status_t;
 
+/**
+ * @brief segment of a vectored DMA request
+ */
+typedef struct ve_dma_seg {
+	uint64_t srcaddr;/*!< source address, 8 byte aligned */
+	uint64_t dstaddr;/*!< destination address, 8 byte aligned */
+	uint64_t length;/*!< transfer length in byte, 8 byte aligned */
+} ve_dma_seg_t;
+
+/**
+ * The number of buckets in DMA completion latency histogram.
+ * Bucket 0 counts requests completed in less than 1 microsecond,
+ * bucket i (0 < i < VE_DMA_LAT_HIST_NBUCKET - 1) counts ones completed in
+ * [2^(i-1), 2^i) microseconds and the last bucket counts the rest.
+ */
+#define VE_DMA_LAT_HIST_NBUCKET 16
+
+/**
+ * @brief statistics of DMA request completion
+ */
+struct ve_dma_stat {
+	uint64_t nr_completed_intr;/*!< requests completed by interrupt */
+	uint64_t nr_completed_poll;/*!< requests completed by polling */
+	uint64_t lat_hist[VE_DMA_LAT_HIST_NBUCKET];/*!< latency histogram */
+};
+
 ve_dma_hdl *ve_dma_open_p(vedl_handle *);
 int ve_dma_close_p(ve_dma_hdl *);
 
@@ -67,6 +93,12 @@ ve_dma_req_hdl *ve_dma_post_p_va(ve_dma_hdl *, ve_dma_addrtype_t, pid_t,
 ve_dma_status_t ve_dma_xfer_p_va(ve_dma_hdl *, ve_dma_addrtype_t, pid_t,
 				 uint64_t, ve_dma_addrtype_t, pid_t, uint64_t,
 				 uint64_t);
+ve_dma_req_hdl *ve_dma_post_p_va_vec(ve_dma_hdl *, ve_dma_addrtype_t, pid_t,
+				     ve_dma_addrtype_t, pid_t,
+				     const ve_dma_seg_t *, int);
+ve_dma_status_t ve_dma_xfer_p_va_vec(ve_dma_hdl *, ve_dma_addrtype_t, pid_t,
+				     ve_dma_addrtype_t, pid_t,
+				     const ve_dma_seg_t *, int);
 
 ve_dma_status_t ve_dma_test(ve_dma_req_hdl *);
 ve_dma_status_t ve_dma_wait(ve_dma_req_hdl *);
@@ -74,4 +106,5 @@ ve_dma_status_t ve_dma_timedwait(ve_dma_req_hdl *, const struct timespec *);
 int ve_dma_req_free(ve_dma_req_hdl *);
 void ve_dma_terminate(ve_dma_req_hdl *);
 void ve_dma_terminate_all(ve_dma_hdl *);
+void ve_dma_get_stat(ve_dma_hdl *, struct ve_dma_stat *);
 #endif
@@ -64,6 +64,8 @@ ve_dma_hdl *ve_dma_open_p(vedl_handle *vh)
 	ret->should_stop = 0;
 	pthread_mutex_init(&ret->mutex, NULL);
 	memset(&ret->req_entry, 0, sizeof(ret->req_entry));
+	ret->bytes_on_desc = 0;
+	memset(&ret->stat, 0, sizeof(ret->stat));
 	ret->control_regs = vedl_mmap_cnt_reg(vh);
 	if (ret->control_regs == MAP_FAILED) {
 		VE_DMA_CRIT("mmap of node control registers failed");
@@ -185,6 +187,115 @@ static int ve_dma_post__check_addr_type(const char *msg, ve_dma_addrtype_t t)
 	}
 }
 
+/**
+ * @brief Check parameters of a DMA request
+ *
+ * @param[in] srctype Address type of source
+ * @param[in] srcaddr source address
+ * @param[in] dsttype Address type of destination
+ * @param[in] dstaddr destination address
+ * @param[in] length transfer length in byte
+ *
+ * @return 0 on success. -EINVAL on invalid parameters.
+ */
+static int ve_dma_post__check_args(ve_dma_addrtype_t srctype, uint64_t srcaddr,
+				   ve_dma_addrtype_t dsttype, uint64_t dstaddr,
+				   uint64_t length)
+{
+	if (!IS_ALIGNED(length, 8)) {
+		VE_DMA_ERROR("Unsupported transfer length (%lu bytes)", length);
+		return -EINVAL;
+	}
+	if (length > VE_DMA_MAX_LENGTH) {
+		VE_DMA_ERROR("Too large transfer length (0x%lx bytes)", length);
+		return -EINVAL;
+	}
+	if (!IS_ALIGNED(srcaddr, 8)) {
+		VE_DMA_ERROR("DMA does not support unaligned "
+			     "source address (0x%016lx)", srcaddr);
+		return -EINVAL;
+	}
+	if (!IS_ALIGNED(dstaddr, 8)) {
+		VE_DMA_ERROR("DMA does not support unaligned "
+			     "destination address (0x%016lx)", dstaddr);
+		return -EINVAL;
+	}
+	if (ve_dma_post__check_addr_type("Source", srctype) != 0) {
+		/* error message is output in ve_dma_post__check_addr_type(). */
+		return -EINVAL;
+	}
+	if (ve_dma_post__check_addr_type("Destination", dsttype) != 0) {
+		/* error message is output in ve_dma_post__check_addr_type(). */
+		return -EINVAL;
+	}
+	return 0;
+}
+
+/**
+ * @brief Create an empty DMA request handle
+ *
+ * @param[in] hdl DMA engine handle to post DMA request
+ *
+ * @return DMA request handle on success. NULL on failure.
+ */
+static ve_dma_req_hdl *ve_dma_post__alloc_req(ve_dma_hdl *hdl)
+{
+	ve_dma_req_hdl *ret;
+
+	ret = malloc(sizeof(*ret));
+	if (ret == NULL) {
+		VE_DMA_ERROR("malloc for DMA request handle failed.");
+		return NULL;
+	}
+	ret->engine = hdl;
+	pthread_cond_init(&ret->cond, NULL);
+	INIT_LIST_HEAD(&ret->reqlist);
+	return ret;
+}
+
+/**
+ * @brief Post DMA reqlist entries of a DMA request and start DMA engine
+ *
+ * @param[in] hdl DMA engine handle to post DMA request
+ * @param[in] req DMA request handle whose reqlist has been made
+ *
+ * @return 0 on success. -1 on failure; req is freed in this case.
+ */
+static int ve_dma_post__submit(ve_dma_hdl *hdl, ve_dma_req_hdl *req)
+{
+	int rv_post;
+
+	pthread_mutex_lock(&hdl->mutex);
+	if (hdl->should_stop) {
+		VE_DMA_ERROR("DMA post failed because DMA engine is now "
+			     "closing");
+		goto error_dma_engine;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &req->post_time);
+	rv_post = ve_dma_reqlist_post(req);
+	if (rv_post < 0) {
+		goto error_post;
+	}
+	/* start DMA engine */
+	ve_dma_hw_start(hdl->vedl_handle, hdl->control_regs);
+
+	veos_commit_rdawr_order();
+	pthread_mutex_unlock(&hdl->mutex);
+
+	return 0;
+
+error_post:
+	ve_dma__terminate_nolock(req);
+error_dma_engine:
+	veos_commit_rdawr_order();
+	pthread_mutex_unlock(&hdl->mutex);
+	ve_dma_reqlist_free(req);
+	pthread_cond_destroy(&req->cond);
+	free(req);
+	return -1;
+}
+
 /**
  * @brief Post a DMA request
  *
@@ -211,7 +322,6 @@ ve_dma_req_hdl *ve_dma_post_p_va(ve_dma_hdl *hdl, ve_dma_addrtype_t srctype,
 {
 	ve_dma_req_hdl *ret;
 	int64_t n_dma_req;
-	int rv_post;
 
 	VE_DMA_TRACE("called");
 	VE_DMA_DEBUG("DMA request is posted. "
@@ -221,35 +331,8 @@ ve_dma_req_hdl *ve_dma_post_p_va(ve_dma_hdl *hdl, ve_dma_addrtype_t srctype,
 		     srctype, (int)srcpid, srcaddr,
 		     dsttype, (int)dstpid, dstaddr, length);
 	/* parameter check */
-	if (!IS_ALIGNED(length, 8)) {
-		VE_DMA_ERROR("Unsupported transfer length (%lu bytes)", length);
-		errno = EINVAL;
-		return NULL;
-	}
-	if (length > VE_DMA_MAX_LENGTH) {
-		VE_DMA_ERROR("Too large transfer length (0x%lx bytes)", length);
-		errno = EINVAL;
-		return NULL;
-	}
-	if (!IS_ALIGNED(srcaddr, 8)) {
-		VE_DMA_ERROR("DMA does not support unaligned "
-			     "source address (0x%016lx)", srcaddr);
-		errno = EINVAL;
-		return NULL;
-	}
-	if (!IS_ALIGNED(dstaddr, 8)) {
-		VE_DMA_ERROR("DMA does not support unaligned "
-			     "destination address (0x%016lx)", dstaddr);
-		errno = EINVAL;
-		return NULL;
-	}
-	if (ve_dma_post__check_addr_type("Source", srctype) != 0) {
-		/* error message is output in ve_dma_post__check_addr_type(). */
-		errno = EINVAL;
-		return NULL;
-	}
-	if (ve_dma_post__check_addr_type("Destination", dsttype) != 0) {
-		/* error message is output in ve_dma_post__check_addr_type(). */
+	if (ve_dma_post__check_args(srctype, srcaddr, dsttype, dstaddr,
+				    length) != 0) {
 		errno = EINVAL;
 		return NULL;
 	}
@@ -257,14 +340,9 @@ ve_dma_req_hdl *ve_dma_post_p_va(ve_dma_hdl *hdl, ve_dma_addrtype_t srctype,
 	/*
 	 * create DMA request handle
 	 */
-	ret = malloc(sizeof(*ret));
-	if (ret == NULL) {
-		VE_DMA_ERROR("malloc for DMA request handle failed.");
+	ret = ve_dma_post__alloc_req(hdl);
+	if (ret == NULL)
 		return NULL;
-	}
-	ret->engine = hdl;
-	pthread_cond_init(&ret->cond, NULL);
-	INIT_LIST_HEAD(&ret->reqlist);
 
 	n_dma_req = ve_dma_reqlist_make(ret, srctype, srcpid, srcaddr, dsttype,
 					dstpid, dstaddr, length);
@@ -283,33 +361,101 @@ ve_dma_req_hdl *ve_dma_post_p_va(ve_dma_hdl *hdl, ve_dma_addrtype_t srctype,
 	/*
 	 * post DMA requests
 	 */
-	pthread_mutex_lock(&hdl->mutex);
-	if (hdl->should_stop) {
-		VE_DMA_ERROR("DMA post failed because DMA engine is now "
-			     "closing");
-		goto error_dma_engine;
+	if (ve_dma_post__submit(hdl, ret) != 0)
+		return NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Post a vectored DMA request
+ *
+ *        All the segments are translated into one DMA request, so that
+ *        their DMA reqlist entries are put on descriptors at once and
+ *        the request completes when the last segment completes.
+ *
+ * @param[in] hdl DMA engine handle to post DMA request
+ * @param[in] srctype Address type of source
+ * @param[in] srcpid Process ID of source. Ignored when srctype is physical
+ *           (VE_DMA_VEMAA, VE_DMA_VERAA or VE_DMA_VHSAA).
+ * @param[in] dsttype Address type of destination
+ * @param[in] dstpid Process ID of destination. Ignored when dsttype is
+ *           physical (VE_DMA_VEMAA, VE_DMA_VERAA or VE_DMA_VHSAA).
+ * @param[in] seg array of segments; addresses and lengths shall be
+ *            8 byte aligned. Zero length segments are skipped.
+ * @param[in] nseg the number of segments
+ *
+ * @return DMA request handle on success. NULL on failure.
+ */
+ve_dma_req_hdl *ve_dma_post_p_va_vec(ve_dma_hdl *hdl,
+				     ve_dma_addrtype_t srctype, pid_t srcpid,
+				     ve_dma_addrtype_t dsttype, pid_t dstpid,
+				     const ve_dma_seg_t *seg, int nseg)
+{
+	ve_dma_req_hdl *ret;
+	int64_t n_dma_req;
+	int64_t total = 0;
+	int i;
+
+	VE_DMA_TRACE("called");
+	VE_DMA_DEBUG("Vectored DMA request is posted. "
+		     "(srctype = %d, srcpid = %d, dsttype = %d, dstpid = %d, "
+		     "nseg = %d)",
+		     srctype, (int)srcpid, dsttype, (int)dstpid, nseg);
+	/* parameter check */
+	if (seg == NULL || nseg <= 0) {
+		VE_DMA_ERROR("No segments are specified");
+		errno = EINVAL;
+		return NULL;
+	}
+	for (i = 0; i < nseg; i++) {
+		if (ve_dma_post__check_args(srctype, seg[i].srcaddr, dsttype,
+					    seg[i].dstaddr,
+					    seg[i].length) != 0) {
+			VE_DMA_ERROR("Segment #%d is invalid", i);
+			errno = EINVAL;
+			return NULL;
+		}
 	}
 
-	rv_post = ve_dma_reqlist_post(ret);
-	if (rv_post < 0) {
-		goto error_post;
+	ret = ve_dma_post__alloc_req(hdl);
+	if (ret == NULL)
+		return NULL;
+
+	for (i = 0; i < nseg; i++) {
+		if (seg[i].length == 0)
+			continue;
+		n_dma_req = ve_dma_reqlist_make(ret, srctype, srcpid,
+						seg[i].srcaddr, dsttype,
+						dstpid, seg[i].dstaddr,
+						seg[i].length);
+		if (n_dma_req <= 0) {
+			VE_DMA_ERROR("Error occured on making DMA reqlist "
+				     "entries of segment #%d. "
+				     "(srcaddr = 0x%016lx, "
+				     "dstaddr = 0x%016lx, length = 0x%lx)",
+				     i, seg[i].srcaddr, seg[i].dstaddr,
+				     seg[i].length);
+			/* entries of preceding segments are also freed. */
+			pthread_cond_destroy(&ret->cond);
+			free(ret);
+			return NULL;
+		}
+		total += n_dma_req;
 	}
-	/* start DMA engine */
-	ve_dma_hw_start(hdl->vedl_handle, hdl->control_regs);
+	if (total == 0) {
+		VE_DMA_ERROR("All the segments are empty");
+		pthread_cond_destroy(&ret->cond);
+		free(ret);
+		errno = EINVAL;
+		return NULL;
+	}
+	VE_DMA_TRACE("%d segments -> %ld DMA reqlist entries", nseg, total);
 
-	veos_commit_rdawr_order();
-	pthread_mutex_unlock(&hdl->mutex);
+	if (ve_dma_post__submit(hdl, ret) != 0)
+		return NULL;
 
 	return ret;
-
-error_post:
-	ve_dma__terminate_nolock(ret);
-error_dma_engine:
-	veos_commit_rdawr_order();
-	pthread_mutex_unlock(&hdl->mutex);
-	ve_dma_reqlist_free(ret);
-	free(ret);
-	return NULL;
 }
 
 /**
@@ -353,6 +499,40 @@ ve_dma_status_t ve_dma_xfer_p_va(ve_dma_hdl *hdl, ve_dma_addrtype_t srctype,
 	return ret;
 }
 
+/**
+ * @brief Synchronous vectored data transfer by DMA
+ *
+ * @param[in] hdl DMA engine handle to post DMA request
+ * @param[in] srctype Address type of source
+ * @param[in] srcpid Process ID of source
+ * @param[in] dsttype Address type of destination
+ * @param[in] dstpid Process ID of destination
+ * @param[in] seg array of segments
+ * @param[in] nseg the number of segments
+ *
+ * @return status of the request:
+ *         VE_DMA_STATUS_OK on success,
+ *         VE_DMA_STATUS_CANCELED at cancellation, and
+ *         VE_DMA_STATUS_ERROR on failure.
+ */
+ve_dma_status_t ve_dma_xfer_p_va_vec(ve_dma_hdl *hdl,
+				     ve_dma_addrtype_t srctype, pid_t srcpid,
+				     ve_dma_addrtype_t dsttype, pid_t dstpid,
+				     const ve_dma_seg_t *seg, int nseg)
+{
+	ve_dma_status_t ret;
+
+	VE_DMA_TRACE("called");
+	ve_dma_req_hdl *req = ve_dma_post_p_va_vec(hdl, srctype, srcpid,
+						   dsttype, dstpid, seg, nseg);
+	if (req == NULL)
+		return VE_DMA_STATUS_ERROR;
+
+	ret = ve_dma_wait(req);
+	ve_dma_req_free(req);
+	return ret;
+}
+
 static ve_dma_status_t ve_dma__test_nolock(ve_dma_req_hdl *req)
 {
 	ve_dma_status_t ret;
@@ -398,6 +578,8 @@ ve_dma_status_t ve_dma_wait(ve_dma_req_hdl *req)
 	VE_DMA_TRACE("called");
 	pthread_mutex_lock(&req->engine->mutex);
 	ret = ve_dma__test_nolock(req);
+	if (ret == VE_DMA_STATUS_NOT_FINISHED)
+		ret = ve_dma__poll_nolock(req);
 	while (ret == VE_DMA_STATUS_NOT_FINISHED &&
 	       req->engine->should_stop == 0) {
 		VE_DMA_TRACE("wait for interrupts");
@@ -414,6 +596,10 @@ ve_dma_status_t ve_dma_wait(ve_dma_req_hdl *req)
 /**
  * @brief Wait for DMA request completion or timedout
  *
+ *        As ve_dma_wait(), completion of a small request is polled for
+ *        up to VE_DMA_POLL_WINDOW_NSEC before sleeping, so the timeout
+ *        is checked after the polling window.
+ *
  * @param req DMA request handle for which the call waits
  *
  * @return state of the DMA request:
@@ -428,6 +614,8 @@ ve_dma_status_t ve_dma_timedwait(ve_dma_req_hdl *req, const struct timespec *t)
 	VE_DMA_TRACE("called");
 	pthread_mutex_lock(&req->engine->mutex);
 	ret = ve_dma__test_nolock(req);
+	if (ret == VE_DMA_STATUS_NOT_FINISHED)
+		ret = ve_dma__poll_nolock(req);
 	while (ret == VE_DMA_STATUS_NOT_FINISHED &&
 	       req->engine->should_stop == 0) {
 		VE_DMA_TRACE("not finished. wait for interrupts");
@@ -586,8 +774,22 @@ void ve_dma_terminate_all(ve_dma_hdl *hdl)
 	hdl->desc_used_begin = ve_dma_hw_get_readptr(hdl->vedl_handle,
 						     hdl->control_regs);
 	hdl->desc_num_used = 0;
+	hdl->bytes_on_desc = 0;
 
 	veos_commit_rdawr_order();
 	pthread_mutex_unlock(&hdl->mutex);
 
 }
+
+/**
+ * @brief Get statistics of DMA request completion
+ *
+ * @param hdl DMA handle
+ * @param[out] stat buffer to store the statistics
+ */
+void ve_dma_get_stat(ve_dma_hdl *hdl, struct ve_dma_stat *stat)
+{
+	pthread_mutex_lock(&hdl->mutex);
+	*stat = hdl->stat;
+	pthread_mutex_unlock(&hdl->mutex);
+}
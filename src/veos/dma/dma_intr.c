@@ -22,6 +22,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include "dma.h"
 #include "dma_private.h"
@@ -32,7 +33,38 @@
 #include "veos.h"
 #include "vesync.h"
 
-static void ve_dma_intr__finish_descriptor(ve_dma_hdl *, int, uint64_t, int);
+static void ve_dma_intr__finish_descriptor(ve_dma_hdl *, int, uint64_t, int,
+					   int);
+
+/**
+ * @brief Account completion latency of a DMA request
+ *
+ * @param dh DMA handle
+ * @param r DMA request handle completed
+ * @param polled non-zero if the completion is found by polling
+ */
+static void ve_dma_intr__account_latency(ve_dma_hdl *dh, ve_dma_req_hdl *r,
+					 int polled)
+{
+	/* note: a caller shall hold dh->mutex */
+	struct timespec now;
+	uint64_t usec;
+	int bucket;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	usec = ((now.tv_sec - r->post_time.tv_sec) * 1000000000L +
+		(now.tv_nsec - r->post_time.tv_nsec)) / 1000;
+	bucket = (usec == 0) ? 0 : (64 - __builtin_clzl(usec));
+	if (bucket >= VE_DMA_LAT_HIST_NBUCKET)
+		bucket = VE_DMA_LAT_HIST_NBUCKET - 1;
+	++dh->stat.lat_hist[bucket];
+	if (polled)
+		++dh->stat.nr_completed_poll;
+	else
+		++dh->stat.nr_completed_intr;
+	VE_DMA_TRACE("request %p completed in %lu usec (%s)", r, usec,
+		     polled ? "polled" : "interrupt");
+}
 
 /**
  * @brief DMA descriptor finalize function
@@ -41,9 +73,11 @@ static void ve_dma_intr__finish_descriptor(ve_dma_hdl *, int, uint64_t, int);
  * @param entry DMA descriptor entry to be finalized
  * @param status Word 0 in the corresponding DMA descriptor
  * @param readptr Read poiter value of DMA control register
+ * @param polled non-zero if the completion is found by polling
  */
 static void ve_dma_intr__finish_descriptor(ve_dma_hdl *dh, int entry,
-					   uint64_t status, int readptr)
+					   uint64_t status, int readptr,
+					   int polled)
 {
 	/*
 	 * note: a caller must stop DMA engine before calling this function
@@ -51,6 +85,7 @@ static void ve_dma_intr__finish_descriptor(ve_dma_hdl *dh, int entry,
 	 */
 	ve_dma_reqlist_entry *e;
 	ve_dma_req_hdl *r;
+	int is_last;
 	VE_DMA_TRACE("Finalize DMA descriptor #%d", entry);
 
 	e = dh->req_entry[entry];
@@ -65,7 +100,14 @@ static void ve_dma_intr__finish_descriptor(ve_dma_hdl *dh, int entry,
 				     entry, status);
 			ve_dma_reqlist__cancel(r);
 		} else {
+			/*
+			 * The last entry has sync bit, so that the request
+			 * is completed when the last entry is completed.
+			 */
+			is_last = ve_dma_reqlist_entry_is_last(e);
 			ve_dma_finish_reqlist_entry(e, status, readptr);
+			if (is_last)
+				ve_dma_intr__account_latency(dh, r, polled);
 		}
 		/*
 		 * wake up the thread waiting for r,
@@ -79,6 +121,199 @@ static void ve_dma_intr__finish_descriptor(ve_dma_hdl *dh, int entry,
 	}
 }
 
+/**
+ * @brief Finalize DMA descriptors completed and post waiting requests
+ *
+ * @param dh DMA handle
+ * @param polled non-zero if the caller found completion by polling
+ */
+static void ve_dma_intr__reap(ve_dma_hdl *dh, int polled)
+{
+	/* note: a caller shall hold dh->mutex */
+	vedl_handle *handle = dh->vedl_handle;
+	int entry;
+	int current_begin, current_used;
+	uint64_t ctlword1;
+	int exc = 0;
+	int readptr;
+
+	VE_DMA_TRACE("DMA control register status = 0x%x",
+		     ve_dma_hw_get_ctlstatus(handle, dh->control_regs));
+
+	/* get exc and readptr */
+	ctlword1 = ve_dma_hw_get_ctlword1(handle, dh->control_regs);
+	if (ctlword1 & VE_DMA_CTL_EXCEPTION_MASK) {
+		exc = 1;
+	};
+	readptr = ctlword1 & VE_DMA_CTL_READ_PTR_MASK;
+	VE_DMA_TRACE("DMA control register word1: exc = %d, "
+		     "readptr = %d",
+		     exc, readptr);
+
+	/*
+	 * desc_used_begin and desc_num_used can be changed
+	 * while finishing request entries.
+	 */
+	current_begin = dh->desc_used_begin;
+	current_used = dh->desc_num_used;
+	VE_DMA_TRACE("desc_used_begin = %d, desc_num_used = %d",
+		     current_begin, current_used);
+	if (exc == 0) {
+		/*
+		 * When exc = 0, descriptors between desc_used_begin and
+		 * readptr must be completed without exception.
+		 */
+		for (entry = current_begin; entry != readptr;
+		     entry = (entry + 1) % VE_DMA_NUM_DESC) {
+			ve_dma_intr__finish_descriptor(
+			dh, entry, VE_DMA_DESC_STATUS_COMPLETED,
+			readptr, polled);
+		}
+		ve_dma_free_used_desc(dh, readptr);
+	} else { /* exc == 1 */
+		/*
+		 * When exc = 1, descriptors between desc_used_begin and
+		 * readptr must be completed and any of these caused
+		 * exception.
+		 */
+		/* stop DMA engine and refresh readptr */
+		ve_dma__stop_engine(dh);
+		ctlword1 = ve_dma_hw_get_ctlword1(handle,
+						  dh->control_regs);
+		VE_DMA_ASSERT(ctlword1 & VE_DMA_CTL_EXCEPTION_MASK);
+		readptr = ctlword1 & VE_DMA_CTL_READ_PTR_MASK;
+		VE_DMA_TRACE("DMA control register word1: exc = %d, "
+			     "readptr = %d", exc, readptr);
+		for (entry = current_begin; entry != readptr;
+		     entry = (entry + 1) % VE_DMA_NUM_DESC) {
+			uint64_t status;
+			status = ve_dma_hw_desc_status(dh->vedl_handle,
+						       dh->control_regs,
+						       entry);
+			VE_DMA_ASSERT(status &
+				      VE_DMA_DESC_STATUS_COMPLETED);
+			ve_dma_intr__finish_descriptor(dh, entry,
+						       status, readptr,
+						       polled);
+		}
+		ve_dma_free_used_desc(dh, readptr);
+		/* clear exc bit */
+		ve_dma_hw_set_readptr(handle, dh->control_regs,
+				      readptr);
+		/* restart DMA engine */
+		if (dh->should_stop == 0 && dh->desc_num_used > 0) {
+			ve_dma_hw_start(dh->vedl_handle,
+					dh->control_regs);
+		}
+		veos_commit_rdawr_order();
+	}
+	/* post requests to free descriptors */
+	ve_dma__drain_waiting_list(dh);
+}
+
+/**
+ * @brief Check whether completion of DMA descriptors should be polled
+ *
+ *        Only small requests are polled: for large requests, the
+ *        interrupt latency is negligible compared with the transfer.
+ *
+ * @param dh DMA handle
+ *
+ * @return non-zero if polling is worthwhile.
+ */
+static int ve_dma_intr__pollable(ve_dma_hdl *dh)
+{
+	/* note: a caller shall hold dh->mutex */
+	return dh->should_stop == 0 && dh->desc_num_used > 0 &&
+	       dh->bytes_on_desc <= VE_DMA_POLL_MAX_BYTES &&
+	       list_empty(&dh->waiting_list);
+}
+
+/**
+ * @brief Spin on the read pointer until it moves or the window expires
+ *
+ * @param dh DMA handle
+ * @param begin desc_used_begin when the caller released dh->mutex
+ * @param deadline end of the polling window (CLOCK_MONOTONIC)
+ *
+ * @return 1 if the read pointer moved or an exception occurred,
+ *         0 if the polling window expired.
+ */
+static int ve_dma_intr__spin(ve_dma_hdl *dh, int begin,
+			     const struct timespec *deadline)
+{
+	/* note: a caller shall not hold dh->mutex */
+	struct timespec now;
+	uint64_t ctlword1;
+
+	for (;;) {
+		ctlword1 = ve_dma_hw_get_ctlword1(dh->vedl_handle,
+						  dh->control_regs);
+		if ((ctlword1 & VE_DMA_CTL_EXCEPTION_MASK) ||
+		    (int)(ctlword1 & VE_DMA_CTL_READ_PTR_MASK) != begin)
+			return 1;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if (now.tv_sec > deadline->tv_sec ||
+		    (now.tv_sec == deadline->tv_sec &&
+		     now.tv_nsec >= deadline->tv_nsec))
+			return 0;
+	}
+}
+
+/**
+ * @brief Poll completion of small DMA requests for a bounded window
+ *
+ * @param dh DMA handle
+ * @param req DMA request handle to wait for;
+ *        NULL to poll while any small requests are on descriptors.
+ *
+ * @return 1 if any descriptors are finalized by polling, 0 otherwise.
+ */
+static int ve_dma_intr__poll(ve_dma_hdl *dh, ve_dma_req_hdl *req)
+{
+	/* note: a caller shall hold dh->mutex */
+	struct timespec deadline;
+	int begin;
+	int progress;
+	int reaped = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_nsec += VE_DMA_POLL_WINDOW_NSEC;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec += 1;
+		deadline.tv_nsec -= 1000000000L;
+	}
+	while (ve_dma_intr__pollable(dh)) {
+		if (req != NULL &&
+		    ve_dma_reqlist_test(req) != VE_DMA_STATUS_NOT_FINISHED)
+			break;
+		begin = dh->desc_used_begin;
+		/* spin without the lock not to block posters */
+		pthread_mutex_unlock(&dh->mutex);
+		progress = ve_dma_intr__spin(dh, begin, &deadline);
+		pthread_mutex_lock(&dh->mutex);
+		if (!progress)
+			break;
+		ve_dma_intr__reap(dh, 1);
+		reaped = 1;
+	}
+	return reaped;
+}
+
+/**
+ * @brief Poll completion of a DMA request before sleeping on it
+ *
+ * @param req DMA request handle
+ *
+ * @return status of the DMA request
+ */
+ve_dma_status_t ve_dma__poll_nolock(ve_dma_req_hdl *req)
+{
+	/* note: a caller shall hold req->engine->mutex */
+	ve_dma_intr__poll(req->engine, req);
+	return ve_dma_reqlist_test(req);
+}
+
 /**
  * @brief DMA interrupt handler thread function
  *
@@ -93,11 +328,6 @@ void *ve_dma_intr_helper(void *arg)
 	vedl_handle *handle = dh->vedl_handle;
 	while (!dh->should_stop) {
 		int ret_intr;
-		int entry;
-		int current_begin, current_used;
-		uint64_t ctlword1;
-		int exc = 0;
-		int readptr;
 		struct timespec timo = { .tv_sec = 1, .tv_nsec = 0};
 		ret_intr = vedl_wait_interrupt(handle, VE_INTR_P_DMA,
 					      &timo);
@@ -123,78 +353,13 @@ void *ve_dma_intr_helper(void *arg)
 		}
 		/* which request is finished? */
 		pthread_mutex_lock(&dh->mutex);
-		VE_DMA_TRACE("DMA control register status = 0x%x",
-			     ve_dma_hw_get_ctlstatus(handle,
-						     dh->control_regs));
-
-		/* get exc and readptr */
-		ctlword1 = ve_dma_hw_get_ctlword1(handle, dh->control_regs);
-		if (ctlword1 & VE_DMA_CTL_EXCEPTION_MASK) {
-			exc = 1;
-		};
-		readptr = ctlword1 & VE_DMA_CTL_READ_PTR_MASK;
-		VE_DMA_TRACE("DMA control register word1: exc = %d, "
-			     "readptr = %d",
-			     exc, readptr);
-
+		ve_dma_intr__reap(dh, 0);
 		/*
-		 * desc_used_begin and desc_num_used can be changed
-		 * while finishing request entries.
+		 * Interrupt mitigation: when only small requests remain,
+		 * they are likely to finish soon. Poll them instead of
+		 * taking one more interrupt for each.
 		 */
-		current_begin = dh->desc_used_begin;
-		current_used = dh->desc_num_used;
-		VE_DMA_TRACE("desc_used_begin = %d, desc_num_used = %d",
-			     current_begin, current_used);
-		if (exc == 0) {
-			/*
-			 * When exc = 0, descriptors between desc_used_begin and
-			 * readptr must be completed without exception.
-			 */
-			for (entry = current_begin; entry != readptr;
-			     entry = (entry + 1) % VE_DMA_NUM_DESC) {
-				ve_dma_intr__finish_descriptor(
-				dh, entry, VE_DMA_DESC_STATUS_COMPLETED,
-				readptr);
-			}
-			ve_dma_free_used_desc(dh, readptr);
-		} else { /* exc == 1 */
-			/*
-			 * When exc = 1, descriptors between desc_used_begin and
-			 * readptr must be completed and any of these caused
-			 * exception.
-			 */
-			/* stop DMA engine and refresh readptr */
-			ve_dma__stop_engine(dh);
-			ctlword1 = ve_dma_hw_get_ctlword1(handle,
-							  dh->control_regs);
-			VE_DMA_ASSERT(ctlword1 & VE_DMA_CTL_EXCEPTION_MASK);
-			readptr = ctlword1 & VE_DMA_CTL_READ_PTR_MASK;
-			VE_DMA_TRACE("DMA control register word1: exc = %d, "
-				     "readptr = %d", exc, readptr);
-			for (entry = current_begin; entry != readptr;
-			     entry = (entry + 1) % VE_DMA_NUM_DESC) {
-				uint64_t status;
-				status = ve_dma_hw_desc_status(dh->vedl_handle,
-							       dh->control_regs,
-							       entry);
-				VE_DMA_ASSERT(status &
-					      VE_DMA_DESC_STATUS_COMPLETED);
-				ve_dma_intr__finish_descriptor(dh, entry,
-							       status, readptr);
-			}
-			ve_dma_free_used_desc(dh, readptr);
-			/* clear exc bit */
-			ve_dma_hw_set_readptr(handle, dh->control_regs,
-					      readptr);
-			/* restart DMA engine */
-			if (dh->should_stop == 0 && dh->desc_num_used > 0) {
-				ve_dma_hw_start(dh->vedl_handle,
-						dh->control_regs);
-			}
-			veos_commit_rdawr_order();
-		}
-		/* post requests to free descriptors */
-		ve_dma__drain_waiting_list(dh);
+		ve_dma_intr__poll(dh, NULL);
 		pthread_mutex_unlock(&dh->mutex);
 	}
 	return (void *)0L;
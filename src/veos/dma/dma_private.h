@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <pthread.h>
+#include <time.h>
 #include <libved.h>
 
 #include "ve_list.h"
@@ -45,6 +46,15 @@
 #define VE_PAGE_MASK (~(VE_PAGE_SIZE - 1))
 #define VH_PAGE_ALIGN(addr) ((addr) & VH_PAGE_MASK)
 
+/**
+ * Adaptive polling: while no more than VE_DMA_POLL_MAX_BYTES are on
+ * DMA descriptors, completion is polled on the read pointer for up to
+ * VE_DMA_POLL_WINDOW_NSEC before falling back to the interrupt.
+ * The threshold covers register DMA of a whole core context.
+ */
+#define VE_DMA_POLL_MAX_BYTES (256 * 1024)
+#define VE_DMA_POLL_WINDOW_NSEC (50 * 1000)
+
 /**
  * msg should include only one '%s' specifier for printf(3)-family,
  * converted to an error message by strerror(3).
@@ -71,6 +81,8 @@ struct ve_dma_hdl_struct {
 	int desc_num_used;/*!< the number of used DMA descriptors */
 	struct ve_dma_reqlist_entry *req_entry[VE_DMA_NUM_DESC];/*!< DMA reqlist entry on each DMA descriptor */
 	system_common_reg_t *control_regs;/*!< pointer to node control registers area */
+	uint64_t bytes_on_desc;/*!< total transfer length posted on DMA descriptors */
+	struct ve_dma_stat stat;/*!< completion statistics */
 };
 
 /**
@@ -80,10 +92,12 @@ struct ve_dma_req_hdl_struct {
 	struct ve_dma_hdl_struct *engine;/*!< DMA engine on which this request is posted */
 	pthread_cond_t cond;/*!< condition variable to wait for status of DMA reqlist entries in reqlist to change */
 	struct list_head reqlist;/*!< a list of DMA reqlist entries composing this request */
+	struct timespec post_time;/*!< time when this request is posted */
 };
 
 /* in dma_intr.c */
 void ve_dma__drain_waiting_list(ve_dma_hdl *);
 void ve_dma__stop_engine(ve_dma_hdl *);
+ve_dma_status_t ve_dma__poll_nolock(ve_dma_req_hdl *);
 
 #endif
@@ -381,7 +381,9 @@ static int addr_cont(const ve_dma__addr *addr_pre, uint32_t length,
  * @brief Divide a DMA request into one or more physical requests
  *
  *        Divide a specified DMA request at page boundaries into
- *        one or more DMA reqlist entries.
+ *        one or more DMA reqlist entries, appended to the reqlist
+ *        of the DMA request handle. On failure, all the entries in
+ *        the reqlist are freed.
  *
  * @param[in,out] hdl DMA request handle
  *        hdl->reqlist is updated when returning this function.
@@ -408,7 +410,6 @@ int64_t ve_dma_reqlist_make(ve_dma_req_hdl *hdl, ve_dma_addrtype_t srctype,
 		     "length = 0x%lx)",
 		     srctype, srcpid, srcaddr, dsttype, dstpid, dstaddr,
 		     length);
-	VE_DMA_ASSERT(list_empty(&hdl->reqlist));
 	vedl_handle *vh = hdl->engine->vedl_handle;
 	struct ve_dma_vemtlb vemtlb_src = { .vaddr = (uint64_t)NULL };
 	struct ve_dma_vemtlb vemtlb_dst = { .vaddr = (uint64_t)NULL };
@@ -635,7 +636,7 @@ int ve_dma_reqlist__entry_post(ve_dma_reqlist_entry *e)
 	hdl->req_entry[entry] = e;
 	e->entry = entry;
 
-	is_last = (e->req_head->reqlist.prev == &e->list);
+	is_last = ve_dma_reqlist_entry_is_last(e);
 
 	ret = ve_dma_hw_post_dma(hdl->vedl_handle, hdl->control_regs, entry,
 				 e->src.type_hw, e->src.addr, e->dst.type_hw,
@@ -650,6 +651,7 @@ int ve_dma_reqlist__entry_post(ve_dma_reqlist_entry *e)
 	} else {
 		e->status = VE_DMA_ENTRY_ONGOING;
 		++hdl->desc_num_used;
+		hdl->bytes_on_desc += e->length;
 	}
 
 	return ret;
@@ -781,6 +783,7 @@ void ve_dma_finish_reqlist_entry(ve_dma_reqlist_entry *e, uint64_t status,
 	VE_DMA_TRACE("Status of request %p <- %d", e, e->status);
 	e->entry = -1;
 	dh->req_entry[entry] = NULL;
+	dh->bytes_on_desc -= e->length;
 	VE_DMA_TRACE("desc_used_begin = %d, desc_num_used = %d",
 		     dh->desc_used_begin, dh->desc_num_used);
 	ve_dma_free_used_desc(dh, readptr);
@@ -868,3 +871,15 @@ ve_dma_req_hdl *ve_dma_waiting_list_head_to_req_hdl(const struct list_head *lh)
 	e = list_entry(lh, ve_dma_reqlist_entry, waiting_list);
 	return ve_dma_reqlist_entry_to_req_hdl(e);
 }
+
+/**
+ * @brief Check whether a DMA reqlist entry is the last one in its request
+ *
+ * @param[in] e DMA reqlist entry
+ *
+ * @return non-zero if e is the last entry, which has sync bit.
+ */
+int ve_dma_reqlist_entry_is_last(const ve_dma_reqlist_entry *e)
+{
+	return e->req_head->reqlist.prev == &e->list;
+}
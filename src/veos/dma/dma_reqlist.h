@@ -38,5 +38,6 @@ int ve_dma_reqlist_drain_waiting_list(ve_dma_hdl *);
 void ve_dma_reqlist__cancel(ve_dma_req_hdl *);
 void ve_dma_finish_reqlist_entry(ve_dma_reqlist_entry *, uint64_t, int);
 ve_dma_req_hdl *ve_dma_reqlist_entry_to_req_hdl(ve_dma_reqlist_entry *);
+int ve_dma_reqlist_entry_is_last(const ve_dma_reqlist_entry *);
 ve_dma_req_hdl *ve_dma_waiting_list_head_to_req_hdl(const struct list_head *);
 #endif
@@ -488,6 +488,78 @@ hndl_return:
 	return retval;
 }
 
+/**
+ * @brief Handles the VE_DMA_STAT request from RPM command.
+ *
+ * @param[in] pti Contains the request message received from RPM command
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int rpm_handle_dma_stat_req(struct veos_thread_arg *pti)
+{
+	int retval = -1;
+	int i;
+	struct ve_dma_stat stat;
+	struct velib_dma_stat dma_stat = {0};
+	struct ve_node_struct *p_ve_node = NULL;
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return;
+
+	p_ve_node = VE_NODE(0);
+
+	ve_dma_get_stat(p_ve_node->dh, &stat);
+	dma_stat.nr_completed_intr = stat.nr_completed_intr;
+	dma_stat.nr_completed_poll = stat.nr_completed_poll;
+	for (i = 0; i < VE_DMA_LAT_HIST_NBUCKET; i++)
+		dma_stat.lat_hist[i] = stat.lat_hist[i];
+
+	/* Send the response back to RPM command */
+	retval = veos_rpm_send_cmd_ack(pti->socket_descriptor,
+			(uint8_t *)&dma_stat, sizeof(struct velib_dma_stat), 0);
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Handles the VE_MEMPOOL_INFO request from RPM command.
+ *
+ * @param[in] pti Contains the request message received from RPM command
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int rpm_handle_mempool_info_req(struct veos_thread_arg *pti)
+{
+	int retval = -1;
+	struct velib_mempool_info pool = {0};
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return;
+
+	retval = veos_mempool_info(&pool);
+	if (0 > retval) {
+		VEOS_ERROR("Populating information failed");
+		VEOS_DEBUG("AMM populate mempool info struct returned %d",
+				retval);
+		goto hndl_return1;
+	}
+
+	retval = 0;
+hndl_return1:
+	/* Send the response back to RPM command */
+	retval = veos_rpm_send_cmd_ack(pti->socket_descriptor,
+			(uint8_t *)&pool, sizeof(struct velib_mempool_info),
+			retval);
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Handles the VE_PIDSTATM_INFO request from RPM command.
  *
@@ -646,6 +718,132 @@ hndl_return1:
 	return retval;
 }
 
+/**
+ * @brief Handles the VE_CPUTIME_NS_INFO request from RPM command.
+ *
+ * @param[in] pti Contains the request message received from RPM command
+ *
+ * @return 0 on success, -errno on failure.
+ */
+int rpm_handle_cputime_ns_req(struct veos_thread_arg *pti)
+{
+	int retval = -1;
+	int pid = -1;
+	ProtobufCBinaryData rpm_pseudo_msg = {0};
+	struct velib_cputime_ns cputime = {0};
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return1;
+
+	pid = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->ve_pid;
+	rpm_pseudo_msg = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->
+		pseudo_msg;
+	if (rpm_pseudo_msg.data)
+		memcpy(&cputime, rpm_pseudo_msg.data,
+			(rpm_pseudo_msg.len < sizeof(cputime)) ?
+			rpm_pseudo_msg.len : sizeof(cputime));
+
+	/* PSM will populate the struct velib_cputime_ns */
+	retval = psm_rpm_handle_cputime_ns_req(pid, &cputime);
+	if (0 > retval) {
+		VEOS_ERROR("Populating information failed for PID: %d",
+				pid);
+		VEOS_DEBUG("PSM populate cputime struct returned %d", retval);
+		goto hndl_return;
+	}
+
+	retval = 0;
+hndl_return:
+	/* Send the response back to RPM command */
+	retval = veos_rpm_send_cmd_ack(pti->socket_descriptor,
+			(uint8_t *)&cputime, sizeof(struct velib_cputime_ns),
+			retval);
+hndl_return1:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Handles the VE_ACCT_STAT request from RPM command.
+ *
+ * @param[in] pti Contains the request message received from RPM command
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int rpm_handle_acct_stat_req(struct veos_thread_arg *pti)
+{
+	int retval = -1;
+	struct velib_acct_stat acct_stat = {0};
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return1;
+
+	/* PSM will populate the struct velib_acct_stat */
+	retval = psm_rpm_handle_acct_stat_req(&acct_stat);
+	if (-1 == retval) {
+		VEOS_ERROR("Populating information failed");
+		VEOS_DEBUG("PSM populate accounting struct returned %d",
+				retval);
+		retval = -EFAULT;
+		goto hndl_return;
+	}
+
+	retval = 0;
+hndl_return:
+	/* Send the response back to RPM command */
+	retval = veos_rpm_send_cmd_ack(pti->socket_descriptor,
+			(uint8_t *)&acct_stat, sizeof(struct velib_acct_stat),
+			retval);
+hndl_return1:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Handles the VE_CORE_LAT_INFO request from RPM command.
+ *
+ * @param[in] pti Contains the request message received from RPM command
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int rpm_handle_core_lat_req(struct veos_thread_arg *pti)
+{
+	int retval = -1;
+	struct velib_core_lat core_lat = { {{0}} };
+	struct ve_node_struct *p_ve_node = NULL;
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return1;
+
+	p_ve_node = VE_NODE(0);
+
+	/* PSM will populate the struct velib_core_lat */
+	retval = psm_rpm_handle_core_lat_req(p_ve_node, &core_lat);
+	if (-1 == retval) {
+		VEOS_ERROR("Populating information failed");
+		VEOS_DEBUG("PSM populate core latency struct returned %d",
+				retval);
+		retval = -EFAULT;
+		goto hndl_return;
+	}
+
+	retval = 0;
+hndl_return:
+	/* Send the response back to RPM command */
+	retval = veos_rpm_send_cmd_ack(pti->socket_descriptor,
+			(uint8_t *)&core_lat, sizeof(struct velib_core_lat),
+			retval);
+hndl_return1:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Handles the VE_GET_RUSAGE request from RPM command.
  *
@@ -1461,6 +1659,46 @@ int veos_rpm_hndl_cmd_req(struct veos_thread_arg *pti)
 			goto hndl_return;
 		}
 		break;
+	case VE_DMA_STAT:
+		VEOS_DEBUG("RPM request : DMA_STAT");
+		retval = rpm_handle_dma_stat_req(pti);
+		if (0 > retval) {
+			VEOS_ERROR("Query request failed");
+			goto hndl_return;
+		}
+		break;
+	case VE_MEMPOOL_INFO:
+		VEOS_DEBUG("RPM request : MEMPOOL_INFO");
+		retval = rpm_handle_mempool_info_req(pti);
+		if (0 > retval) {
+			VEOS_ERROR("Query request failed");
+			goto hndl_return;
+		}
+		break;
+	case VE_CORE_LAT_INFO:
+		VEOS_DEBUG("RPM request : CORE_LAT_INFO");
+		retval = rpm_handle_core_lat_req(pti);
+		if (0 > retval) {
+			VEOS_ERROR("Query request failed");
+			goto hndl_return;
+		}
+		break;
+	case VE_CPUTIME_NS_INFO:
+		VEOS_DEBUG("RPM request : CPUTIME_NS_INFO");
+		retval = rpm_handle_cputime_ns_req(pti);
+		if (0 > retval) {
+			VEOS_ERROR("Query request failed");
+			goto hndl_return;
+		}
+		break;
+	case VE_ACCT_STAT:
+		VEOS_DEBUG("RPM request : ACCT_STAT");
+		retval = rpm_handle_acct_stat_req(pti);
+		if (0 > retval) {
+			VEOS_ERROR("Query request failed");
+			goto hndl_return;
+		}
+		break;
 	case VE_RPM_INVALID:
 		VEOS_ERROR("Invalid query request failed");
 		retval = -1;
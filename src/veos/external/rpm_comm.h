@@ -58,6 +58,11 @@ enum veos_rpm_subcmd {
 	VE_CREATE_PROCESS,
 	VE_SHM_RMLS,
 	VE_GET_REGVALS,
+	VE_DMA_STAT,
+	VE_MEMPOOL_INFO,
+	VE_CORE_LAT_INFO,
+	VE_CPUTIME_NS_INFO,
+	VE_ACCT_STAT,
 	VE_RPM_INVALID = -1
 };
 
@@ -387,6 +392,65 @@ struct velib_prlimit {
 				*/
 };
 
+/**
+ * @brief Structure to get statistics of DMA request completion on VE node
+ */
+struct velib_dma_stat {
+	unsigned long long nr_completed_intr;	/*!< Requests completed by interrupt */
+	unsigned long long nr_completed_poll;	/*!< Requests completed by polling */
+	unsigned long long lat_hist[VE_DMA_LAT_HIST_NBUCKET];	/*!<
+							 * Completion latency
+							 * histogram, see
+							 * VE_DMA_LAT_HIST_NBUCKET
+							 */
+};
+
+/**
+ * @brief Structure to get the state of free VE memory of VE node
+ */
+struct velib_mempool_info {
+	unsigned long kb_dirty;		/*!< Freed memory waiting to be cleared */
+	unsigned long kb_ready_large;	/*!< Cleared free memory available
+					 * as 2MB pages */
+	unsigned long kb_ready_huge;	/*!< Cleared free memory available
+					 * as 64MB pages */
+	unsigned long frag_index;	/*!< Per mille of ready memory which
+					 * can not be used as 64MB pages */
+	unsigned long nr_compacted;	/*!< 64MB blocks rebuilt by
+					 * compaction */
+};
+
+/**
+ * @brief Structure to get latency histograms of VE cores
+ */
+struct velib_core_lat {
+	unsigned long halt_lat[VE_MAX_CORE_PER_NODE][VE_CORE_LAT_HIST_NR];
+					/*!< Histogram of core halt latency */
+	unsigned long start_lat[VE_MAX_CORE_PER_NODE][VE_CORE_LAT_HIST_NR];
+					/*!< Histogram of core start latency */
+};
+
+/**
+ * @brief Structure to get CPU time of VE process in nanoseconds
+ */
+struct velib_cputime_ns {
+	bool whole;			/*!< Flag for single thread (0) or
+					  the whole thread group (1) */
+	unsigned long long utime_ns;	/*!< CPU time of process in ns */
+	unsigned long long cutime_ns;	/*!< CPU time of waited children in ns */
+};
+
+/**
+ * @brief Structure to get statistics of VE process accounting
+ */
+struct velib_acct_stat {
+	bool active;			/*!< Accounting is enabled */
+	unsigned long long nr_written;	/*!< Records written to files */
+	unsigned long long nr_dropped;	/*!< Records dropped because queue
+					 * was full or writing them failed */
+	unsigned long long nr_pending;	/*!< Records waiting in queue */
+};
+
 struct velib_create_process {
 	int flag;      /*!< Flag to preserve the task struct for resource usage */
 	int vedl_fd;    /*!< FD from VE Driver */
@@ -418,4 +482,9 @@ int rpm_handle_prlimit_req(struct veos_thread_arg *);
 int rpm_handle_acctinfo_req(struct veos_thread_arg *);
 int rpm_handle_ipc_ls_rm_req(struct veos_thread_arg *);
 int rpm_handle_get_regvals_req(struct veos_thread_arg *pti);
+int rpm_handle_dma_stat_req(struct veos_thread_arg *);
+int rpm_handle_mempool_info_req(struct veos_thread_arg *);
+int rpm_handle_core_lat_req(struct veos_thread_arg *);
+int rpm_handle_cputime_ns_req(struct veos_thread_arg *);
+int rpm_handle_acct_stat_req(struct veos_thread_arg *);
 #endif
@@ -62,19 +62,19 @@ veos_ived_log4c_init(void)
 }
 
 /**
- * @brief Send a ACK/NACK to a clinet
+ * @brief Send a ACK/NACK with arbitrary data to a clinet
  *
  * @param [in]   result		Return value or -errno
  *                              (will be return to VE program)
- * @param [in]   reply		Return value  (It can be NULL.)
+ * @param [in]   reply		Return data  (It can be NULL.)
+ * @param [in]   reply_len	Length of reply
  * @param [in]   pti		veos_thread_arg_t
  *
  * @return 0 on success,  -1 on failure
  */
-
 int
-veos_ived_reply(int64_t result, struct ived_sub_reply *reply,
-		veos_thread_arg_t *pti)
+veos_ived_reply_data(int64_t result, void *reply, size_t reply_len,
+		     veos_thread_arg_t *pti)
 {
 	int ret, retval = -1;
 	int sd;
@@ -95,7 +95,7 @@ veos_ived_reply(int64_t result, struct ived_sub_reply *reply,
 	sd = pti->socket_descriptor;
 
 	if (reply != NULL){
-		reply_data.len =  sizeof(struct ived_sub_reply);
+		reply_data.len =  reply_len;
 		reply_data.data = (uint8_t *)reply;
 		reply_msg.has_pseudo_msg = 1;
 		reply_msg.pseudo_msg = reply_data;
@@ -125,6 +125,24 @@ err_ret_nofree:
 	return (retval);
 }
 
+/**
+ * @brief Send a ACK/NACK to a clinet
+ *
+ * @param [in]   result		Return value or -errno
+ *                              (will be return to VE program)
+ * @param [in]   reply		Return value  (It can be NULL.)
+ * @param [in]   pti		veos_thread_arg_t
+ *
+ * @return 0 on success,  -1 on failure
+ */
+int
+veos_ived_reply(int64_t result, struct ived_sub_reply *reply,
+		veos_thread_arg_t *pti)
+{
+	return(veos_ived_reply_data(result, reply,
+				    sizeof(struct ived_sub_reply), pti));
+}
+
 
 /**
  * @brief Search ived_shared_resource_data from ived_task_list
@@ -36,6 +36,8 @@
 extern int veos_ived_log4c_init(void);
 extern int veos_ived_reply(int64_t, struct ived_sub_reply *, 
 			   veos_thread_arg_t *);
+extern int veos_ived_reply_data(int64_t, void *, size_t,
+				veos_thread_arg_t *);
 struct ived_shared_resource_data *search_ived_resource_data(pid_t);
 
 #endif
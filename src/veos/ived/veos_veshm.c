@@ -26,6 +26,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -114,6 +115,65 @@ check_mem_pgmode(int pid, int64_t vemva, int64_t size)
 	return(0);
 }
 
+/**
+ * @brief Translate an area into runs of physical addresses
+ *
+ * The runs array is allocated by this function and must be freed
+ * by a caller.
+ *
+ * @param [in]		pid     PID
+ * @param [in]		vemva	Start VEMVA
+ * @param [in]		size	Size of an area
+ * @param [out]		runs	Address of runs array
+ *
+ * @return Number of runs on success, negative value on failure
+ */
+static int
+veshm_virt_to_phy_runs(pid_t pid, uint64_t vemva, uint64_t size,
+		       struct ve_phys_run **runs)
+{
+	int nr_run, ret;
+
+	/* The smallest page is 2MB. A misaligned area touches one more. */
+	nr_run = (size >> SHFT_2M) + 2;
+	*runs = malloc(sizeof(struct ve_phys_run) * nr_run);
+	if (*runs == NULL){
+		IVED_CRIT(log4cat_veos_ived, "Buffer allocation failed");
+		return (-ENOMEM);
+	}
+
+	ret = veos_virt_to_phy_range(vemva, size, pid, false, *runs, nr_run);
+	if (ret < 0){
+		free(*runs);
+		*runs = NULL;
+	}
+	return (ret);
+}
+
+/**
+ * @brief Get physical address at an offset of an area from its runs
+ *
+ * Offsets must be passed in increasing order with the same cursor.
+ *
+ * @param [in]		runs    Runs of an area
+ * @param [in]		nr_run  Number of runs
+ * @param [in]		off     Offset from start of an area
+ * @param [in,out]	r       Cursor: index of current run
+ * @param [in,out]	run_off Cursor: offset of current run
+ *
+ * @return Physical address
+ */
+static uint64_t
+veshm_run_paddr(struct ve_phys_run *runs, int nr_run, uint64_t off,
+		int *r, uint64_t *run_off)
+{
+	while (*r < nr_run - 1 && off >= *run_off + runs[*r].size){
+		*run_off += runs[*r].size;
+		(*r)++;
+	}
+	return (runs[*r].vemaa + (off - *run_off));
+}
+
 /**
  * @brief Check permission of all pages which are included in an area
  * If an area includes Read Only page, this function returns failure.
@@ -129,34 +189,34 @@ int
 check_mem_perm(int pid, int64_t vemva, int64_t size, int prot)
 {
 	int i;
-	int check_num = -1;
-	int64_t paddr = -1;
-	int atb_prot;
+	int nr_run = -1;
+	struct ve_phys_run *runs = NULL;
 
 	if (pid < 0 || vemva < 0 || size < 0 || prot < 0){
 		IVED_ERROR(log4cat_veos_ived, 
 			   "Getting page permission failed");
 		return (-1);
 	}
+	if (size == 0)
+		return(0);
 
-	/* Test page size per 2MB size. */
-	check_num = (size + (PGSIZE_2M - 1)) >> SHFT_2M;
+	nr_run = veshm_virt_to_phy_runs(pid, vemva, size, &runs);
+	if (nr_run < 0){
+		IVED_DEBUG(log4cat_veos_ived, 
+			   "Permission check failed");
+		return (-1);
+	}
 
-	for (i = 0; i < check_num; i++){
-		paddr = veos_virt_to_phy(vemva + PGSIZE_2M * i, pid, false, 
-					 &atb_prot);
-		if (paddr == -1){
-			IVED_DEBUG(log4cat_veos_ived, 
-				   "Permission check failed");
-			return (-1);
-		}
-		if (atb_prot != prot){
+	for (i = 0; i < nr_run; i++){
+		if (runs[i].prot != prot){
 			IVED_DEBUG(log4cat_veos_ived, 
 				   "Permissions are not matched");
+			free(runs);
 			return (-1);
 		}
 	}
 
+	free(runs);
 	return(0);
 }
 
@@ -178,12 +238,12 @@ int
 create_veshm_paddr_array(pid_t pid, uint64_t start_vemva, int64_t size,
 			 uint64_t pgsize, uint64_t *array)
 {
-	int offset;
-	uint64_t cur_vemva;
-	uint64_t paddr;
-	int64_t rest_size;
-	int atb_prot;
+	int i;
+	int nr_run;
 	int pgnum = 0;
+	int r = 0;
+	uint64_t run_off = 0;
+	struct ve_phys_run *runs = NULL;
 
 	if (array == NULL){
 		assert(0);
@@ -195,26 +255,22 @@ create_veshm_paddr_array(pid_t pid, uint64_t start_vemva, int64_t size,
 			   "Specified size is invalid: %"PRId64"", size);
 		return (-1);
 	}
+	if (size == 0)
+		return(0);
 
-	cur_vemva = start_vemva;
-	rest_size = size;
-	offset = 0;
-
-	while (rest_size > 0){
-		paddr = veos_virt_to_phy(cur_vemva, pid, false, &atb_prot);
-		if (paddr == -1){
-			IVED_DEBUG(log4cat_veos_ived, 
-				   "Address translation failed.");
-			return (-1);
-		}
-		*(array + offset) = paddr;
-
-		rest_size -= pgsize;
-		cur_vemva += pgsize;
-		offset++;
-		pgnum++;
+	nr_run = veshm_virt_to_phy_runs(pid, start_vemva, size, &runs);
+	if (nr_run < 0){
+		IVED_DEBUG(log4cat_veos_ived, 
+			   "Address translation failed.");
+		return (-1);
 	}
 
+	pgnum = (size + pgsize - 1) / pgsize;
+	for (i = 0; i < pgnum; i++)
+		*(array + i) = veshm_run_paddr(runs, nr_run, pgsize * i,
+					       &r, &run_off);
+	free(runs);
+
 	IVED_DEBUG(log4cat_veos_ived, "Length of paddr_array: %d", pgnum);
 	return(pgnum);
 }
@@ -239,24 +295,39 @@ check_veshm_paddr(uint64_t *paddr, uint64_t entries, uint64_t pgsize,
 		  pid_t pid, uint64_t vemva, uint64_t memsize)
 {
 	int i;
+	int nr_run;
 	uint64_t test_paddr;
-	int atb_prot;
+	struct ve_phys_run *runs = NULL;
+	int r = 0;
+	uint64_t run_off = 0;
 
 	if (paddr == NULL){
 		assert(0);
 		return (-1);
 	}
+	if (entries == 0)
+		return(0);
+
+	nr_run = veshm_virt_to_phy_runs(pid, vemva, pgsize * entries, &runs);
+	if (nr_run < 0){
+		IVED_DEBUG(log4cat_veos_ived, 
+			   "Physical address is changed: vemva:%#"PRIx64"",
+			   vemva);
+		return(1);
+	}
 
 	for (i = 0; i < entries; i++){
-		test_paddr = veos_virt_to_phy(vemva + pgsize * i, pid, false, 
-					      &atb_prot);
+		test_paddr = veshm_run_paddr(runs, nr_run, pgsize * i,
+					     &r, &run_off);
 		if (test_paddr != *(paddr + i)){
 			IVED_DEBUG(log4cat_veos_ived, 
 				   "Physical address is changed: vemva:%#"PRIx64"",
 				   vemva+pgsize*i);
+			free(runs);
 			return(1);
 		}
 	}
+	free(runs);
 
 	IVED_DEBUG(log4cat_veos_ived, 
 		   "Physical addresses are not changed. pid:%d, vemva:%#"PRIx64", size:%"PRIx64"",
@@ -27,6 +27,7 @@
 
 
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include <sys/types.h>
 #include <inttypes.h>
@@ -204,20 +205,21 @@ err_ret:
 }
 
 /*
- * @brief VESHM attach for VE program
+ * @brief Attach a VESHM on behalf of a VE program
  *
- * Attach a target VESHM to the requester's VEHVA space 
+ * @param [in]    arg   Attach arguments from a pseudo process
+ * @param [in]    uuid_in  UUID of the VESHM to attach, or NULL for any
+ * @param [out]   uuid_out UUID of the attached VESHM (NULL if unused)
+ * @param [in]    cred  Credential of the requester
  *
- * @param [in]    pti  Containing REQ info
- *
- * @return 0 on success, -errno on failure
+ * @return Attached address on success, -errno on failure
  */
-static int
-veos_veshm_attach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
-		  struct ucred *cred)
+static int64_t
+veos_veshm_attach_one(struct attach_arg *arg, uint8_t *uuid_in,
+		      uint8_t *uuid_out, struct ucred *cred)
 {
 	int ret;
-	uint64_t rpc_retval = -ECANCELED;
+	ProtobufCBinaryData uuid_data1;
 
 	/* To IVED */
 	RpcVeshmSubAttach request_attach = RPC_VESHM_SUB_ATTACH__INIT;
@@ -226,50 +228,73 @@ veos_veshm_attach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
 	IvedReturn reply = IVED_RETURN__INIT;	
 	RpcVeshmReturn veshm_ret = RPC_VESHM_RETURN__INIT;
 
-	IVED_TRACE(log4cat_veos_ived, "PASS");
-	assert(pti    !=  NULL);
-	assert(subcmd !=  NULL);
-	assert(cred   !=  NULL);
-
-	if (pti == NULL || subcmd == NULL || cred == NULL){
-		IVED_CRIT(log4cat_veos_ived, "Argument is NULL.");
-		rpc_retval = -ECANCELED;
-		goto err_ret;
-	}
-
 	request_attach.user_uid  = (uint32_t)cred->uid;
 	request_attach.user_pid  = (uint32_t)cred->pid;
-	request_attach.user_vemva= (uint64_t)
-		subcmd->arg.args_veshm_sub_attach.user_vemva;
-	request_attach.owner_pid = (uint32_t)
-		subcmd->arg.args_veshm_sub_attach.owner_pid;
-	request_attach.vemva	 = (uint64_t)
-		subcmd->arg.args_veshm_sub_attach.vemva;
-	request_attach.size	 = (uint64_t)
-		subcmd->arg.args_veshm_sub_attach.size;
-	request_attach.syncnum   = (uint32_t)
-		subcmd->arg.args_veshm_sub_attach.syncnum;
-	request_attach.mode_flag = (uint64_t)
-		subcmd->arg.args_veshm_sub_attach.mode_flag;
+	request_attach.user_vemva= (uint64_t)arg->user_vemva;
+	request_attach.owner_pid = (uint32_t)arg->owner_pid;
+	request_attach.vemva	 = (uint64_t)arg->vemva;
+	request_attach.size	 = (uint64_t)arg->size;
+	request_attach.syncnum   = (uint32_t)arg->syncnum;
+	request_attach.mode_flag = (uint64_t)arg->mode_flag;
 
 	if (isset_flag(request_attach.mode_flag, VE_SYS_FLAG_MASK)){
 		IVED_DEBUG(log4cat_veos_ived, "VESHM attaching: %s",
 			   strerror(EINVAL));
-		rpc_retval = -EINVAL;
-		goto err_ret;
+		return(-EINVAL);
 	}
 	set_flag(request_attach.mode_flag, VE_REQ_PROC);
 
+	/* IVED checks that the VESHM has not been renewed */
+	if (uuid_in != NULL && uuid_is_null(uuid_in) == 0){
+		uuid_data1.len		      = sizeof(uuid_t);
+		uuid_data1.data		      = uuid_in;
+		request_attach.has_uuid_veshm = 1;
+		request_attach.uuid_veshm     = uuid_data1;
+	}
+
 	reply.veshm_ret = &veshm_ret;
+	if (uuid_out != NULL){
+		veshm_ret.uuid_veshm.len  = sizeof(uuid_t);
+		veshm_ret.uuid_veshm.data = uuid_out;
+	}
 
 	ret = veos_veshm_attach_common(&request_attach, &reply);
 	if (ret != 0){
 		/* Function failed or IVED returns an error. */
-		rpc_retval = (uint64_t)reply.error;
-	} else {
-		rpc_retval = veshm_ret.address;
+		return(reply.error);
+	}
+	return((int64_t)veshm_ret.address);
+}
+
+/*
+ * @brief VESHM attach for VE program
+ *
+ * Attach a target VESHM to the requester's VEHVA space 
+ *
+ * @param [in]    pti  Containing REQ info
+ *
+ * @return 0 on success, -errno on failure
+ */
+static int
+veos_veshm_attach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
+		  struct ucred *cred)
+{
+	uint64_t rpc_retval = -ECANCELED;
+
+	IVED_TRACE(log4cat_veos_ived, "PASS");
+	assert(pti    !=  NULL);
+	assert(subcmd !=  NULL);
+	assert(cred   !=  NULL);
+
+	if (pti == NULL || subcmd == NULL || cred == NULL){
+		IVED_CRIT(log4cat_veos_ived, "Argument is NULL.");
+		rpc_retval = -ECANCELED;
+		goto err_ret;
 	}
 
+	rpc_retval = (uint64_t)veos_veshm_attach_one
+		(&subcmd->arg.args_veshm_sub_attach, NULL, NULL, cred);
+
 err_ret:
 	IVED_DEBUG(log4cat_veos_ived, "VESHM attaching finished"); 
 
@@ -280,21 +305,19 @@ err_ret:
 
 
 /*
- * @brief VESHM detach for VE program
+ * @brief Detach a VESHM on behalf of a VE program
  *
- * Detach a target VESHM to the requester's VEHVA space 
+ * @param [in]    arg   Detach arguments from a pseudo process
+ * @param [in]    cred  Credential of the requester
+ * @param [out]   retval_st  Size of the VESHM and # of remaining attaches
  *
- * @param [in]    pti  Containing REQ info
- *
- * @return 0 on success, -1 on failure
+ * @return Return value for a VE program (0 or -errno)
  */
 static int
-veos_veshm_detach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
-		  struct ucred *cred)
+veos_veshm_detach_one(struct detach_arg *arg, struct ucred *cred,
+		      struct ived_sub_reply *retval_st)
 {
-	int ret = -1;
-	int rpc_retval = -ECANCELED;
-	struct ived_sub_reply retval_st; 
+	int ret;
 
 	/* To IVED */
 	RpcVeshmSubDetach request_detach = RPC_VESHM_SUB_DETACH__INIT;
@@ -303,26 +326,18 @@ veos_veshm_detach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
 	IvedReturn reply = IVED_RETURN__INIT;	
 	RpcVeshmReturn veshm_ret = RPC_VESHM_RETURN__INIT;
 
-	assert(pti    !=  NULL);
-	assert(subcmd !=  NULL);
-	assert(cred   !=  NULL);
-
-	if (pti == NULL || subcmd == NULL || cred == NULL){
-		IVED_CRIT(log4cat_veos_ived, "Argument is NULL.");
-		rpc_retval = -ECANCELED;
-		goto err_ret;
-	}
+	retval_st->size = 0;
+	retval_st->num  = (uint32_t)-1;
 
 	request_detach.user_uid   = cred->uid;
 	request_detach.user_pid   = cred->pid;
-	request_detach.address    = subcmd->arg.args_veshm_sub_detach.address;
-	request_detach.mode_flag  = subcmd->arg.args_veshm_sub_detach.mode_flag;
+	request_detach.address    = arg->address;
+	request_detach.mode_flag  = arg->mode_flag;
 
 	if (isset_flag(request_detach.mode_flag, VE_SYS_FLAG_MASK)){
 		IVED_DEBUG(log4cat_veos_ived, "VESHM detaching: %s",
 			   strerror(EINVAL));
-		rpc_retval = -EINVAL;
-		goto err_ret;
+		return(-EINVAL);
 	}
 	set_flag(request_detach.mode_flag, VE_REQ_PROC);
 
@@ -331,15 +346,48 @@ veos_veshm_detach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
 	ret = veos_veshm_detach_common(&request_detach, &reply);
 	if (ret != 0){
 		/* Function failed */
-		rpc_retval = reply.error;
-		retval_st.size = 0;
-		retval_st.num  = (uint32_t)-1;
-		ret = -1;
-	} else {
-		rpc_retval = reply.retval;
-		retval_st.size = veshm_ret.size;
-		retval_st.num  = veshm_ret.counts;
+		return(reply.error);
 	}
+	retval_st->size = veshm_ret.size;
+	retval_st->num  = veshm_ret.counts;
+	return(reply.retval);
+}
+
+
+/*
+ * @brief VESHM detach for VE program
+ *
+ * Detach a target VESHM to the requester's VEHVA space 
+ *
+ * @param [in]    pti  Containing REQ info
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int
+veos_veshm_detach(veos_thread_arg_t *pti, struct veshm_args *subcmd,
+		  struct ucred *cred)
+{
+	int ret = -1;
+	int rpc_retval = -ECANCELED;
+	struct ived_sub_reply retval_st; 
+
+	assert(pti    !=  NULL);
+	assert(subcmd !=  NULL);
+	assert(cred   !=  NULL);
+
+	retval_st.size = 0;
+	retval_st.num  = (uint32_t)-1;
+
+	if (pti == NULL || subcmd == NULL || cred == NULL){
+		IVED_CRIT(log4cat_veos_ived, "Argument is NULL.");
+		rpc_retval = -ECANCELED;
+		goto err_ret;
+	}
+
+	rpc_retval = veos_veshm_detach_one(&subcmd->arg.args_veshm_sub_detach,
+					   cred, &retval_st);
+	if (rpc_retval == 0)
+		ret = 0;
 
 err_ret:
 	if (pti != NULL)
@@ -350,6 +398,85 @@ err_ret:
 }
 
 
+/*
+ * @brief Batch VESHM attach/detach for VE program
+ *
+ * Elements are processed in order. A failure of an element doesn't
+ * stop the others; its result is reported per element. A request
+ * carries at most VESHM_BATCH_MSG_MAX() elements, the pseudo process
+ * splits a larger batch.
+ *
+ * NOTE: Only the round trip between a pseudo process and VEOS is
+ * batched. Each element still sends its own request to IVED and
+ * updates ATB/DMAATB (and PCIATB) by itself.
+ *
+ * @param [in]    pti	     Containing REQ info
+ * @param [in]    pseudo_cmd Request message from a pseudo process
+ * @param [in]    cred	     Credential of the requester
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int
+veos_veshm_batch(veos_thread_arg_t *pti, ProtobufCBinaryData *pseudo_cmd,
+		 struct ucred *cred)
+{
+	int i, done = 0;
+	struct veshm_batch_args batch;
+	struct veshm_batch_result result[VESHM_BATCH_MAX];
+	struct ived_sub_reply retval_st;
+	size_t ent_size;
+
+	memset(&batch, 0, sizeof(batch));
+	memset(result, 0, sizeof(result));
+
+	if (pseudo_cmd->len < offsetof(struct veshm_batch_args, arg)
+	    || pseudo_cmd->len > sizeof(batch)){
+		IVED_DEBUG(log4cat_veos_ived, "Invalid message length: %d", 
+			   (int)pseudo_cmd->len);
+		goto err_ret_invalid_arg;
+	}
+	memcpy(&batch, pseudo_cmd->data, pseudo_cmd->len);
+
+	ent_size = (batch.subcmd == VESHM_ATTACH_BATCH) ?
+		sizeof(struct veshm_batch_attach) : sizeof(struct detach_arg);
+	if (batch.num <= 0 || batch.num > VESHM_BATCH_MAX
+	    || batch.num > VESHM_BATCH_MSG_MAX(ent_size)
+	    || pseudo_cmd->len < offsetof(struct veshm_batch_args, arg)
+	    + ent_size * batch.num){
+		IVED_DEBUG(log4cat_veos_ived, "Invalid number of elements: %d", 
+			   batch.num);
+		goto err_ret_invalid_arg;
+	}
+
+	for (i = 0; i < batch.num; i++){
+		if (batch.subcmd == VESHM_ATTACH_BATCH){
+			result[i].retval = veos_veshm_attach_one
+				(&batch.arg.attach[i].arg,
+				 batch.arg.attach[i].uuid_veshm,
+				 result[i].uuid_veshm, cred);
+		} else {
+			result[i].retval = veos_veshm_detach_one
+				(&batch.arg.detach[i], cred, &retval_st);
+			result[i].size = retval_st.size;
+			result[i].num  = retval_st.num;
+		}
+		if (result[i].retval >= 0)
+			done++;
+	}
+
+	IVED_DEBUG(log4cat_veos_ived, "VESHM batch %#x: %d/%d succeeded",
+		   batch.subcmd, done, batch.num); 
+
+	veos_ived_reply_data(done, result,
+			     sizeof(struct veshm_batch_result) * batch.num, pti);
+	return(0);
+
+err_ret_invalid_arg:
+	veos_ived_reply(-EINVAL, NULL, pti);
+	return(-1);
+}
+
+
 /*
  * @brief VESHM close for VE program
  *
@@ -588,13 +715,22 @@ int veos_veshm_veshmctl(veos_thread_arg_t *pti)
 	pseudo_cmd = (ProtobufCBinaryData *)
 		(&(((PseudoVeosMessage *)pti->pseudo_proc_msg)->pseudo_msg));
 
-	if (pseudo_cmd->len <= 0){
+	if (pseudo_cmd->len < sizeof(int)){
 		IVED_DEBUG(log4cat_veos_ived,"Invalid message length: %d", 
 			   (int)pseudo_cmd->len);
 		veos_ived_reply(-EAGAIN, NULL, pti);
 		retval = -1;
 		goto err_ret;
 	}
+
+	memcpy(&request_msg.subcmd, pseudo_cmd->data, sizeof(request_msg.subcmd));
+	if (request_msg.subcmd == VESHM_ATTACH_BATCH
+	    || request_msg.subcmd == VESHM_DETACH_BATCH){
+		IVED_DEBUG(log4cat_veos_ived, "New batch request from pid: %d",
+			   cred.pid);
+		retval = veos_veshm_batch(pti, pseudo_cmd, &cred);
+		goto err_ret;
+	}
 	memcpy(&request_msg, pseudo_cmd->data, pseudo_cmd->len);
 
 
@@ -1465,6 +1465,15 @@ ret_existing:
 	reply->error  = 0;
 	reply->veshm_ret->has_address = 1;
 	reply->veshm_ret->address = attached_addr;  /* VEMVA or VEHVA */
+	/* A caller which gives a buffer gets uuid of the attached VESHM */
+	if (reply->veshm_ret->uuid_veshm.data != NULL
+	    && reply->veshm_ret->uuid_veshm.len == sizeof(uuid_t)){
+		if (isset_flag(req_mode_flag, VE_MEM_LOCAL))
+			uuid_clear(reply->veshm_ret->uuid_veshm.data);
+		else
+			uuid_copy(reply->veshm_ret->uuid_veshm.data,
+				  entry->uuid_veshm);
+	}
 	if (user_ived_locked == 1){
 		user_ived_locked = 0;
 		pthread_rwlock_unlock(&user_ived_resource->ived_resource_lock);
@@ -51,6 +51,13 @@
 #define VE_MAX_CORE_PER_NODE 16
 #define MAX_VE_CORE_PER_VE_NODE -1
 
+/**
+ * Number of buckets of core halt/start latency histogram.
+ * Bucket n counts latencies less than 2^n microseconds,
+ * last bucket counts all the others.
+ */
+#define VE_CORE_LAT_HIST_NR 16
+
 /* Defines number of pairs of PCISYARs and PCISYMRs. */
 #define VE_PCI_SYNC_PAR_NUM 4
 
@@ -126,6 +133,15 @@ struct ve_acct_struct {
 	char *file; /*!< Accounting filename */
 	int fd; /*!< File descriptor corresponding to file */
 	pthread_mutex_t ve_acct_lock; /*!< Mutex lock for syncronization */
+	struct ve_acct_slot *ring; /*!< Records waiting to be written */
+	volatile uint64_t head; /*!< Next ring position to be reserved */
+	volatile uint64_t tail; /*!< Next ring position to be written */
+	uint64_t nr_dropped; /*!< Records dropped because ring was full
+			      * or writing them failed */
+	uint64_t nr_written; /*!< Records written to accounting files */
+	sem_t ring_sem; /*!< Posted when records are queued */
+	pthread_t writer; /*!< Thread writing queued records */
+	bool writer_stop; /*!< Writer thread is requested to exit */
 } veos_acct;
 
 /**
@@ -157,6 +173,10 @@ struct ve_node_struct {
 	pthread_cond_t pg_allc_cond;/*!< Conditional lock for allocating ve pages protected by ve_node_lock*/
 	uint64_t dirty_pg_num_2M;
 	uint64_t dirty_pg_num_64M;
+	struct ve_page_cache *pg_cache; /*!< Free VE page caches per host CPU */
+	int nr_pg_cache; /*!< Number of free VE page caches */
+	uint64_t cached_pg_num_2M; /*!< 2MB pages held by page caches */
+	uint64_t cached_pg_num_64M; /*!< 64MB pages held by page caches */
 	struct ve_mem_info mem; /*!< VE memory data , mem START and its SIZE */
 	vemaa_t zeroed_page_address; /*!< VE Memory Zeroed Page address */
 	vedl_handle *handle; /*!< VEDL handle */
@@ -168,9 +188,10 @@ struct ve_node_struct {
 	const char *ve_sysfs_path; /*!< SYSFS directory Path */
 	int ve_phys_core_id[VE_MAX_CORE_PER_NODE]; /*!< Mapping of logical to physical core id */
 	int nr_avail_cores; /*!< Number of available cores on VE node */
-	struct timeval sched_stime; /*!< Start time of PSM scheduler */
-	struct list_head ve_sys_load_head; /*!< Head element of VE system load */
-	uint64_t total_sys_load_time; /*!< Total load time in microseconds maintained */
+	uint64_t sched_stime; /*!< Monotonic time (ns) of last load calculation */
+	unsigned long avenrun[3]; /*!< VE system load in last 1min, 5min, 15min in fixed point */
+	double sys_load_sum; /*!< VE system load weighted by time in current load window */
+	uint64_t sys_load_time; /*!< Time in microseconds elapsed in current load window */
 	unsigned long nr_active; /*!< Number of active task on VE node */
 	uint64_t total_forks; /*!< Number of forks since VE node is booted */
 	uint64_t node_boot_time; /*!< Time at which node is booted */
@@ -195,17 +216,9 @@ struct ve_node_struct {
 	uint64_t vdso_pcientry; /*! Allocated pci enrty for vdso*/
 	char cr_dump_fname[FILENAME_MAX];
 	sem_t node_sem; /* Semaphore for performing scheduling on node */
+	sem_t sched_done; /* Posted by core scheduler workers when done */
 };
 
-/**
- * @brief Maintain the VE sytem load
- */
-struct ve_sys_load {
-	double sys_load; /*!< Load on system */
-	uint64_t time_slice; /*!< Time interval of load */
-	struct list_head list; /*!< List of next load of system */
-
-};
 /**
  * VEOS abort cause message buffer size
  */
@@ -215,6 +228,8 @@ struct ve_sys_load {
 #define OPT_PCISYNC2 1
 #define OPT_PCISYNC3 2
 #define OPT_CLEANUP  3
+#define OPT_COMPACT  4
+#define OPT_ACCT_WAIT 5
 
 #define NOT_REQUIRED 0
 #define REQUIRED     1
@@ -256,6 +271,7 @@ int veos_send_sigkil(char *);
 int64_t veos_convert_sched_options(char *, int, int);
 extern volatile sig_atomic_t terminate_flag;
 extern pthread_rwlock_t handling_request_lock;
+extern volatile uint64_t veos_dead_tid_gen;
 extern int opt_ived; /* -i specified. */
 extern unsigned int opt_pcisync; /* -p specified. */
 extern pthread_t terminate_dma_th; /* a thread executing veos_terminate_dma() */
@@ -309,7 +325,7 @@ extern const log4c_location_info_t locinfo;
 	.clear_child_tid	= NULL,					\
 	.offset			= 0,					\
 	.sr_context_bitmap	= 0,					\
-	.stime			= {0},					\
+	.stime			= 0,					\
 	.exec_time		= 0,					\
 	.vfork_state		= -1,					\
 	.vforked_proc		= 0,					\
@@ -86,4 +86,6 @@ struct veos_cmd_entry pseudo_veos_cmd[PSEUDO_VEOS_MAX_MSG_NUM] = {
 	{"CMD_VHSHM", veos_vhshm},
 	{"MAP_DMADES", veos_handle_map_dmades},
 	{"UNMAP_DMADES", veos_handle_unmap_dmades},
+	{"DMA_REQ_VEC", amm_handle_dma_vec_req},
+	{"FAST_IPC_NEGOTIATE", veos_handle_fast_ipc_negotiate},
 };
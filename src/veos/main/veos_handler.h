@@ -61,6 +61,7 @@ int amm_handle_shmctl(veos_thread_arg_t *);
 int amm_handle_shmget(veos_thread_arg_t *);
 int amm_soc_write(int, void *, size_t);
 int amm_handle_dma_req(veos_thread_arg_t *);
+int amm_handle_dma_vec_req(veos_thread_arg_t *);
 int amm_handle_vemva_init_atb_req(veos_thread_arg_t *);
 int amm_handle_vhva_sync_req(veos_thread_arg_t *);
 int set_cr_rlimit_req(veos_thread_arg_t *);
@@ -121,6 +122,7 @@ int veos_handle_stop_proc_req(struct veos_thread_arg *);
 
 /* VEOS <--------------> PSEUDO */
 int veos_handle_get_pci_sync_req(veos_thread_arg_t *);
+int veos_handle_fast_ipc_negotiate(veos_thread_arg_t *);
 extern int veos_handle_map_dmades(veos_thread_arg_t *);
 extern int veos_handle_unmap_dmades(veos_thread_arg_t *);
 
@@ -72,6 +72,7 @@ int init_ve_node_struct(struct ve_node_struct *p_ve_node, int node_id,
 	int p_ret = 0;
 	int a_core_num = 0;
 	int mapped_core_num = 0;
+	struct timeval boot_time = {0};
 	pthread_rwlockattr_t attr;
 
 	VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_TRACE, "In Func");
@@ -85,15 +86,17 @@ int init_ve_node_struct(struct ve_node_struct *p_ve_node, int node_id,
 	p_ve_node->node_num = node_id;
 	p_ve_node->scheduling_status = COMPLETED;
 	p_ve_node->psm_sched_timer_id = NULL;
-	p_ve_node->total_sys_load_time = 0;
+	memset(p_ve_node->avenrun, 0, sizeof(p_ve_node->avenrun));
+	p_ve_node->sys_load_sum = 0;
+	p_ve_node->sys_load_time = 0;
 	p_ve_node->nr_active = 0;
 	p_ve_node->total_forks = 0;
 	p_ve_node->dh = NULL;
 	p_ve_node->vdso_pfn = -1;
 	p_ve_node->vdso_pcientry = -1;
 	p_ve_node->cnt_regs_addr = NULL;
-	INIT_LIST_HEAD(&(p_ve_node->ve_sys_load_head));
-	gettimeofday(&(p_ve_node->sched_stime), NULL);
+	gettimeofday(&boot_time, NULL);
+	p_ve_node->sched_stime = psm_mono_nsec();
 
 	if (sem_init(&p_ve_node->node_sem, 0, 1) == -1) {
 		VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_ERROR,
@@ -101,9 +104,15 @@ int init_ve_node_struct(struct ve_node_struct *p_ve_node, int node_id,
 		goto hndl_return1;
 	}
 
+	if (sem_init(&p_ve_node->sched_done, 0, 0) == -1) {
+		VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_ERROR,
+			"Initializing semaphore failed for node %d", node_id);
+		goto hndl_return1;
+	}
+
 	/* Time in microseconds at time which node is booted */
-	p_ve_node->node_boot_time = (p_ve_node->sched_stime.tv_sec
-			* MICRO_SECONDS) + p_ve_node->sched_stime.tv_usec;
+	p_ve_node->node_boot_time = (boot_time.tv_sec * MICRO_SECONDS) +
+		boot_time.tv_usec;
 
 	/* Getting VE Handle for veos */
 	VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_DEBUG, "VE driver file is %s",
@@ -151,6 +160,12 @@ int init_ve_node_struct(struct ve_node_struct *p_ve_node, int node_id,
 		goto hndl_return;
 	}
 
+	if (veos_acct_init() != 0) {
+		VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_ERROR,
+			"Failed to start accounting writer");
+		goto hndl_return;
+	}
+
 	/* Fetch the MAX CORE NUMBER supported by this node */
 	a_core_num = vedl_get_num_of_core(p_ve_node->handle);
 	VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_INFO,
@@ -379,8 +394,11 @@ int init_ve_core_struct(struct ve_core_struct *p_ve_core,
 	p_ve_core->scheduling_status = COMPLETED;
 	p_ve_core->busy_time = 0;
 	p_ve_core->busy_time_prev = 0;
-	p_ve_core->core_stime = (struct timeval){0};
+	p_ve_core->core_stime = 0;
 	p_ve_core->nr_switches = 0;
+	memset(p_ve_core->halt_lat_hist, 0, sizeof(p_ve_core->halt_lat_hist));
+	memset(p_ve_core->start_lat_hist, 0,
+			sizeof(p_ve_core->start_lat_hist));
 	p_ve_core->usr_regs_addr = NULL;
 	p_ve_core->sys_regs_addr = NULL;
 	p_ve_core->p_ve_node = p_ve_node;
@@ -389,6 +407,11 @@ int init_ve_core_struct(struct ve_core_struct *p_ve_core,
 			"Initializing semaphore failed for core %d", p_ve_core->core_num);
 		goto hndl_return;
 	}
+	if (sem_init(&p_ve_core->sched_kick, 0, 0) == -1) {
+		VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_ERROR,
+			"Initializing semaphore failed for core %d", p_ve_core->core_num);
+		goto hndl_return;
+	}
 
 	gettimeofday(&(p_ve_core->core_uptime), NULL);
 
@@ -87,6 +87,152 @@ hndl_return:
 	VEOS_TRACE("Exiting");
 }
 
+/**
+ * @brief Handles FAST_IPC_NEGOTIATE request from pseudo process
+ *
+ * Agrees on the version of fast path framing used by the hot commands
+ * on this connection. The agreed version is sent back as return value.
+ *
+ * @param[in] pti Thread "pti" for the handler
+ *
+ * @return 0 on Success, negative on failure
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+int veos_handle_fast_ipc_negotiate(veos_thread_arg_t *pti)
+{
+	PseudoVeosMessage *request = NULL;
+	PseudoVeosMessage ack = PSEUDO_VEOS_MESSAGE__INIT;
+	char cmd_buff[MAX_PROTO_MSG_SIZE] = {0};
+	ssize_t pseudo_msg_len = -1, msg_len = -1;
+	uint32_t version = 0;
+	int retval = -1;
+
+	VEOS_TRACE("Entering");
+
+	request = (PseudoVeosMessage *)pti->pseudo_proc_msg;
+	if (request->has_pseudo_msg &&
+			request->pseudo_msg.len == sizeof(version))
+		memcpy(&version, request->pseudo_msg.data, sizeof(version));
+
+	if (version > VEOS_FAST_IPC_VERSION)
+		version = VEOS_FAST_IPC_VERSION;
+	pti->fast_ipc = version;
+
+	VEOS_DEBUG("Fast path version %u for pseudo pid: %d",
+			version, request->pseudo_pid);
+
+	ack.has_syscall_retval = true;
+	ack.syscall_retval = version ? (int64_t)version : -ENOTSUP;
+
+	pseudo_msg_len = pseudo_veos_message__get_packed_size(&ack);
+	msg_len = pseudo_veos_message__pack(&ack, (uint8_t *)cmd_buff);
+	if (msg_len != pseudo_msg_len) {
+		VEOS_ERROR("Packing message protocol buffer error");
+		VEOS_DEBUG("Expected length: %ld Transferred length: %ld",
+				pseudo_msg_len, msg_len);
+		goto hndl_return;
+	}
+	if (psm_pseudo_send_cmd(pti->socket_descriptor, cmd_buff,
+				pseudo_msg_len) < pseudo_msg_len) {
+		VEOS_ERROR("Failed to send response to pseudo process");
+		goto hndl_return;
+	}
+	retval = 0;
+
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Decodes a request received on the fast path
+ *
+ * The request is presented to the handlers as a PseudoVeosMessage whose
+ * payload points into the receive buffer, so no unpacking or allocation
+ * is required.
+ *
+ * @param[in] pti Thread "pti" for the handler
+ * @param[in] buff Received message
+ * @param[in] len Length of received message
+ * @param[out] msg Message to present to the handler
+ *
+ * @return 0 if the request is on the fast path, 1 if it is a packed
+ * PseudoVeosMessage, -1 if it is a malformed fast path request.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+static int veos_fast_ipc_decode(veos_thread_arg_t *pti, char *buff,
+		ssize_t len, PseudoVeosMessage *msg)
+{
+	struct veos_fast_hdr hdr;
+
+	if (len < (ssize_t)sizeof(hdr))
+		return 1;
+	memcpy(&hdr, buff, sizeof(hdr));
+	if (hdr.magic != VEOS_FAST_IPC_MAGIC)
+		return 1;
+
+	if (!pti->fast_ipc || hdr.version != pti->fast_ipc ||
+			!VEOS_FAST_IPC_CMD(hdr.cmd_id) ||
+			hdr.len != len - sizeof(hdr)) {
+		VEOS_DEBUG("Invalid fast path request: version %d cmd id %d "
+				"length %u", hdr.version, hdr.cmd_id, hdr.len);
+		return -1;
+	}
+
+	msg->pseudo_veos_cmd_id = hdr.cmd_id;
+	msg->has_pseudo_pid = true;
+	msg->pseudo_pid = hdr.pid;
+	msg->has_syscall_retval = true;
+	msg->syscall_retval = hdr.syscall_retval;
+	msg->has_pseudo_msg = (hdr.len != 0);
+	msg->pseudo_msg.len = hdr.len;
+	msg->pseudo_msg.data = (uint8_t *)buff + sizeof(hdr);
+	return 0;
+}
+
+/**
+ * @brief Authenticates the sender TID of a request
+ *
+ * Credentials of the peer are captured once when the connection is
+ * accepted. A TID is checked to belong to the peer process with tgkill()
+ * only the first time it is seen on the connection; the TIDs already
+ * checked are forgotten whenever veos learns of a dead TID.
+ *
+ * @param[in] pti Thread "pti" for the handler
+ * @param[in] tid TID received in the request
+ *
+ * @return 0 on Success, -1 on failure
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+static int veos_authenticate_tid(veos_thread_arg_t *pti, pid_t tid)
+{
+	uint64_t gen = veos_dead_tid_gen;
+	int i;
+
+	if (pti->tid_cache_gen != gen) {
+		pti->nr_verified_tid = 0;
+		pti->tid_cache_gen = gen;
+	}
+
+	for (i = 0; i < pti->nr_verified_tid; i++) {
+		if (pti->verified_tid[i] == tid)
+			return 0;
+	}
+
+	if (-1 == syscall(SYS_tgkill, pti->cred.pid, tid, 0))
+		return -1;
+
+	if (pti->nr_verified_tid < VEOS_TID_CACHE_SIZE)
+		pti->verified_tid[pti->nr_verified_tid++] = tid;
+	return 0;
+}
+
 /**
  * @brief Invokes the handler function based on received message
  *
@@ -102,17 +248,17 @@ hndl_return:
  */
 int pseudo_proc_veos_handler(veos_thread_arg_t *pti)
 {
-	int sd = 0, rwl = -1, ret = -1;
-	socklen_t len = 0;
+	int sd = 0, rwl = -1, ret = -1, fast = -1;
 	bool rw_lock = false;
 	pthread_t tid = pthread_self();
 	PseudoVeosMessage *pseudo_msg = NULL;
+	PseudoVeosMessage fast_msg = PSEUDO_VEOS_MESSAGE__INIT;
 	char cmd_buff[MAX_PROTO_MSG_SIZE];
 
 	VEOS_TRACE("Entering");
 
 	sd = pti->socket_descriptor;
-	len = sizeof(struct ucred);
+	pti->fast_req = false;
 
 	memset(cmd_buff, '\0', MAX_PROTO_MSG_SIZE);
 	ret = recv(sd, cmd_buff, MAX_PROTO_MSG_SIZE, 0);
@@ -137,11 +283,20 @@ int pseudo_proc_veos_handler(veos_thread_arg_t *pti)
 	}
 	rw_lock = true;
 
-	pseudo_msg = pseudo_veos_message__unpack(NULL, ret,
-			(const uint8_t *)(cmd_buff));
-	if (NULL == pseudo_msg) {
-		VEOS_ERROR("Unpacking message protocol buffer error");
+	fast = veos_fast_ipc_decode(pti, cmd_buff, ret, &fast_msg);
+	if (0 == fast) {
+		pseudo_msg = &fast_msg;
+		pti->fast_req = true;
+	} else if (0 > fast) {
+		VEOS_ERROR("Invalid fast path request");
 		goto hndl_error;
+	} else {
+		pseudo_msg = pseudo_veos_message__unpack(NULL, ret,
+				(const uint8_t *)(cmd_buff));
+		if (NULL == pseudo_msg) {
+			VEOS_ERROR("Unpacking message protocol buffer error");
+			goto hndl_error;
+		}
 	}
 
 	if ((pseudo_msg->pseudo_veos_cmd_id >= PSEUDO_VEOS_MAX_MSG_NUM)
@@ -151,15 +306,7 @@ int pseudo_proc_veos_handler(veos_thread_arg_t *pti)
 		goto hndl_error;
 	}
 
-	/* Get options on socket */
-	ret = getsockopt(sd, SOL_SOCKET, SO_PEERCRED, &(pti->cred), &len);
-	if (0 != ret) {
-		VEOS_ERROR("Failed to get options on socket, return "
-				"value %s", strerror(errno));
-		goto hndl_error;
-	}
-
-	ret = syscall(SYS_tgkill, pti->cred.pid, pseudo_msg->pseudo_pid, 0);
+	ret = veos_authenticate_tid(pti, pseudo_msg->pseudo_pid);
 	if (ret == -1) {
 		VEOS_ERROR("Authentication failure");
 		VEOS_DEBUG("PID: %d is not a valid process",
@@ -204,7 +351,7 @@ hndl_error:
 	veos_handle_pseudo_proc_req_failure(pti);
 
 hndl_return:
-	if (pseudo_msg != NULL)
+	if (pseudo_msg != NULL && pseudo_msg != &fast_msg)
 		pseudo_veos_message__free_unpacked(pseudo_msg, NULL);
 
 	if (rw_lock == true) {
@@ -287,6 +434,7 @@ static void create_and_start_worker(int sock, pthread_attr_t attr)
 {
 	int ret = -1;
 	pthread_t tid;
+	socklen_t len = 0;
 	struct veos_thread_arg *veos_pt_info = NULL;
 
 	VEOS_TRACE("Entering");
@@ -310,6 +458,19 @@ static void create_and_start_worker(int sock, pthread_attr_t attr)
 	memset(veos_pt_info, '\0', sizeof(struct veos_thread_arg));
 
 	veos_pt_info->socket_descriptor = sock;
+
+	/* Credentials of peer do not change during the connection */
+	len = sizeof(struct ucred);
+	ret = getsockopt(sock, SOL_SOCKET, SO_PEERCRED,
+			&(veos_pt_info->cred), &len);
+	if (0 != ret) {
+		VEOS_ERROR("Failed to get options on socket, return "
+				"value %s", strerror(errno));
+		close(sock);
+		free(veos_pt_info);
+		goto hndl_return;
+	}
+	veos_pt_info->tid_cache_gen = veos_dead_tid_gen;
 	ret = pthread_create(&tid, &attr, &veos_worker_thread,
 			(void *)veos_pt_info);
 	if (ret != 0) {
@@ -48,6 +48,7 @@
 #include "veos_ived_common.h"
 #include "config.h"
 #include "vesync.h"
+#include "ve_migrate.h"
 
 #define IPC_QUEUE_LEN 20
 
@@ -60,6 +61,8 @@ sem_t terminate_sem;
 log4c_category_t *cat_os_core;
 volatile sig_atomic_t terminate_flag = NOT_REQUIRED;
 pthread_rwlock_t handling_request_lock;
+/* Bumped whenever a dead TID is reported, invalidates TID caches */
+volatile uint64_t veos_dead_tid_gen;
 /* Condition variable to wait update of terminate_flag */
 int opt_ived = 0; /* -i specified. */
 unsigned int opt_pcisync = 0; /* --pcisync? specified. */
@@ -86,7 +89,6 @@ void veos_terminate_node_core(int abnormal)
 	int core_loop = 0;
 	struct ve_node_struct *p_ve_node;
 	struct ve_core_struct *p_ve_core;
-	struct list_head *p, *q;
 
 	VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_TRACE, "In Func");
 
@@ -108,14 +110,11 @@ void veos_terminate_node_core(int abnormal)
 
 	}
 
+	/* Write accounting records of processes which have exited */
+	veos_acct_fini();
+
 	p_ve_node = p_ve_nodes_vh->p_ve_nodes[0];
 	if (p_ve_node != NULL) {
-		/* Removing VE system load */
-		list_for_each_safe(p, q, &(p_ve_node->ve_sys_load_head)) {
-			struct ve_sys_load *tmp =
-				list_entry(p, struct ve_sys_load, list);
-			free(tmp);
-		}
 		if (munmap(VE_NODE(0)->cnt_regs_addr,
 				sizeof(system_common_reg_t)) != 0) {
 			VE_LOG(CAT_OS_CORE, LOG4C_PRIORITY_ERROR,
@@ -303,6 +302,17 @@ static void usage(char *veos_path)
 	"                                  immediately, in order to ensure all VE\n"
 	"                                  core, user mode DMA and privileged DMA\n"
 	"                                  are halted, and clean up resources.\n"
+	"    --compact=level               Aggressiveness of VE memory compaction\n"
+	"                                  from 0 (disabled, default) to 3.\n"
+	"                                  While a compaction pass moves pages,\n"
+	"                                  scheduling and request handling stop\n"
+	"                                  on the whole VE node. A higher level\n"
+	"                                  runs passes more often and moves more\n"
+	"                                  pages in each pass.\n"
+	"    --acct-wait=value             The period of time for which an\n"
+	"                                  exiting process waits for room in the\n"
+	"                                  accounting queue before its record is\n"
+	"                                  dropped, in milliseconds (default 100).\n"
 	"    -h, --help                    Display this help and exit.\n"
 	"    -V, --version                 Display version information and exit.\n"
 	"\n"
@@ -540,6 +550,8 @@ int main(int argc, char *argv[])
 			{"pcisync2",       required_argument, NULL,  0 },
 			{"pcisync3",       required_argument, NULL,  0 },
 			{"cleanup",        no_argument,       NULL,  0 },
+			{"compact",        required_argument, NULL,  0 },
+			{"acct-wait",      required_argument, NULL,  0 },
 			{"help",           no_argument,       NULL, 'h'},
 			{"sock",           required_argument, NULL, 's'},
 			{"dev",            required_argument, NULL, 'd'},
@@ -613,6 +625,28 @@ int main(int argc, char *argv[])
 			} else if (index == OPT_CLEANUP) {
 				opt_clean = 1;
 				break;
+			} else if (index == OPT_COMPACT) {
+				veos_compact_level =
+					veos_convert_sched_options(optarg,
+						COMPACT_LEVEL_MIN,
+						COMPACT_LEVEL_MAX);
+				if (veos_compact_level == -1) {
+					fprintf(stderr,
+						"--compact option error\n");
+					exit(EXIT_FAILURE);
+				}
+				break;
+			} else if (index == OPT_ACCT_WAIT) {
+				veos_acct_wait =
+					veos_convert_sched_options(optarg,
+						VE_ACCT_WAIT_MIN_MLSECS,
+						VE_ACCT_WAIT_MAX_MLSECS);
+				if (veos_acct_wait == -1) {
+					fprintf(stderr,
+						"--acct-wait option error\n");
+					exit(EXIT_FAILURE);
+				}
+				break;
 			} else {
 				fprintf(stderr, "Wrong option specified\n");
 				exit(EXIT_FAILURE);
@@ -104,6 +104,58 @@ send_error:
 	return transferred;
 }
 
+/**
+ * @brief Sends acknowledgment of a request received on the fast path.
+ *
+ * @param[in] pti Contains the request message received from pseudo process
+ * @param[in] syscall_ret Value to be returned to the pseudo side
+ * @param[in] data Payload of acknowledgment, may be NULL
+ * @param[in] len Length of payload
+ *
+ * @return positive value on success, -1 on failure.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+ssize_t psm_pseudo_send_fast_ack(struct veos_thread_arg *pti,
+		int64_t syscall_ret, void *data, size_t len)
+{
+	ssize_t retval = -1;
+	char buf[MAX_PROTO_MSG_SIZE];
+	struct veos_fast_hdr hdr = {0};
+
+	VEOS_TRACE("Entering");
+
+	if (len > VEOS_FAST_IPC_MAX_PAYLOAD) {
+		VEOS_ERROR("Fast path acknowledgment too long");
+		VEOS_DEBUG("Payload length: %lu", len);
+		goto hndl_return;
+	}
+
+	hdr.magic = VEOS_FAST_IPC_MAGIC;
+	hdr.version = pti->fast_ipc;
+	hdr.cmd_id = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->
+		pseudo_veos_cmd_id;
+	hdr.len = len;
+	hdr.syscall_retval = syscall_ret;
+	memcpy(buf, &hdr, sizeof(hdr));
+	if (len)
+		memcpy(buf + sizeof(hdr), data, len);
+
+	retval = psm_pseudo_send_cmd(pti->socket_descriptor, buf,
+			sizeof(hdr) + len);
+	if (retval < (ssize_t)(sizeof(hdr) + len)) {
+		VEOS_ERROR("Failed to send response to pseudo process");
+		VEOS_DEBUG("Expected bytes: %ld, Transferred bytes: %ld",
+				sizeof(hdr) + len, retval);
+		retval = -1;
+	}
+
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Sends request to pseudo process about success/failure creation of
  * exec VE process.
@@ -362,6 +414,13 @@ int psm_pseudo_send_set_user_reg_ack(struct veos_thread_arg *pti, int ack_ret)
 		goto hndl_return;
 	}
 
+	if (pti->fast_req) {
+		retval = psm_pseudo_send_fast_ack(pti, ack_ret, NULL, 0);
+		if (retval != -1)
+			retval = 0;
+		goto hndl_return;
+	}
+
 	/* Popuate SET RETURN ACK process return value */
 	set_usr_reg_ack.has_syscall_retval = true;
 	set_usr_reg_ack.syscall_retval = ack_ret;
@@ -578,6 +637,11 @@ int psm_pseudo_send_schedule_ack(struct veos_thread_arg *pti,
 		goto hndl_return;
 	}
 
+	if (pti->fast_req) {
+		retval = psm_pseudo_send_fast_ack(pti, syscall_ret, NULL, 0);
+		goto hndl_return;
+	}
+
 	/* prepare SCHEDULE_ACK response */
 	ve_schedule_ack.has_syscall_retval = true;
 	ve_schedule_ack.syscall_retval = syscall_ret;
@@ -1259,6 +1323,12 @@ int psm_pseudo_send_block_ack(struct veos_thread_arg *pti, int ack_ret)
 		VEOS_ERROR("Invalid argument received");
 		goto hndl_return;
 	}
+
+	if (pti->fast_req) {
+		retval = psm_pseudo_send_fast_ack(pti, ack_ret, NULL, 0);
+		goto hndl_return;
+	}
+
 	/*Populating BLOCK ACK*/
 	block_ack.has_syscall_retval = true;
 	block_ack.syscall_retval = ack_ret;
@@ -1347,6 +1417,11 @@ int psm_pseudo_send_unblock_and_setregval_ack(struct veos_thread_arg *pti, int a
 	if (!pti)
 		goto hndl_return;
 
+	if (pti->fast_req) {
+		retval = psm_pseudo_send_fast_ack(pti, ack_ret, NULL, 0);
+		goto hndl_return;
+	}
+
 	/* Popuate UNBLOCK ACK message */
 	unblock_ack.has_syscall_retval = true;
 	unblock_ack.syscall_retval = ack_ret;
@@ -3888,6 +3963,12 @@ int psm_pseudo_send_get_regval_ack(struct veos_thread_arg *pti,
 		goto hndl_return;
 	}
 
+	if (pti->fast_req) {
+		retval = psm_pseudo_send_fast_ack(pti, ack_ret, &ice,
+				sizeof(ice));
+		goto hndl_return;
+	}
+
 	/* Populate acknowledgment message */
 	regval_ack.has_syscall_retval = true;
 	regval_ack.syscall_retval = ack_ret;
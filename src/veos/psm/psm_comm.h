@@ -28,6 +28,8 @@
 #define __PSM_PSEUDO_IPC_H
 int psm_handle_send_pseudo_vefd_ack(struct veos_thread_arg *, int);
 ssize_t psm_pseudo_send_cmd(int, void *, ssize_t);
+ssize_t psm_pseudo_send_fast_ack(struct veos_thread_arg *, int64_t, void *,
+		size_t);
 int psm_pseudo_recv_cmd(int, void *, int);
 int psm_pseudo_send_start_ve(struct veos_thread_arg *, pid_t, int64_t);
 int psm_pseudo_send_fork_ack(struct veos_thread_arg *, int);
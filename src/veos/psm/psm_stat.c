@@ -252,8 +252,9 @@ int psm_rpm_handle_pidstat_req(int pid, struct velib_pidstat *pidstat)
 	pidstat->priority = tsk->priority + PRIO_MASK;
 	pidstat->nice = tsk->priority;
 	pidstat->policy = tsk->policy;
-	pidstat->utime = get_ve_proc_exec_time(tsk, flag);
-	pidstat->cutime = tsk->sighand->cexec_time;
+	pidstat->utime = get_ve_proc_exec_time(tsk, flag) /
+		USECS_TO_NANOSECONDS;
+	pidstat->cutime = tsk->sighand->cexec_time / USECS_TO_NANOSECONDS;
 	pidstat->flags = tsk->flags;
 
 	/* Calculating process start time since VE node
@@ -283,6 +284,47 @@ hndl_return:
 	return retval;
 }
 
+/**
+ * @brief Function will populate the fields of struct velib_cputime_ns.
+ *
+ * @param[in] pid PID of VE process
+ * @param[in,out] cputime Pointer to struct velib_cputime_ns
+ *
+ * @return 0 on success, -errno on failure.
+ */
+int psm_rpm_handle_cputime_ns_req(int pid, struct velib_cputime_ns *cputime)
+{
+	int retval = -1;
+	struct ve_task_struct *tsk = NULL;
+	bool flag;
+
+	VEOS_TRACE("Entering");
+	if (!cputime)
+		goto hndl_return;
+
+	flag = cputime->whole;
+
+	memset(cputime, 0, sizeof(struct velib_cputime_ns));
+
+	/* Find the VE task for given pid */
+	tsk = find_ve_task_struct(pid);
+	if (NULL == tsk) {
+		VEOS_ERROR("PID: %d not found.", pid);
+		retval = -ESRCH;
+		goto hndl_return;
+	}
+
+	cputime->whole = flag;
+	cputime->utime_ns = get_ve_proc_exec_time(tsk, flag);
+	cputime->cutime_ns = tsk->sighand->cexec_time;
+
+	put_ve_task_struct(tsk);
+	retval = 0;
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Function will populate the fields pf struct velib_statinfo.
  *
@@ -314,8 +356,10 @@ int psm_rpm_handle_stat_req(struct ve_node_struct *p_ve_node,
 		p_ve_core = VE_CORE(0, core_loop);
 		gettimeofday(&now, NULL);
 		core_uptime = timeval_diff(now, p_ve_core->core_uptime);
-		statinfo->user[core_loop] = p_ve_core->busy_time;
-		statinfo->idle[core_loop] = core_uptime - p_ve_core->busy_time;
+		statinfo->user[core_loop] = p_ve_core->busy_time /
+			USECS_TO_NANOSECONDS;
+		statinfo->idle[core_loop] = core_uptime -
+			statinfo->user[core_loop];
 	}
 
 	nr_switches = psm_calc_nr_context_switches(p_ve_node);
@@ -339,6 +383,43 @@ hndl_return:
 	return retval;
 }
 
+/**
+ * @brief Function will populate the fields of struct velib_core_lat.
+ *
+ * @param[in] p_ve_node Pointer to VE node struct
+ * @param[out] core_lat Pointer to struct velib_core_lat
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int psm_rpm_handle_core_lat_req(struct ve_node_struct *p_ve_node,
+		struct velib_core_lat *core_lat)
+{
+	int retval = -1;
+	int core_loop = 0, idx = 0;
+	struct ve_core_struct *p_ve_core = NULL;
+
+	VEOS_TRACE("Entering");
+	if (!p_ve_node || !core_lat)
+		goto hndl_return;
+
+	memset(core_lat, 0, sizeof(struct velib_core_lat));
+
+	for (core_loop = 0; core_loop < p_ve_node->nr_avail_cores;
+			core_loop++) {
+		p_ve_core = VE_CORE(0, core_loop);
+		for (idx = 0; idx < VE_CORE_LAT_HIST_NR; idx++) {
+			core_lat->halt_lat[core_loop][idx] =
+				p_ve_core->halt_lat_hist[idx];
+			core_lat->start_lat[core_loop][idx] =
+				p_ve_core->start_lat_hist[idx];
+		}
+	}
+	retval = 0;
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Populate the VE process resource in struct velib_get_rusage_info.
  *
@@ -716,3 +797,32 @@ hndl_return:
 	VEOS_TRACE("Exiting");
 	return retval;
 }
+
+/**
+ * @brief Function will populate the fields of struct velib_acct_stat.
+ *
+ * @param[out] acct_stat Pointer to struct velib_acct_stat
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int psm_rpm_handle_acct_stat_req(struct velib_acct_stat *acct_stat)
+{
+	int retval = -1;
+
+	VEOS_TRACE("Entering");
+	if (!acct_stat)
+		goto hndl_return;
+
+	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), LOCK,
+		"Failed to acquire task accounting lock");
+	acct_stat->active = veos_acct.active;
+	acct_stat->nr_written = veos_acct.nr_written;
+	acct_stat->nr_dropped = veos_acct.nr_dropped;
+	acct_stat->nr_pending = veos_acct.head - veos_acct.tail;
+	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), UNLOCK,
+		"Failed to release task accounting lock");
+	retval = 0;
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
@@ -34,8 +34,11 @@ bool check_ve_proc_capability(int, int);
 int psm_rpm_handle_getpriority_req(struct ve_priorityinfo *);
 int psm_rpm_handle_setpriority_req(struct ve_priorityinfo *);
 int psm_rpm_handle_pidstat_req(int, struct velib_pidstat *);
+int psm_rpm_handle_cputime_ns_req(int, struct velib_cputime_ns *);
 int psm_rpm_handle_stat_req(struct ve_node_struct *,
 		struct velib_statinfo *);
+int psm_rpm_handle_core_lat_req(struct ve_node_struct *,
+		struct velib_core_lat *);
 int psm_rpm_handle_sched_set_scheduler(int, struct velib_setscheduler);
 int psm_rpm_handle_get_rusage_req(int, struct velib_get_rusage_info *);
 int psm_rpm_handle_prlimit(int, int, struct velib_prlimit *, struct veos_thread_arg *);
@@ -44,4 +47,5 @@ int psm_rpm_handle_sched_get_scheduler(int, struct velib_setscheduler *);
 int psm_rpm_handle_pidstatus(int, struct velib_pidstatus *);
 int psm_rpm_handle_check_pid(int);
 int psm_rpm_handle_acct(int, char *);
+int psm_rpm_handle_acct_stat_req(struct velib_acct_stat *);
 #endif
@@ -395,6 +395,115 @@ hndl_return:
 	return retval;
 }
 
+/**
+ * @brief Read a range of VE memory of the tracee directly into the
+ * tracer's memory.
+ *
+ * The whole range is transferred with a single DMA request, which the
+ * DMA manager splits into a descriptor list.
+ *
+ * @param[in] p_ve_task Pointer to VE task Struct
+ * @param[in] addr VEMVA of tracee process, 8 byte aligned
+ * @param[in] data VHVA of tracer to fill, 8 byte aligned
+ * @param[in] len Length of range in bytes, 8 byte aligned, at most
+ * PTRACE_RANGE_MAX
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int psm_ptrace_peekdata_range(struct ve_task_struct *p_ve_task,
+		uint64_t addr, uint64_t data, uint64_t len)
+{
+	int retval = -1;
+
+	VEOS_TRACE("Entering");
+
+	if (!p_ve_task)
+		goto hndl_return;
+
+	/* Range must neither wrap around nor exceed PTRACE_RANGE_MAX */
+	if (!len || (len > PTRACE_RANGE_MAX) || (addr + len < addr) ||
+			(data + len < data)) {
+		VEOS_DEBUG("Invalid range VEMVA: %lx VHVA: %lx length: %lx",
+				addr, data, len);
+		goto hndl_return;
+	}
+
+	retval = amm_dma_xfer(VE_DMA_VEMVA_WO_PROT_CHECK, addr, p_ve_task->pid,
+			VE_DMA_VHVA, data, p_ve_task->p_ve_ptrace->tracer_pid,
+			len, p_ve_task->node_id);
+	if (-1 == retval) {
+		VEOS_DEBUG("DMA failed during ptrace PEEKDATA_RANGE");
+		goto hndl_return;
+	}
+
+	retval = 0;
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Write a range of the tracer's memory to VE memory of the
+ * tracee.
+ *
+ * Read-only pages backing the range are replaced first, in the same way
+ * as for POKEDATA, then the whole range is transferred with a single DMA
+ * request.
+ *
+ * @param[in] p_ve_task Pointer to VE task Struct
+ * @param[in] addr VEMVA of tracee process, 8 byte aligned
+ * @param[in] data VHVA of tracer to read from, 8 byte aligned
+ * @param[in] len Length of range in bytes, 8 byte aligned, at most
+ * PTRACE_RANGE_MAX
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int psm_ptrace_pokedata_range(struct ve_task_struct *p_ve_task,
+		uint64_t addr, uint64_t data, uint64_t len)
+{
+	int retval = -1;
+	uint64_t vaddr = 0;
+
+	VEOS_TRACE("Entering");
+
+	if (!p_ve_task)
+		goto hndl_return;
+
+	/* Range must neither wrap around nor exceed PTRACE_RANGE_MAX */
+	if (!len || (len > PTRACE_RANGE_MAX) || (addr + len < addr) ||
+			(data + len < data)) {
+		VEOS_DEBUG("Invalid range VEMVA: %lx VHVA: %lx length: %lx",
+				addr, data, len);
+		goto hndl_return;
+	}
+
+	/* Visit every page of the range, 2MB being the smallest VE page */
+	for (vaddr = addr; vaddr < addr + len;
+			vaddr = ALIGN(vaddr + 1, PAGE_SIZE_2MB)) {
+		retval = veos_handle_ptrace_poke_req(p_ve_task, vaddr);
+		if (0 > retval) {
+			VEOS_DEBUG("veos_handle_ptrace_poke_req fails: %d",
+					retval);
+			retval = -1;
+			goto hndl_return;
+		}
+	}
+
+	retval = amm_dma_xfer(VE_DMA_VHVA, data,
+			p_ve_task->p_ve_ptrace->tracer_pid,
+			VE_DMA_VEMVA_WO_PROT_CHECK, addr, p_ve_task->pid,
+			len, p_ve_task->node_id);
+	if (-1 == retval) {
+		VEOS_DEBUG("DMA failed during ptrace POKEDATA_RANGE");
+		goto hndl_return;
+	}
+
+	retval = 0;
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Get the offset of VE register.
  *
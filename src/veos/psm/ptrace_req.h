@@ -36,6 +36,8 @@
 #define SYSCALL_TRACE_OFFSET	(0x8)
 #define PTRACE_OPTION_OFFSET	(0x10)
 #define PSW_SINGLESTEP		(0x4000000000000000)
+/* Max length of a PEEKDATA_RANGE or POKEDATA_RANGE request */
+#define PTRACE_RANGE_MAX	(64 * 1024 * 1024)
 
 #ifndef PTRACE_O_EXITKILL
 /* Only defined in Linux Kernel 3.8 or later.  */
@@ -83,6 +85,10 @@ int psm_ve_stop_process(struct ve_task_struct *);
 int psm_attach_ve_process(struct ve_task_struct *, pid_t, uid_t, gid_t, bool);
 int psm_ptrace_peekdata(struct ve_task_struct *, uint64_t, void *);
 int psm_ptrace_pokedata(struct ve_task_struct *, uint64_t, uint64_t);
+int psm_ptrace_peekdata_range(struct ve_task_struct *, uint64_t, uint64_t,
+		uint64_t);
+int psm_ptrace_pokedata_range(struct ve_task_struct *, uint64_t, uint64_t,
+		uint64_t);
 off_t psm_get_reg_offset(usr_reg_name_t);
 int psm_ptrace_peekuser(struct ve_task_struct *, uint64_t, void *);
 int psm_ptrace_pokeuser(struct ve_task_struct *, uint64_t, uint64_t);
@@ -44,6 +44,7 @@
 #include <sys/capability.h>
 #include <sys/mman.h>
 #include <sys/shm.h>
+#include <sys/uio.h>
 #include "task_mgmt.h"
 #include "mm_common.h"
 #include "ve_mem.h"
@@ -63,6 +64,9 @@
 #include "locking_handler.h"
 #include "psm_stat.h"
 
+/* "veos_acct_wait" Time to wait for room in accounting queue, in ms. */
+int veos_acct_wait = VE_ACCT_WAIT_DEFAULT_MLSECS;
+
 /**
 * @brief Get the content of register value of the VE process.
 *
@@ -315,6 +319,9 @@ hndl_return:
  *
  * @return 0 on success, -1 on failure.
  *
+ * @note Loads are read without node_sem, since each of them is
+ * updated by a single store in populate_1_5_15_sys_load().
+ *
  * @internal
  * @author PSMG / Scheduling and context switch
  */
@@ -322,82 +329,56 @@ int calc_last_1_5_15_load(struct ve_node_struct *p_ve_node,
 		double *sys_load_1, double *sys_load_5, double *sys_load_15)
 {
 	int retval = -1;
-	struct ve_sys_load *tmp = NULL;
-	struct list_head *p;
-	double load_1 = 0;
-	double load_5 = 0;
-	double load_15 = 0;
-	uint64_t time = 0;
-	int itr_1 = 0;
-	int itr_5 = 0;
-	int itr_15 = 0;
+
 	VEOS_TRACE("Entering");
 	if (!p_ve_node || !sys_load_1 || !sys_load_5 || !sys_load_15){
 		goto hndl_return;
 	}
-	/* To avoid deadlock due to sequence node_sem -> ve_relocate_lock */
-	pthread_rwlock_lock_unlock(&(VE_NODE(0)->ve_relocate_lock), UNLOCK,
-				"Failed to release ve_relocate_lock release lock");
-	/* acquiring semaphore for node */
-	if (-1 == sem_wait(&p_ve_node->node_sem)) {
-		VEOS_DEBUG("Node %d semaphore lock failed with errno: %d",
-				p_ve_node->node_num, errno);
-		goto hndl_error;
-	}
-	pthread_rwlock_lock_unlock(&(VE_NODE(0)->ve_relocate_lock), RDLOCK,
-				"Failed to acquire ve_relocate_lock read lock");
-	list_for_each_prev(p, &(p_ve_node->ve_sys_load_head)) {
-		tmp = list_entry(p, struct ve_sys_load, list);
-		if (time < (ONE_MIN * MICRO_SECONDS)) {
-			load_1 += tmp->sys_load;
-			itr_1++;
-		}
 
-		if (time < (FIVE_MIN * MICRO_SECONDS)) {
-			load_5 += tmp->sys_load;
-			itr_5++;
-		}
-		load_15 += tmp->sys_load;
-		itr_15++;
-		time += tmp->time_slice;
-	}
-	sem_post(&p_ve_node->node_sem);
-
-	/* calculate last 1 min load */
-	if (itr_1)
-		*sys_load_1 = load_1/(double)itr_1;
-	else
-		*sys_load_1 = 0;
-
-	/* calculate last 5 min load */
-	if (itr_5)
-		*sys_load_5 = load_5/(double)itr_5;
-	else
-		*sys_load_5 = 0;
-
-	/* calculate last 15 min load */
-	if (itr_15)
-		*sys_load_15 = load_15/(double)itr_15;
-	else
-		*sys_load_15 = 0;
-
-	VEOS_DEBUG("Load in last (1min %f itr %d) (5min %f itr %d)"
-			" (15min %f itr %d)",
-			*sys_load_1, itr_1,
-			*sys_load_5, itr_5,
-			*sys_load_5, itr_15);
+	*sys_load_1 = (double)p_ve_node->avenrun[0] / VE_LOAD_FIXED_1;
+	*sys_load_5 = (double)p_ve_node->avenrun[1] / VE_LOAD_FIXED_1;
+	*sys_load_15 = (double)p_ve_node->avenrun[2] / VE_LOAD_FIXED_1;
+
+	VEOS_DEBUG("Load in last 1min %f 5min %f 15min %f",
+			*sys_load_1, *sys_load_5, *sys_load_15);
 
 	retval = 0;
 hndl_return:
 	VEOS_TRACE("Exiting");
 	return retval;
-hndl_error:
-	veos_abort("Failed to acquire VE node semaphore for system load calculation");
 }
 
 /**
- * @brief It populates the list of VE system load for last 15min maximum
- * in the Node struct.
+ * @brief Decay a fixed point load average by one VE_LOAD_FREQ period.
+ *
+ * @param[in] load Current load average in fixed point
+ * @param[in] exp_n Decay factor of the load average
+ * @param[in] active Load in last period in fixed point
+ *
+ * @return New load average in fixed point
+ *
+ * @internal
+ * @author PSMG / Scheduling and context switch
+ */
+static unsigned long calc_load(unsigned long load, unsigned long exp_n,
+		unsigned long active)
+{
+	unsigned long newload;
+
+	newload = load * exp_n + active * (VE_LOAD_FIXED_1 - exp_n);
+	if (active >= load)
+		newload += VE_LOAD_FIXED_1 - 1;
+
+	return newload / VE_LOAD_FIXED_1;
+}
+
+/**
+ * @brief It updates the VE system load in last 1min, 5min, 15min
+ * maintained in the Node struct.
+ *
+ * Load of every scheduler interval is accumulated weighted by its time.
+ * Each time VE_LOAD_FREQ elapses, the average load of that period is
+ * folded into exponentially decayed load averages, as Linux does.
  *
  * @param[in] p_ve_node Pointer to VE node struct
  * @param[in] load Load on system at every scheduler interval
@@ -409,39 +390,30 @@ hndl_error:
 void populate_1_5_15_sys_load(struct ve_node_struct *p_ve_node,
 		double load, uint64_t time)
 {
-	struct ve_sys_load *ve_load = NULL;
-	struct ve_sys_load *tmp = NULL;
-	struct list_head *p;
+	unsigned long active = 0;
 
 	VEOS_TRACE("Entering");
 	if (!p_ve_node)
 		goto hndl_return;
 
-	/* Maximum last 15min load of VE system is maintained
-	 * when system load time increases from 15min entries from
-	 * the list are removed.
-	 */
-	while (p_ve_node->total_sys_load_time > (FIFTEEN_MIN * MICRO_SECONDS)) {
-		/* Removing the first element of the list */
-		p = p_ve_node->ve_sys_load_head.next;
-		tmp = list_entry(p, struct ve_sys_load, list);
-		p_ve_node->total_sys_load_time -= tmp->time_slice;
-		list_del(p);
-		free(tmp);
-	}
-
-	ve_load = malloc(sizeof(struct ve_sys_load));
-	if (NULL == ve_load) {
-		VEOS_CRIT("Internal memory allocation failed");
-		VEOS_DEBUG("Malloc failed due to: %s", strerror(errno));
+	p_ve_node->sys_load_sum += load * time;
+	p_ve_node->sys_load_time += time;
+	if (p_ve_node->sys_load_time < VE_LOAD_FREQ)
 		goto hndl_return;
-	}
-	/*MEMSET*/
-	memset(ve_load, '\0', sizeof(struct ve_sys_load));
-	ve_load->sys_load = load;
-	ve_load->time_slice = time;
-	p_ve_node->total_sys_load_time += time;
-	list_add_tail(&(ve_load->list), &(p_ve_node->ve_sys_load_head));
+
+	active = (unsigned long)((p_ve_node->sys_load_sum /
+			p_ve_node->sys_load_time) * VE_LOAD_FIXED_1);
+	/* Scheduler may have been stopped for more than a period */
+	while (p_ve_node->sys_load_time >= VE_LOAD_FREQ) {
+		p_ve_node->avenrun[0] = calc_load(p_ve_node->avenrun[0],
+				VE_LOAD_EXP_1, active);
+		p_ve_node->avenrun[1] = calc_load(p_ve_node->avenrun[1],
+				VE_LOAD_EXP_5, active);
+		p_ve_node->avenrun[2] = calc_load(p_ve_node->avenrun[2],
+				VE_LOAD_EXP_15, active);
+		p_ve_node->sys_load_time -= VE_LOAD_FREQ;
+	}
+	p_ve_node->sys_load_sum = load * p_ve_node->sys_load_time;
 hndl_return:
 	VEOS_TRACE("Exiting");
 }
@@ -460,7 +432,7 @@ void calc_sys_load_per_sched_interval(struct ve_node_struct *p_ve_node)
 	int core_loop = 0;
 	double per_core_load;
 	double per_node_load = 0;
-	struct timeval now;
+	uint64_t now = 0;
 	uint64_t time_slice = 0;
 	uint64_t nr_active = 0;
 
@@ -468,8 +440,8 @@ void calc_sys_load_per_sched_interval(struct ve_node_struct *p_ve_node)
 	if (!p_ve_node)
 		goto hndl_return;
 
-	gettimeofday(&now, NULL);
-	time_slice = timeval_diff(now, p_ve_node->sched_stime);
+	now = psm_mono_nsec();
+	time_slice = (now - p_ve_node->sched_stime) / USECS_TO_NANOSECONDS;
 	p_ve_node->sched_stime = now;
 	for (; core_loop < p_ve_node->nr_avail_cores; core_loop++) {
 		p_ve_core = VE_CORE(p_ve_node->node_num, core_loop);
@@ -480,7 +452,8 @@ void calc_sys_load_per_sched_interval(struct ve_node_struct *p_ve_node)
 		}
 
 		per_core_load = (double)((p_ve_core->busy_time -
-				p_ve_core->busy_time_prev) / (double)time_slice);
+				p_ve_core->busy_time_prev) /
+				((double)time_slice * USECS_TO_NANOSECONDS));
 		nr_active += p_ve_core->nr_active;
 		VEOS_TRACE("Load On Core %d (In %.2f Sec) is %.2f%%",
 				core_loop,
@@ -537,6 +510,25 @@ long long timeval_diff(struct timeval end_time, struct timeval start_time)
 	return USECOND*difference.tv_sec + difference.tv_usec;
 }
 
+/**
+ * @brief Get monotonic time in nanoseconds.
+ *
+ * CLOCK_MONOTONIC is read through vDSO without a system call and does not
+ * jump when system time is changed, so it is used for CPU time accounting.
+ *
+ * @return Monotonic time in nanoseconds
+ *
+ * @internal
+ * @author PSMG / Scheduling and context switch
+ */
+uint64_t psm_mono_nsec(void)
+{
+	struct timespec ts = {0};
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * SECS_TO_NANOSECONDS) + ts.tv_nsec;
+}
+
 /**
  * @brief This function temporarly store/restore the s/w
  * context of user registers of processes.
@@ -1790,10 +1782,282 @@ static comp_t veos_encode_comp_t(unsigned long val)
 	return exp;
 }
 
+/**
+ * @brief Write accounting records to the accounting file.
+ *
+ * A short write is resumed from the first byte not written, so that a
+ * record is never cut in the file unless writev() fails.
+ *
+ * @param[in] fd File descriptor of the accounting file
+ * @param[in,out] iov One iovec per record, modified on a short write
+ * @param[in] nr Number of records
+ *
+ * @return Number of records completely written.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+static int veos_acct_write_records(int fd, struct iovec *iov, int nr)
+{
+	ssize_t retval = -1;
+	size_t done = 0, total = nr * sizeof(struct ve_acct);
+	int idx = 0;
+
+	while (done < total) {
+		retval = writev(fd, &iov[idx], nr - idx);
+		if (-1 == retval && EINTR == errno)
+			continue;
+		if (0 >= retval) {
+			VEOS_ERROR("Failed to write in accounting file");
+			VEOS_DEBUG("Writing in accounting file failed "
+					"due to: %s", (-1 == retval) ?
+					strerror(errno) : "no progress");
+			break;
+		}
+		done += retval;
+		/* Skip the records written, resume inside a partial one */
+		while (idx < nr && (size_t)retval >= iov[idx].iov_len) {
+			retval -= iov[idx].iov_len;
+			idx++;
+		}
+		if (idx < nr) {
+			iov[idx].iov_base = (char *)iov[idx].iov_base + retval;
+			iov[idx].iov_len -= retval;
+		}
+	}
+	return done / sizeof(struct ve_acct);
+}
+
+/**
+ * @brief Write queued accounting records to the accounting file.
+ *
+ * Records are handed to writev() straight from the ring, in batches of
+ * at most VE_ACCT_IOV_MAX. Records which could not be written are
+ * counted in nr_dropped. Records queued while accounting is disabled
+ * are discarded.
+ *
+ * @note Caller must hold ve_acct_lock.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+static void veos_acct_flush_locked(void)
+{
+	struct iovec iov[VE_ACCT_IOV_MAX];
+	struct ve_acct_slot *slot = NULL;
+	uint64_t pos = veos_acct.tail;
+	int nr = 0, i = 0, written = 0;
+
+	if (NULL == veos_acct.ring)
+		return;
+
+	for (;;) {
+		for (nr = 0; nr < VE_ACCT_IOV_MAX; nr++) {
+			slot = &veos_acct.ring[(pos + nr) &
+					(VE_ACCT_RING_SIZE - 1)];
+			if (slot->seq != pos + nr + 1)
+				break;
+			iov[nr].iov_base = &slot->rec;
+			iov[nr].iov_len = sizeof(struct ve_acct);
+		}
+		if (0 == nr)
+			break;
+		/* Do not read a record before its sequence number */
+		__sync_synchronize();
+
+		if (-1 != veos_acct.fd) {
+			written = veos_acct_write_records(veos_acct.fd, iov, nr);
+			veos_acct.nr_written += written;
+			if (written < nr)
+				__sync_fetch_and_add(&veos_acct.nr_dropped,
+						nr - written);
+			VEOS_DEBUG("%d of %d records dumped in accounting "
+					"file: %s", written, nr, veos_acct.file);
+		}
+
+		/* Hand the slots back to producers */
+		__sync_synchronize();
+		for (i = 0; i < nr; i++)
+			veos_acct.ring[(pos + i) & (VE_ACCT_RING_SIZE - 1)].seq =
+				pos + i + VE_ACCT_RING_SIZE;
+		pos += nr;
+		veos_acct.tail = pos;
+	}
+}
+
+/**
+ * @brief Queue an accounting record for the writer thread.
+ *
+ * Any number of exiting tasks may queue records concurrently; a slot is
+ * reserved by advancing the head of the ring and published by updating
+ * its sequence number.
+ *
+ * @param[in] rec Accounting record to queue
+ *
+ * @return 0 on success, -1 if the queue is full.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+static int veos_acct_enqueue(struct ve_acct *rec)
+{
+	struct ve_acct_slot *slot = NULL;
+	uint64_t pos = 0;
+	int64_t dif = 0;
+
+	pos = veos_acct.head;
+	for (;;) {
+		slot = &veos_acct.ring[pos & (VE_ACCT_RING_SIZE - 1)];
+		dif = (int64_t)(slot->seq - pos);
+		if (0 == dif) {
+			if (__sync_bool_compare_and_swap(&veos_acct.head,
+						pos, pos + 1))
+				break;
+		} else if (0 > dif) {
+			return -1;
+		}
+		pos = veos_acct.head;
+	}
+
+	memcpy(&slot->rec, rec, sizeof(struct ve_acct));
+	__sync_synchronize();
+	slot->seq = pos + 1;
+	sem_post(&veos_acct.ring_sem);
+	return 0;
+}
+
+/**
+ * @brief Thread writing queued accounting records.
+ *
+ * @param[in] arg Unused
+ *
+ * @return NULL always.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+static void *veos_acct_writer(void *arg)
+{
+	bool stop = false;
+
+	VEOS_TRACE("Entering");
+	while (!stop) {
+		if (-1 == sem_wait(&veos_acct.ring_sem)) {
+			if (EINTR == errno)
+				continue;
+			VEOS_ERROR("Accounting writer failed to wait: %s",
+					strerror(errno));
+			break;
+		}
+		/* Records queued meanwhile are written by this flush */
+		while (0 == sem_trywait(&veos_acct.ring_sem))
+			;
+
+		pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), LOCK,
+			"Failed to acquire task accounting lock");
+		veos_acct_flush_locked();
+		stop = veos_acct.writer_stop;
+		pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), UNLOCK,
+			"Failed to release task accounting lock");
+	}
+	VEOS_TRACE("Exiting");
+	return NULL;
+}
+
+/**
+ * @brief Allocate the accounting record queue and start its writer thread.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+int veos_acct_init(void)
+{
+	int retval = -1;
+	int i = 0;
+
+	VEOS_TRACE("Entering");
+	veos_acct.ring = calloc(VE_ACCT_RING_SIZE, sizeof(struct ve_acct_slot));
+	if (NULL == veos_acct.ring) {
+		VEOS_CRIT("Failed to allocate accounting queue: %s",
+				strerror(errno));
+		goto hndl_return;
+	}
+	for (i = 0; i < VE_ACCT_RING_SIZE; i++)
+		veos_acct.ring[i].seq = i;
+	veos_acct.head = 0;
+	veos_acct.tail = 0;
+	veos_acct.nr_dropped = 0;
+	veos_acct.nr_written = 0;
+	veos_acct.writer_stop = false;
+
+	if (-1 == sem_init(&veos_acct.ring_sem, 0, 0)) {
+		VEOS_CRIT("Failed to initialize accounting semaphore: %s",
+				strerror(errno));
+		goto hndl_free;
+	}
+
+	retval = pthread_create(&veos_acct.writer, NULL,
+			veos_acct_writer, NULL);
+	if (0 != retval) {
+		VEOS_CRIT("Failed to create accounting writer: %s",
+				strerror(retval));
+		retval = -1;
+		sem_destroy(&veos_acct.ring_sem);
+		goto hndl_free;
+	}
+	retval = 0;
+	goto hndl_return;
+hndl_free:
+	free(veos_acct.ring);
+	veos_acct.ring = NULL;
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Stop the accounting writer thread and write pending records.
+ *
+ * @internal
+ * @author PSMG / Process management
+ */
+void veos_acct_fini(void)
+{
+	VEOS_TRACE("Entering");
+	if (NULL == veos_acct.ring)
+		goto hndl_return;
+
+	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), LOCK,
+		"Failed to acquire task accounting lock");
+	veos_acct.writer_stop = true;
+	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), UNLOCK,
+		"Failed to release task accounting lock");
+	sem_post(&veos_acct.ring_sem);
+	pthread_join(veos_acct.writer, NULL);
+
+	/* Records queued after the writer's last flush */
+	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), LOCK,
+		"Failed to acquire task accounting lock");
+	veos_acct_flush_locked();
+	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), UNLOCK,
+		"Failed to release task accounting lock");
+
+	if (veos_acct.nr_dropped)
+		VEOS_INFO("%lu accounting records were dropped",
+				veos_acct.nr_dropped);
+hndl_return:
+	VEOS_TRACE("Exiting");
+}
+
 /**
  * @brief Dump the accounting information of struct ve_acct in a
  * accounting file.
  *
+ * The record is queued for the accounting writer thread. If the queue
+ * stays full for veos_acct_wait milliseconds the record is dropped.
+ *
  * @param[in] tsk Pointer to VE task struct
  *
  * @internal
@@ -1804,10 +2068,11 @@ void veos_acct_ve_proc(struct ve_task_struct *tsk)
 	struct pacct_struct *pacct = NULL;
 	struct ve_acct acct_info = {0};
 	struct timeval now = {0};
-	int retval = -1;
+	struct timespec delay = {0, 1000 * 1000};
+	int waited = 0;
 
 	VEOS_TRACE("Entering");
-	if (!tsk)
+	if (!tsk || NULL == veos_acct.ring)
 		goto hndl_return;
 
 	pacct = &(tsk->sighand->pacct);
@@ -1845,7 +2110,8 @@ void veos_acct_ve_proc(struct ve_task_struct *tsk)
 	acct_info.ac_stime = 0;
 
 	/* Time spend by the process while scheduled on VE core */
-	acct_info.ac_utime = veos_encode_comp_t(pacct->ac_utime/USECOND);
+	acct_info.ac_utime = veos_encode_comp_t(pacct->ac_utime /
+			SECS_TO_NANOSECONDS);
 
 	/* Average memory usage (kB) */
 	acct_info.ac_mem = veos_encode_comp_t(pacct->ac_mem);
@@ -1853,17 +2119,19 @@ void veos_acct_ve_proc(struct ve_task_struct *tsk)
 	/* Command name of the program */
 	strncpy(acct_info.ac_comm, tsk->ve_comm, sizeof(tsk->ve_comm));
 
-	/* Write struct ve_acct to file */
-	retval = write(veos_acct.fd, (char *)&acct_info,
-			sizeof(struct ve_acct));
-	if (-1 == retval) {
-		VEOS_ERROR("Failed to write in accounting file");
-		VEOS_DEBUG("Writing in accounting file failed due to: %s",
-				strerror(errno));
+	/* Queue struct ve_acct for the writer thread */
+	while (-1 == veos_acct_enqueue(&acct_info)) {
+		if (waited >= veos_acct_wait) {
+			__sync_fetch_and_add(&veos_acct.nr_dropped, 1);
+			VEOS_ERROR("Accounting queue full, record of PID %d "
+					"dropped", tsk->pid);
+			goto hndl_return;
+		}
+		sem_post(&veos_acct.ring_sem);
+		nanosleep(&delay, NULL);
+		waited++;
 	}
-
-	VEOS_DEBUG("Data is successfully dumped in accounting file: %s",
-			veos_acct.file);
+	VEOS_DEBUG("Accounting record of PID %d queued", tsk->pid);
 hndl_return:
 	VEOS_TRACE("Exiting");
 	return;
@@ -2943,7 +3211,7 @@ uint64_t get_ve_proc_exec_time(struct ve_task_struct *tsk, int flag)
 			LOCK, "Failed to acquire thread-group-mm-lock");
 
 	if (flag) {
-		VEOS_DEBUG("Process with PID %d execution time(microsec) %lu",
+		VEOS_DEBUG("Process with PID %d execution time(nanosec) %lu",
 				group_leader->pid, group_leader->exec_time);
 		total_time = group_leader->exec_time + group_leader->sighand->utime;
 		if (!list_empty(&group_leader->thread_group)) {
@@ -3001,9 +3269,6 @@ int psm_handle_clk_cputime_request(struct ve_task_struct *tsk,
 
 	total_time = get_ve_proc_exec_time(tsk, flag);
 
-	/* Converting to nanoseconds */
-	total_time *= 1000;
-
 	tp->tv_sec = total_time/SECS_TO_NANOSECONDS;
 	tp->tv_nsec = total_time%SECS_TO_NANOSECONDS;
 
@@ -3407,16 +3672,19 @@ int psm_handle_get_rusage_request(struct ve_task_struct *tsk,
 
 	if (who == RUSAGE_SELF) {
 		total_time = get_ve_proc_exec_time(tsk, 1);
-		ve_r->ru_utime.tv_sec = total_time/1000000;
-		ve_r->ru_utime.tv_usec = total_time%1000000;
+		ve_r->ru_utime.tv_sec = total_time / SECS_TO_NANOSECONDS;
+		ve_r->ru_utime.tv_usec = (total_time % SECS_TO_NANOSECONDS) /
+			USECS_TO_NANOSECONDS;
 	} else if (who == RUSAGE_THREAD) {
 		total_time = get_ve_proc_exec_time(tsk, 0);
-		ve_r->ru_utime.tv_sec = total_time/1000000;
-		ve_r->ru_utime.tv_usec = total_time%1000000;
+		ve_r->ru_utime.tv_sec = total_time / SECS_TO_NANOSECONDS;
+		ve_r->ru_utime.tv_usec = (total_time % SECS_TO_NANOSECONDS) /
+			USECS_TO_NANOSECONDS;
 	} else if (who == RUSAGE_CHILDREN) {
 		total_time = tsk->sighand->cexec_time;
-		ve_r->ru_utime.tv_sec = total_time/1000000;
-		ve_r->ru_utime.tv_usec = total_time%1000000;
+		ve_r->ru_utime.tv_sec = total_time / SECS_TO_NANOSECONDS;
+		ve_r->ru_utime.tv_usec = (total_time % SECS_TO_NANOSECONDS) /
+			USECS_TO_NANOSECONDS;
 	} else
 		goto hndl_return;
 
@@ -3517,6 +3785,12 @@ hndl_return:
 /**
  * @brief Enable/disable process accounting.
  *
+ * Records reserved in the queue before the switch are written to the
+ * previous file: the switch waits until their producers publish them.
+ * A task which found accounting active just before the switch but
+ * reserves its slot after it may still have its record in the new
+ * file.
+ *
  * @param[in] file_name Filename to append accouting detail
  *
  * @return 0 on success, -errno on failure.
@@ -3528,12 +3802,24 @@ int psm_handle_do_acct_ve(char *file_name)
 {
 	int retval = -1;
 	int fd = -1;
+	uint64_t end = 0;
+	struct timespec delay = {0, 1000 * 1000};
 
 	VEOS_TRACE("Entering");
 	/* Disable previous accounting */
 	pthread_mutex_lock_unlock(&(veos_acct.ve_acct_lock), LOCK,
 		"Failed to acquire task accounting lock");
 	veos_acct.active = false;
+	/* Records of the previous file still belong to it, including the
+	 * ones reserved but not yet published by their producers */
+	__sync_synchronize();
+	end = veos_acct.head;
+	veos_acct_flush_locked();
+	while (NULL != veos_acct.ring &&
+			(int64_t)(end - veos_acct.tail) > 0) {
+		nanosleep(&delay, NULL);
+		veos_acct_flush_locked();
+	}
 	if (NULL != veos_acct.file) {
 		free(veos_acct.file);
 		veos_acct.file = NULL;
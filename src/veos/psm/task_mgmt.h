@@ -56,6 +56,7 @@
 
 #define SECS_TO_MICROSECONDS (1000 * 1000)
 #define SECS_TO_NANOSECONDS (1000 * 1000 * 1000)
+#define USECS_TO_NANOSECONDS 1000
 #define BITS_PER_BYTE	8
 #define ACCT_COMM 16
 
@@ -66,6 +67,14 @@
 #define VE_PROC_PRIORITY_MIN		0
 
 #define VE_ACCT_VERSION		3
+/* Number of accounting records queued for the writer thread, power of 2 */
+#define VE_ACCT_RING_SIZE	4096
+/* Maximum number of records written by one writev() */
+#define VE_ACCT_IOV_MAX		64
+/* Time an exiting process waits for room in the queue, in milliseconds */
+#define VE_ACCT_WAIT_MIN_MLSECS		0
+#define VE_ACCT_WAIT_MAX_MLSECS		60000
+#define VE_ACCT_WAIT_DEFAULT_MLSECS	100
 
 /**
  * This macro will be used to check the load on VE system .
@@ -74,6 +83,17 @@
 #define FIVE_MIN 300
 #define FIFTEEN_MIN 900
 
+/**
+ * Fixed point exponential decay of VE system load.
+ * VE_LOAD_EXP_n is VE_LOAD_FIXED_1/exp(VE_LOAD_FREQ/n min).
+ */
+#define VE_LOAD_FSHIFT 11
+#define VE_LOAD_FIXED_1 (1UL << VE_LOAD_FSHIFT)
+#define VE_LOAD_FREQ (5 * USECOND)
+#define VE_LOAD_EXP_1 1884
+#define VE_LOAD_EXP_5 2014
+#define VE_LOAD_EXP_15 2037
+
 /**
  * This macro will be used for difference between two timestamp .
  */
@@ -221,7 +241,7 @@ struct pacct_struct {
 	int ac_flag; /*!< status of the process when it terminated */
 	__u32 ac_exitcode; /*!< task exit code passed to the exit system call */
 	unsigned long ac_mem; /*!< Memory usage */
-	cputime_t ac_utime; /*!< Time spend by the process while scheduled on VE core */
+	cputime_t ac_utime; /*!< Time (ns) spend by the process while scheduled on VE core */
 };
 
 /**
@@ -249,6 +269,14 @@ struct ve_acct {
 	char            ac_comm[ACCT_COMM];     /*!< Command Name */
 };
 
+/**
+ * @brief Slot of the accounting record queue
+ */
+struct ve_acct_slot {
+	volatile uint64_t seq; /*!< Queue position the slot is ready for */
+	struct ve_acct rec; /*!< Accounting record */
+};
+
 /**
  * @brief VE Core struct
  */
@@ -266,13 +294,17 @@ struct ve_core_struct {
 	core_system_reg_t *sys_regs_addr; /*!< Core system registers */
 	pthread_rwlock_t ve_core_lock; /*!< Mutex Lock for per core while ADD/DEL of a VE task */
 	volatile enum context_switch scheduling_status; /*!< VE core scheduling status */
-	uint64_t busy_time; /*!< Core execution time */
-	uint64_t busy_time_prev; /*!< Core execution time on last scheduler interval */
+	uint64_t busy_time; /*!< Core execution time (ns) */
+	uint64_t busy_time_prev; /*!< Core execution time (ns) on last scheduler interval */
 	struct timeval core_uptime; /*!< Core start time */
-	struct timeval core_stime; /*!< Time when core started after halt */
+	uint64_t core_stime; /*!< Monotonic time (ns) when core started after halt */
 	bool core_running; /*!< Core running/halt status */
 	uint64_t nr_switches; /*!< Number of context switches on core */
 	sem_t core_sem; /* Semaphore for performing scheduling on core */
+	sem_t sched_kick; /* Posted by scheduler timer to schedule on core */
+	uint64_t halt_lat_hist[VE_CORE_LAT_HIST_NR]; /*!< Histogram of core halt latency */
+	uint64_t start_lat_hist[VE_CORE_LAT_HIST_NR]; /*!< Histogram of core start latency */
+	pthread_t sched_th; /* Scheduler worker thread of core */
 };
 
 /**
@@ -289,9 +321,9 @@ struct sighand_struct {
 	uint64_t lshm_addr;	/*!< Shared page address */
 	int got_sigint; /*!< used to trace sigint to turn off coredumping*/
 	int ve_sigpending; /*!< No. of pending signals */
-	uint64_t cexec_time; /*!< VE process execution time on VE core of its children */
+	uint64_t cexec_time; /*!< VE process execution time (ns) on VE core of its children */
 	int signal_flag; /*!< Signal coredump flag */
-	uint64_t utime; /*!< execution time for threads in threads group that have exited */
+	uint64_t utime; /*!< execution time (ns) for threads in threads group that have exited */
 };
 
 /**
@@ -403,11 +435,11 @@ struct ve_task_struct {
 				      * Performance Register context bitmap to check whether the
 				      * context of a VE process is updated
 				      */
-	struct timeval stime; /*!< Start time of a VE process on every scheduler interval */
+	uint64_t stime; /*!< Monotonic time (ns) when VE process started on core last */
 	struct timeval start_time; /*!< Start time of a VE process */
 	uint64_t nvcsw; /*!< Number of voluntary context switches */
 	uint64_t nivcsw; /*!< Number of Involuntary context switches */
-	uint64_t exec_time; /*!< VE process time on VE core */
+	uint64_t exec_time; /*!< VE process time (ns) on VE core */
 	enum wait_for_vfork vfork_state; /*!< Wait for vforked child to complete execution */
 	bool vforked_proc; /*!< Is it vforked child */
 	bool execed_proc; /*!< Is it created using execve() */
@@ -538,6 +570,7 @@ void psm_reparent_children(struct ve_task_struct *group_leader);
 void print_process_tree(struct ve_task_struct *);
 void list_init_tasks(void);
 long long timeval_diff(struct timeval, struct timeval);
+uint64_t psm_mono_nsec(void);
 int psm_handle_clk_cputime_request(struct ve_task_struct *, int, struct timespec *);
 int psm_handle_get_rlimit_request(int, struct ve_task_struct *, int, struct rlimit *, uid_t, gid_t);
 int psm_handle_set_rlimit_request(int, struct ve_task_struct *, int, struct rlimit, uid_t, gid_t);
@@ -550,6 +583,8 @@ int psm_handle_sysinfo_request(struct ve_task_struct *, struct sysinfo *);
 int psm_handle_do_acct_ve(char *);
 void psm_acct_collect(int, struct ve_task_struct *);
 void veos_acct_ve_proc(struct ve_task_struct *);
+int veos_acct_init(void);
+void veos_acct_fini(void);
 int alloc_ve_task_data(struct ve_task_struct *);
 int amm_init_dmaatb(dmaatb_reg_t *);
 int psm_handle_set_reg_req(struct ve_task_struct *, usr_reg_name_t, reg_t, int64_t);
@@ -557,4 +592,6 @@ void psm_st_rst_context(struct ve_task_struct *, reg_t *, reg_t *, bool);
 void psm_set_task_state(struct ve_task_struct *, enum proc_state);
 void psm_do_process_cleanup(struct ve_task_struct *, struct ve_task_struct *, int);
 int psm_get_regval(struct ve_task_struct *, int, int *, uint64_t *);
+/* "veos_acct_wait" Time to wait for room in accounting queue, in ms. */
+extern int veos_acct_wait;
 #endif
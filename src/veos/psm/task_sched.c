@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <errno.h>
+#include <time.h>
 #include "task_sched.h"
 #include "velayout.h"
 #include "task_mgmt.h"
@@ -555,6 +556,54 @@ bool psm_check_udma_desc(struct ve_task_struct *ve_task)
 	return retval;
 }
 
+/**
+ * @brief Get monotonic time in microseconds.
+ *
+ * @return Monotonic time in microseconds
+ */
+static uint64_t psm_mono_usec(void)
+{
+	return psm_mono_nsec() / USECS_TO_NANOSECONDS;
+}
+
+/**
+ * @brief Back off while polling a core register.
+ *
+ * Register is polled without sleeping CORE_WAIT_SPIN_COUNT times,
+ * then sleep between polls grows exponentially up to
+ * CORE_WAIT_SLEEP_MAX_NS.
+ *
+ * @param[in,out] nr_poll Number of polls done so far
+ * @param[in,out] sleep_ns Next sleep time in nanoseconds
+ */
+static void psm_core_wait_backoff(int *nr_poll, long *sleep_ns)
+{
+	struct timespec ts = {0};
+
+	if (++(*nr_poll) <= CORE_WAIT_SPIN_COUNT)
+		return;
+
+	ts.tv_nsec = *sleep_ns;
+	nanosleep(&ts, NULL);
+	if (*sleep_ns < CORE_WAIT_SLEEP_MAX_NS)
+		*sleep_ns *= 2;
+}
+
+/**
+ * @brief Account a core halt/start latency in histogram.
+ *
+ * @param[in,out] hist Latency histogram of core
+ * @param[in] usec Latency in microseconds
+ */
+static void psm_core_lat_account(uint64_t *hist, uint64_t usec)
+{
+	int idx = 0;
+
+	while ((idx < VE_CORE_LAT_HIST_NR - 1) && (usec >= (1UL << idx)))
+		idx++;
+	__sync_fetch_and_add(&hist[idx], 1);
+}
+
 /**
  * @brief Change the core state to HALT by setting EXS register as EXS_STOP.
  *
@@ -582,11 +631,13 @@ int psm_halt_ve_core(int node_id, int core_id, reg_t *regdata,
 		bool scheduler_expiry)
 {
 	int retval = -1;
-	struct timeval now = {0};
+	uint64_t now = 0;
 	struct ve_core_struct *p_ve_core = NULL;
-	time_t endwait = 0;
+	uint64_t start_usec = 0, endwait = 0;
 	reg_t temp_reg = 0x0;
 	int wait_time = HALT_CORE_MAX_TIME;
+	int nr_poll = 0;
+	long sleep_ns = CORE_WAIT_SLEEP_MIN_NS;
 	struct ve_task_struct *curr_ve_task = NULL;
 
 	VEOS_TRACE("Entering");
@@ -597,8 +648,7 @@ int psm_halt_ve_core(int node_id, int core_id, reg_t *regdata,
 	 * When halt core request is made while initialising core's,
 	 * simply halt the core.
 	 * */
-	if (!p_ve_core->core_stime.tv_sec &&
-			!p_ve_core->core_stime.tv_usec)
+	if (!p_ve_core->core_stime)
 		goto halt_core;
 
 	/* If core state is already stopped, just fetch
@@ -619,16 +669,15 @@ int psm_halt_ve_core(int node_id, int core_id, reg_t *regdata,
 	}
 
 	/* Update VE core busy time and VE process execution time and  */
-	gettimeofday(&now, NULL);
+	now = psm_mono_nsec();
 
 	if (true == p_ve_core->core_running) {
-		p_ve_core->busy_time +=
-			timeval_diff(now, p_ve_core->core_stime);
+		p_ve_core->busy_time += now - p_ve_core->core_stime;
 		p_ve_core->core_running = false;
 		if (curr_ve_task) {
-			curr_ve_task->time_slice -=
-				timeval_diff(now, curr_ve_task->stime);
-			psm_calc_task_exec_time(curr_ve_task);
+			curr_ve_task->time_slice -= (now -
+				curr_ve_task->stime) / USECS_TO_NANOSECONDS;
+			psm_calc_task_exec_time(curr_ve_task, now);
 		}
 	}
 
@@ -644,8 +693,8 @@ int psm_halt_ve_core(int node_id, int core_id, reg_t *regdata,
 			VEOS_DEBUG("Time slice remaining %ld",
 					curr_ve_task->time_slice);
 			p_ve_core->core_running = true;
-			gettimeofday(&(curr_ve_task->stime), NULL);
-			gettimeofday(&(p_ve_core->core_stime), NULL);
+			curr_ve_task->stime = now;
+			p_ve_core->core_stime = now;
 			return -1;
 		} else {
 			VEOS_DEBUG("Process time slice exhausted"
@@ -667,9 +716,10 @@ halt_core:
 	}
 
 	/* Wait for EXS_STOP to get updated in core register.
-	 * We wait for 30 seconds
+	 * We wait for 30 seconds, spinning first and then sleeping
 	 * */
-	endwait = time(NULL) + wait_time;
+	start_usec = psm_mono_usec();
+	endwait = start_usec + (wait_time * USECOND);
 	do {
 		retval = vedl_get_usr_reg(VE_HANDLE(node_id),
 				VE_CORE_USR_REG_ADDR(node_id,
@@ -685,8 +735,9 @@ halt_core:
 		if(temp_reg == 1)
 			break;
 
-		if (time(NULL) >= endwait)
+		if (psm_mono_usec() >= endwait)
 			break;
+		psm_core_wait_backoff(&nr_poll, &sleep_ns);
 	} while (1);
 
 	/* Invoke veos_abort */
@@ -696,6 +747,9 @@ halt_core:
 		goto hndl_return;
 	}
 
+	psm_core_lat_account(p_ve_core->halt_lat_hist,
+			psm_mono_usec() - start_usec);
+
 	/* Set VE core state to STOP */
 	SET_CORE_STATE(p_ve_core->ve_core_state, STOPPED);
 
@@ -730,8 +784,10 @@ int psm_start_ve_core(int node_id, int core_id)
 	int retval;
 	struct ve_core_struct *p_ve_core = NULL;
 	p_ve_core = VE_CORE(node_id, core_id);
-	time_t endwait = 0;
+	uint64_t start_usec = 0, endwait = 0;
 	int wait_time = START_CORE_MAX_TIME;
+	int nr_poll = 0;
+	long sleep_ns = CORE_WAIT_SLEEP_MIN_NS;
 	reg_t regdata = 0;
 
 	VEOS_TRACE("Entering");
@@ -752,7 +808,8 @@ int psm_start_ve_core(int node_id, int core_id)
 		goto hndl_return;
 	}
 
-	endwait = time(NULL) + wait_time;
+	start_usec = psm_mono_usec();
+	endwait = start_usec + (wait_time * USECOND);
 	do {
 		retval = vedl_get_usr_reg(VE_HANDLE(node_id),
 				VE_CORE_USR_REG_ADDR(node_id,
@@ -766,8 +823,9 @@ int psm_start_ve_core(int node_id, int core_id)
 		}
 		if (regdata & EXS_RUN)
 			break;
-		if (time(NULL) >= endwait)
+		if (psm_mono_usec() >= endwait)
 			break;
+		psm_core_wait_backoff(&nr_poll, &sleep_ns);
 	} while (1);
 
 	if (!(regdata & EXS_RUN)) {
@@ -777,12 +835,15 @@ int psm_start_ve_core(int node_id, int core_id)
 		goto hndl_return;
 	}
 
+	psm_core_lat_account(p_ve_core->start_lat_hist,
+			psm_mono_usec() - start_usec);
+
 	/* Set core state to EXECUTING */
 	SET_CORE_STATE(p_ve_core->ve_core_state, EXECUTING);
 
 	p_ve_core->core_running = true;
-	gettimeofday(&(p_ve_core->core_stime), NULL);
-	gettimeofday(&(p_ve_core->curr_ve_task->stime), NULL);
+	p_ve_core->core_stime = psm_mono_nsec();
+	p_ve_core->curr_ve_task->stime = p_ve_core->core_stime;
 	retval = 0;
 	VEOS_DEBUG("Core: %d EXS: %lx", core_id, regdata);
 	VEOS_TRACE("Exiting");
@@ -1020,19 +1081,17 @@ dma_migration_fail:
 * @brief Calculate VE task execution time on core.
 *
 * @param curr_ve_tas Pointer to ve_task _struct
+* @param now Monotonic time (ns) read by the caller for this switch
 *
 * @return 0 on success and -1 when execution time
 * exceeds hard limit for RLIMIT_CPU.
 */
-int psm_calc_task_exec_time(struct ve_task_struct *curr_ve_task)
+int psm_calc_task_exec_time(struct ve_task_struct *curr_ve_task, uint64_t now)
 {
-	struct timeval now_time = {0};
 	int retval = 0;
 
 	VEOS_TRACE("Entering");
-	gettimeofday(&now_time, NULL);
-	curr_ve_task->exec_time += timeval_diff(now_time,
-			(curr_ve_task->stime));
+	curr_ve_task->exec_time += now - curr_ve_task->stime;
 
 	VEOS_DEBUG("Core %d PID %d Exec Time %ld",
 			curr_ve_task->p_ve_core->core_num,
@@ -1045,7 +1104,7 @@ int psm_calc_task_exec_time(struct ve_task_struct *curr_ve_task)
 	 * is send to VE process, if exceeds the hard limit
 	 * then SIGKILL is send.
 	 */
-	if (((curr_ve_task->exec_time)/(double)MICRO_SECONDS) >
+	if (((curr_ve_task->exec_time)/(double)SECS_TO_NANOSECONDS) >
 			curr_ve_task->sighand->rlim[RLIMIT_CPU]
 			.rlim_max) {
 		VEOS_INFO("CPU Hard limit exceeded, "
@@ -1056,7 +1115,7 @@ int psm_calc_task_exec_time(struct ve_task_struct *curr_ve_task)
 		goto ret;
 	}
 	if (!curr_ve_task->cpu_lim_exceed) {
-		if (((curr_ve_task->exec_time)/(double)MICRO_SECONDS) >
+		if (((curr_ve_task->exec_time)/(double)SECS_TO_NANOSECONDS) >
 				curr_ve_task->sighand->rlim[RLIMIT_CPU]
 				.rlim_cur) {
 			VEOS_INFO("CPU Soft limit exceeded, "
@@ -2040,6 +2099,73 @@ veos_update_atb_fail:
 	return retval;
 }
 
+/**
+* @brief Halt all the threads of thread group so that VEOS can update
+* their ATB together with the VE memory it maps.
+*
+* Function marks the ATB as dirty for the thread group and halts all the
+* cores where threads of the thread group are executing. The halted cores
+* are not started until psm_resume_thread_group() is invoked.
+*
+* @param[in] ve_task Pointer to VE task struct
+* @param[out] core_set Bitmap of halted core id's
+*
+* @return Returns -1 on failure and 0 on success
+*/
+int psm_halt_thread_group(struct ve_task_struct *ve_task, uint64_t *core_set)
+{
+	reg_t *exception_arr = NULL;
+
+	VEOS_TRACE("Entering");
+
+	*core_set = 0;
+	exception_arr = (reg_t *)malloc(
+			VE_NODE(0)->nr_avail_cores * sizeof(reg_t));
+	if (!exception_arr) {
+		VEOS_CRIT("Internal Memory allocation failed");
+		return -1;
+	}
+	memset(exception_arr, 0, VE_NODE(0)->nr_avail_cores * sizeof(reg_t));
+
+	update_atb_crd_dirty(ve_task, _ATB);
+	psm_check_sched_jid_core(core_set, ve_task, _ATB, exception_arr);
+	VEOS_DEBUG("PID %d halted on core set %ld", ve_task->pid, *core_set);
+
+	free(exception_arr);
+	VEOS_TRACE("Exiting");
+	return 0;
+}
+
+/**
+* @brief Update ATB and start the cores halted by psm_halt_thread_group().
+*
+* @param[in] ve_task Pointer to VE task struct
+* @param[in] core_set Bitmap of halted core id's
+* @param[in] dir_num Start directory number of ATB to be updated
+* @param[in] count Number of directories to be updated
+*
+* @return Returns -1 on failure and 0 on success
+*/
+int psm_resume_thread_group(struct ve_task_struct *ve_task, uint64_t core_set,
+		int dir_num, int count)
+{
+	int retval = 0;
+
+	VEOS_TRACE("Entering");
+
+	if (core_set) {
+		/* Thread group is not the caller of this request,
+		 * so all halted cores are started */
+		retval = veos_update_atb(core_set, &ve_task->p_ve_mm->atb,
+				dir_num, count, NULL);
+		if (-1 == retval)
+			VEOS_ERROR("Updating ATB failed");
+	}
+
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
 * @brief  Update DMAATB for VE node
 *
@@ -2278,6 +2404,92 @@ hndl_failure:
 	veos_abort("Syncing HW registers failed");
 }
 
+/**
+ * @brief Scheduler worker of a VE core.
+ *
+ * @detail Worker waits until scheduler timer handler kicks it, schedules
+ * the most eligible task on its core and notifies the handler. Context
+ * switches on different cores are performed concurrently.
+ *
+ * @param[in] arg Pointer to core struct of the worker
+ */
+static void *psm_core_sched_worker(void *arg)
+{
+	struct ve_core_struct *p_ve_core = (struct ve_core_struct *)arg;
+	struct ve_node_struct *p_ve_node = p_ve_core->p_ve_node;
+
+	VEOS_TRACE("Entering");
+	while (1) {
+		if (-1 == sem_wait(&p_ve_core->sched_kick)) {
+			if (EINTR == errno)
+				continue;
+			VEOS_ERROR("Core %d scheduler worker failed to wait: %s",
+					p_ve_core->core_num, strerror(errno));
+			break;
+		}
+		if (terminate_flag) {
+			sem_post(&p_ve_node->sched_done);
+			break;
+		}
+		psm_find_sched_new_task_on_core(p_ve_core, true, false);
+		sem_post(&p_ve_node->sched_done);
+	}
+	VEOS_DEBUG("Core %d scheduler worker exiting", p_ve_core->core_num);
+	VEOS_TRACE("Exiting");
+	return NULL;
+}
+
+/**
+ * @brief Create scheduler worker threads of all VE cores of node.
+ *
+ * @param[in] p_ve_node Pointer to node for which workers are created
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int psm_start_core_sched_workers(struct ve_node_struct *p_ve_node)
+{
+	int retval = -1;
+	int core_loop = 0;
+	pthread_attr_t attr;
+	struct ve_core_struct *p_ve_core = NULL;
+
+	VEOS_TRACE("Entering");
+	retval = pthread_attr_init(&attr);
+	if (retval) {
+		VEOS_ERROR("Failed to initialize pthread attribute: %s",
+				strerror(retval));
+		retval = -1;
+		goto hndl_return;
+	}
+	retval = pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (retval) {
+		VEOS_ERROR("Failed to set detach state of pthread attribute: %s",
+				strerror(retval));
+		retval = -1;
+		goto hndl_attr;
+	}
+
+	for (core_loop = 0; core_loop < p_ve_node->nr_avail_cores;
+			core_loop++) {
+		p_ve_core = VE_CORE(p_ve_node->node_num, core_loop);
+		retval = pthread_create(&p_ve_core->sched_th, &attr,
+				psm_core_sched_worker, p_ve_core);
+		if (retval) {
+			VEOS_ERROR("Failed to create scheduler worker of"
+					" core %d: %s", core_loop,
+					strerror(retval));
+			retval = -1;
+			goto hndl_attr;
+		}
+	}
+	retval = 0;
+hndl_attr:
+	pthread_attr_destroy(&attr);
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Start VEOS scheduler timer and register the scheduler
  * timer handler function.
@@ -2302,6 +2514,9 @@ int veos_scheduler_timer(struct ve_node_struct *p_ve_node)
 	if (!p_ve_node)
 		goto hndl_return;
 
+	if (psm_start_core_sched_workers(p_ve_node))
+		goto hndl_return;
+
 	VEOS_DEBUG("Starting PSM scheduler timer");
 	/* Setting clock id */
 	psm_sched_clock_id = CLOCK_MONOTONIC;
@@ -2386,16 +2601,17 @@ hndl_return:
  * @brief Handles interrupt coming from interrupt generator for PSM scheduling.
  *
  * @detail Interrupt generator generates an interrupt after every "TIME_SLICE"
- * Function handles the interrupt and updates data structure and takes
- * rescheduling decision on all the VE cores.
- * This function also schedules the very next task in the VE core task list.
+ * Function handles the interrupt and rebalances tasks to idle VE cores.
+ * Then it kicks scheduler workers of all the VE cores, which schedule
+ * the very next task in their core task list concurrently, and waits
+ * for them before updating the node wide system load.
  *
  * @param[in] psm_sigval sigval coming from start timer function
  */
 void psm_sched_interval_handler(union sigval psm_sigval)
 {
 	int ret = -1;
-	int node_loop = 0, core_loop = 0;
+	int node_loop = 0, core_loop = 0, nr_kicked = 0;
 	struct ve_node_struct *p_ve_node = NULL;
 	struct ve_core_struct *p_ve_core = NULL;
 
@@ -2426,37 +2642,49 @@ void psm_sched_interval_handler(union sigval psm_sigval)
 			VE_NODE_ID(node_loop));
 	SET_SCHED_STATE(p_ve_node->scheduling_status, ONGOING);
 
-	/* core loop */
-	for (core_loop = 0; core_loop < VE_NODE(0)->nr_avail_cores; core_loop++) {
+	if (terminate_flag)
+		goto terminate;
+	ret = pthread_rwlock_tryrdlock(&handling_request_lock);
+	if (ret) {
+		VEOS_ERROR("Scheduler failed in acquiring try read lock");
+		if (ret == EBUSY)
+			goto terminate;
+		else
+			goto abort;
+	}
+
+	/* Rebalance tasks to idle cores, it is node wide */
+	for (core_loop = 0; core_loop < p_ve_node->nr_avail_cores; core_loop++) {
 		p_ve_core = VE_CORE(VE_NODE_ID(node_loop), core_loop);
 		if (NULL == p_ve_core) {
 			VEOS_ERROR("BUG Core ID: %d struct is NULL",
 					core_loop);
 			continue;
 		}
+		psm_rebalance_task_to_core(p_ve_core);
+	}
 
-		if (!terminate_flag) {
-			ret = pthread_rwlock_tryrdlock
-				(&handling_request_lock);
-			if (ret) {
-				VEOS_ERROR("Scheduler failed in acquiring "
-						"try read lock");
-				if (ret == EBUSY)
-					goto terminate;
-				else
-					goto abort;
-			}
-			/* Rebalance task */
-			psm_rebalance_task_to_core(p_ve_core);
-			psm_find_sched_new_task_on_core(p_ve_core,
-					true, false);
+	/* Schedule on all cores concurrently */
+	for (core_loop = 0; core_loop < p_ve_node->nr_avail_cores; core_loop++) {
+		p_ve_core = VE_CORE(VE_NODE_ID(node_loop), core_loop);
+		if (NULL == p_ve_core)
+			continue;
+		sem_post(&p_ve_core->sched_kick);
+		nr_kicked++;
+	}
+	while (nr_kicked) {
+		if (-1 == sem_wait(&p_ve_node->sched_done)) {
+			if (EINTR == errno)
+				continue;
 			pthread_rwlock_lock_unlock(&handling_request_lock,
 					UNLOCK,
 					"Failed to release handling request lock");
-		} else {
-			goto terminate;
+			goto abort;
 		}
+		nr_kicked--;
 	}
+	pthread_rwlock_lock_unlock(&handling_request_lock, UNLOCK,
+			"Failed to release handling request lock");
 
 	/* Caluculate the system load on every scheduler timer
 	 * expiry.
@@ -2480,16 +2708,93 @@ abort:
 }
 
 /**
-* @brief Find a task which can be relocated to core which
-* is idle to rebalance VE tasks among VE cores
+* @brief Estimate the cost of relocating a VE task to another VE core
+*
+* A task whose thread group owns the core DMA descriptor has its user
+* DMA context saved and restored on the new core, and a task using
+* thread CR pages has its CR context moved along with it.
+*
+* @param tsk Pointer to VE task struct
+*
+* @return Relative migration cost of the task
+*/
+static int psm_task_migrate_cost(struct ve_task_struct *tsk)
+{
+	int cost = PSM_MIGRATE_COST_BASE;
+	int crd_num = 0;
+
+	if (tsk->core_dma_desc && (*(tsk->core_dma_desc) == tsk->core_id))
+		cost += PSM_MIGRATE_COST_UDMA;
+
+	if (tsk->p_ve_mm) {
+		for (crd_num = 0; crd_num < MAX_CRD_PER_CORE; crd_num++) {
+			if ((THREAD == tsk->p_ve_mm->crd_type[crd_num]) ||
+				(DELAYED == tsk->p_ve_mm->crd_type[crd_num])) {
+				cost += PSM_MIGRATE_COST_CR;
+				break;
+			}
+		}
+	}
+	return cost;
+}
+
+/**
+* @brief Find the busiest VE core which has not been visited yet
+*
+* Cores are ordered by number of runnable tasks, ties are broken by the
+* busy time accumulated during the last scheduler interval. Values are
+* read without core lock, they are only used as a hint.
+*
+* @param ve_node_id VE node number
+* @param ve_core_id VE core number of the core looking for work
+* @param tried Cores already visited by the caller
+*
+* @return Pointer to busiest core having tasks, else NULL
+*/
+static struct ve_core_struct *psm_find_busiest_core(int ve_node_id,
+		int ve_core_id, bool *tried)
+{
+	struct ve_core_struct *p_busiest = NULL;
+	struct ve_core_struct *p_another_core = NULL;
+	uint64_t busy = 0, max_busy = 0;
+	int core_loop = 0;
+
+	for (core_loop = 0; core_loop < VE_NODE(ve_node_id)->nr_avail_cores;
+			core_loop++) {
+		if ((core_loop == ve_core_id) || tried[core_loop])
+			continue;
+		p_another_core = VE_CORE(ve_node_id, core_loop);
+		if ((NULL == p_another_core) ||
+				(NULL == p_another_core->ve_task_list))
+			continue;
+
+		busy = p_another_core->busy_time -
+			p_another_core->busy_time_prev;
+		if ((NULL == p_busiest) ||
+			(p_another_core->nr_active > p_busiest->nr_active) ||
+			((p_another_core->nr_active == p_busiest->nr_active) &&
+			 (busy > max_busy))) {
+			p_busiest = p_another_core;
+			max_busy = busy;
+		}
+	}
+	return p_busiest;
+}
+
+/**
+* @brief Find a task which can be relocated to a core which is idle or
+* lightly loaded to rebalance VE tasks among VE cores
 *
-* Function traverses core list of all the available core. If a core
-* have two or more than two tasks in its core list, then a task apart
-* from current task on core is selected which can be relocated on the
-* idle core.
+* Function visits the other cores busiest first. A core is stolen from
+* when it has at least PSM_REBALANCE_IMBALANCE more runnable tasks than
+* the target core, or when the target core has no task at all. Current
+* task of a core is never selected. Among the tasks allowed on the target
+* core, a RUNNING task with the lowest migration cost is preferred; a
+* task whose cost exceeds the imbalance is left in place unless the
+* target core is idle.
 *
 * @param ve_node_id VE node number
-* @param ve_core_id VE core number for core having no task
+* @param ve_core_id VE core number for core looking for work
 *
 * @return Pointer to VE task struct of task which is to be relocated,
 * else NULL is returned.
@@ -2497,97 +2802,119 @@ abort:
 struct ve_task_struct *find_and_remove_task_to_rebalance(
 	int ve_node_id, int ve_core_id)
 {
+	struct ve_core_struct *p_ve_core = VE_CORE(ve_node_id, ve_core_id);
+	struct ve_core_struct *p_another_core = NULL;
 	struct ve_task_struct *task_to_rebalance = NULL;
-	struct ve_task_struct *loop_start = NULL;
 	struct ve_task_struct *ve_task_list_head = NULL;
+	struct ve_task_struct *tmp = NULL;
 	struct ve_task_struct *temp = NULL;
-	int core_loop;
-	int rebalance_flag = 0;
-	struct ve_core_struct *p_another_core;
+	bool tried[VE_MAX_CORE_PER_NODE] = {false};
+	bool core_idle = false;
+	bool running = false, best_running = false;
+	int imbalance = 0, cost = 0, min_cost = 0;
+	int nr_tried = 0;
 
 	VEOS_TRACE("Entering");
 
-	for (core_loop = 0; core_loop < VE_NODE(0)->nr_avail_cores;
-			core_loop++) {
-		if (core_loop == ve_core_id)
-			continue;
-		p_another_core = VE_CORE(ve_node_id, core_loop);
-		if (NULL == p_another_core) {
-			VEOS_ERROR("BUG Core ID: %d struct is NULL",
-					core_loop);
-			continue;
-		}
+	core_idle = (NULL == p_ve_core->ve_task_list);
+
+	for (nr_tried = 0; nr_tried < VE_NODE(ve_node_id)->nr_avail_cores;
+			nr_tried++) {
+		p_another_core = psm_find_busiest_core(ve_node_id,
+				ve_core_id, tried);
+		if (NULL == p_another_core)
+			break;
+		tried[p_another_core->core_num] = true;
+
+		imbalance = p_another_core->nr_active - p_ve_core->nr_active;
+		/* Remaining cores are even less loaded */
+		if (!core_idle && (imbalance < PSM_REBALANCE_IMBALANCE))
+			break;
 
 		pthread_rwlock_lock_unlock(&(p_another_core->ve_core_lock),
 				WRLOCK,
-				"Failed to acquire Core %d read lock",
+				"Failed to acquire Core %d write lock",
 				p_another_core->core_num);
 
-		if(NULL == p_another_core->ve_task_list) {
+		ve_task_list_head = p_another_core->ve_task_list;
+		if (NULL == ve_task_list_head) {
 			pthread_rwlock_lock_unlock(
 					&(p_another_core->ve_core_lock),
 					UNLOCK,
 					"Failed to release core's write lock");
 			continue;
 		}
-		if (p_another_core->curr_ve_task) {
-			task_to_rebalance = p_another_core->curr_ve_task->next;
-			loop_start = p_another_core->curr_ve_task;
-		} else {
-			VEOS_DEBUG("Current task on core is [%p]",
-						p_another_core->curr_ve_task);
-			task_to_rebalance = p_another_core->ve_task_list->next;
-			loop_start = p_another_core->ve_task_list;
-		}
 
-		ve_task_list_head = p_another_core->ve_task_list;
-
-		/* Check wether curr_ve_task->next should be rabalanced. */
-		while (task_to_rebalance != loop_start) {
-			if (CPU_ISSET(ve_core_id,
-					&(task_to_rebalance->cpus_allowed)) &&
-				!(get_ve_task_struct(task_to_rebalance))) {
-				rebalance_flag = 1;
-				break;
+		task_to_rebalance = NULL;
+		tmp = ve_task_list_head;
+		do {
+			if ((tmp == p_another_core->curr_ve_task) ||
+				!CPU_ISSET(ve_core_id, &(tmp->cpus_allowed)))
+				goto next;
+
+			running = (RUNNING == tmp->ve_task_state);
+			if (!running && !core_idle)
+				goto next;
+			cost = psm_task_migrate_cost(tmp);
+			if (!core_idle && (cost > imbalance))
+				goto next;
+
+			if ((NULL == task_to_rebalance) ||
+				(running && !best_running) ||
+				((running == best_running) &&
+				 (cost < min_cost))) {
+				task_to_rebalance = tmp;
+				best_running = running;
+				min_cost = cost;
 			}
-			task_to_rebalance = task_to_rebalance->next;
+next:
+			tmp = tmp->next;
+		} while (tmp != ve_task_list_head);
+
+		if ((NULL == task_to_rebalance) ||
+				get_ve_task_struct(task_to_rebalance)) {
+			task_to_rebalance = NULL;
+			pthread_rwlock_lock_unlock(
+					&(p_another_core->ve_core_lock),
+					UNLOCK,
+					"Failed to release core's write lock");
+			continue;
 		}
-		if (rebalance_flag) {
-			VEOS_DEBUG("Found task to rebalance %d",
-					task_to_rebalance->pid);
-			temp = task_to_rebalance;
-			while (temp->next != task_to_rebalance)
-				temp = temp->next;
 
+		VEOS_DEBUG("Found task to rebalance %d from Core %d "
+				"(imbalance %d, cost %d)",
+				task_to_rebalance->pid,
+				p_another_core->core_num, imbalance, min_cost);
+		temp = task_to_rebalance;
+		while (temp->next != task_to_rebalance)
+			temp = temp->next;
+
+		if (temp == task_to_rebalance) {
+			/* Only task in core list */
+			p_another_core->ve_task_list = NULL;
+		} else {
 			temp->next = task_to_rebalance->next;
-			if (task_to_rebalance == ve_task_list_head) {
+			if (task_to_rebalance == ve_task_list_head)
 				p_another_core->ve_task_list =
-						ve_task_list_head->next;
-				VEOS_DEBUG("Now Head is %p",
-						ve_task_list_head);
-			}
+					ve_task_list_head->next;
+		}
+		VEOS_DEBUG("Now Head is %p", p_another_core->ve_task_list);
 
-			task_to_rebalance->next = NULL;
+		task_to_rebalance->next = NULL;
 
-			if (RUNNING == task_to_rebalance->ve_task_state) {
-				ve_atomic_dec(&(p_another_core->nr_active));
-				VEOS_DEBUG("Core[%d] nr_active: [%d]",
+		if (RUNNING == task_to_rebalance->ve_task_state) {
+			ve_atomic_dec(&(p_another_core->nr_active));
+			VEOS_DEBUG("Core[%d] nr_active: [%d]",
 					p_another_core->core_num,
 					p_another_core->nr_active);
-			}
+		}
 
-			ve_atomic_dec(&(VE_NODE(ve_node_id)->num_ve_proc));
-			ve_atomic_dec(&(p_another_core->num_ve_proc));
+		ve_atomic_dec(&(VE_NODE(ve_node_id)->num_ve_proc));
+		ve_atomic_dec(&(p_another_core->num_ve_proc));
 
-			pthread_rwlock_lock_unlock(
-					&(p_another_core->ve_core_lock),
-					UNLOCK,
-					"Failed to release core's write lock");
-			break;
-		}
-		task_to_rebalance = NULL;
 		pthread_rwlock_lock_unlock(&(p_another_core->ve_core_lock),
 				UNLOCK, "Failed to release core's write lock");
+		break;
 	}
 	VEOS_TRACE("Exiting");
 	return task_to_rebalance;
@@ -2673,49 +3000,56 @@ void insert_and_update_task_to_rebalance(
 
 /**
 * @brief Performs rebalancing on VE core if it does not have any
-* task in its core list.
+* task in its core list or has noticeably fewer runnable tasks than
+* the busiest core.
 *
-* @param p_ve_core Pointer to core structure of core which is idle.
+* @param p_ve_core Pointer to core structure of core looking for work.
 */
 void psm_rebalance_task_to_core(struct ve_core_struct *p_ve_core)
 {
 	struct ve_task_struct *task_to_rebalance = NULL;
+	struct ve_core_struct *p_busiest = NULL;
+	bool tried[VE_MAX_CORE_PER_NODE] = {false};
+	bool core_idle = false;
 
 	VEOS_TRACE("Entering");
 
 	pthread_rwlock_lock_unlock(&(p_ve_core->ve_core_lock), RDLOCK,
 			"Failed to acquire Core %d read lock",
 			p_ve_core->core_num);
-	if (NULL == p_ve_core->ve_task_list) {
-		pthread_rwlock_lock_unlock(
-				&(p_ve_core->ve_core_lock), UNLOCK,
-				"Failed to acquire Core %d read lock",
-				p_ve_core->core_num);
+	core_idle = (NULL == p_ve_core->ve_task_list);
+	pthread_rwlock_lock_unlock(&(p_ve_core->ve_core_lock), UNLOCK,
+			"Failed to release Core %d read lock",
+			p_ve_core->core_num);
 
-		pthread_rwlock_lock_unlock(
-				&(VE_NODE(0)->ve_relocate_lock), WRLOCK,
-				"Failed to acquire ve_relocate_lock read lock");
-		/* Find task which can be rebalanced on p_ve_core */
-		task_to_rebalance = find_and_remove_task_to_rebalance(
-				p_ve_core->node_num, p_ve_core->core_num);
-		if (task_to_rebalance) {
-			VEOS_DEBUG("Task to rebalance = %d",
-					task_to_rebalance->pid);
-			/* Insert "task_to_rebalance" in "p_ve_core"
-			 * to rebalance */
-			insert_and_update_task_to_rebalance(
-					p_ve_core->node_num, p_ve_core->core_num,
-					task_to_rebalance);
-		}
-		pthread_rwlock_lock_unlock(
-				&(VE_NODE(0)->ve_relocate_lock), UNLOCK,
-				"Failed to release ve_relocate_lock writelock");
-	} else {
-		pthread_rwlock_lock_unlock(&(p_ve_core->ve_core_lock), UNLOCK,
-				"Failed to acquire Core %d read lock",
-				p_ve_core->core_num);
+	/* Avoid taking relocate write lock when cores are balanced */
+	if (!core_idle) {
+		p_busiest = psm_find_busiest_core(p_ve_core->node_num,
+				p_ve_core->core_num, tried);
+		if ((NULL == p_busiest) || ((p_busiest->nr_active -
+				p_ve_core->nr_active) < PSM_REBALANCE_IMBALANCE))
+			goto hndl_return;
 	}
 
+	pthread_rwlock_lock_unlock(
+			&(VE_NODE(0)->ve_relocate_lock), WRLOCK,
+			"Failed to acquire ve_relocate_lock write lock");
+	/* Find task which can be rebalanced on p_ve_core */
+	task_to_rebalance = find_and_remove_task_to_rebalance(
+			p_ve_core->node_num, p_ve_core->core_num);
+	if (task_to_rebalance) {
+		VEOS_DEBUG("Task to rebalance = %d",
+				task_to_rebalance->pid);
+		/* Insert "task_to_rebalance" in "p_ve_core"
+		 * to rebalance */
+		insert_and_update_task_to_rebalance(
+				p_ve_core->node_num, p_ve_core->core_num,
+				task_to_rebalance);
+	}
+	pthread_rwlock_lock_unlock(
+			&(VE_NODE(0)->ve_relocate_lock), UNLOCK,
+			"Failed to release ve_relocate_lock writelock");
+hndl_return:
 	VEOS_TRACE("Exiting");
 	return;
 }
@@ -2751,7 +3085,7 @@ void psm_find_sched_new_task_on_core(struct ve_core_struct *p_ve_core,
 	reg_t regdata = 0;
 	struct ve_task_struct *task_to_schedule = NULL;
 	struct ve_task_struct *curr_ve_task = NULL;
-	struct timeval now_time = {0};
+	uint64_t now_time = 0;
 	bool tsd_update = false;
 
 	VEOS_TRACE("Entering");
@@ -2799,19 +3133,18 @@ void psm_find_sched_new_task_on_core(struct ve_core_struct *p_ve_core,
 	/* Only task on core doing no exception, therefore
 	 * skip context switch
 	 * */
-	gettimeofday(&now_time, NULL);
+	now_time = psm_mono_nsec();
 	if (curr_ve_task && (curr_ve_task->sigpending == 0)
 			&& scheduler_expiry
 			&& (p_ve_core->nr_active == 1)
 			&& (curr_ve_task->ve_task_state == RUNNING)
 			&& p_ve_core->ve_core_state == EXECUTING) {
 		/* Update core busy time */
-		p_ve_core->busy_time +=
-			timeval_diff(now_time, p_ve_core->core_stime);
+		p_ve_core->busy_time += now_time - p_ve_core->core_stime;
 		p_ve_core->core_stime = now_time;
 
 		/* Update VE task execution time */
-		psm_calc_task_exec_time(curr_ve_task);
+		psm_calc_task_exec_time(curr_ve_task, now_time);
 
 		/* Update time quantum of VE task
 		 * As this is the only eligible VE task on VE core, therefore
@@ -2820,8 +3153,8 @@ void psm_find_sched_new_task_on_core(struct ve_core_struct *p_ve_core,
 		VEOS_DEBUG("Core %d No exception for pid %d No scheduling",
 				p_ve_core->core_num,
 				curr_ve_task->pid);
-		curr_ve_task->time_slice -=
-				timeval_diff(now_time, curr_ve_task->stime);
+		curr_ve_task->time_slice -= (now_time -
+				curr_ve_task->stime) / USECS_TO_NANOSECONDS;
 		if (curr_ve_task->time_slice <= 0) {
 			VEOS_DEBUG("Reset time slice for PID %d on Core %d",
 					curr_ve_task->pid, curr_ve_task->core_id);
@@ -2831,6 +3164,28 @@ void psm_find_sched_new_task_on_core(struct ve_core_struct *p_ve_core,
 		goto hndl_return;
 	}
 
+	/* Time slice of current task is not exhausted, skip scheduling
+	 * without halting core, as psm_halt_ve_core() would do after
+	 * taking thread group lock and reading core registers.
+	 * */
+	if (curr_ve_task && scheduler_expiry
+			&& (curr_ve_task->ve_task_state == RUNNING)
+			&& (p_ve_core->ve_core_state == EXECUTING)
+			&& p_ve_core->core_running
+			&& (curr_ve_task->time_slice >= (int64_t)((now_time -
+				curr_ve_task->stime) / USECS_TO_NANOSECONDS))) {
+		p_ve_core->busy_time += now_time - p_ve_core->core_stime;
+		p_ve_core->core_stime = now_time;
+		curr_ve_task->time_slice -= (now_time -
+				curr_ve_task->stime) / USECS_TO_NANOSECONDS;
+		psm_calc_task_exec_time(curr_ve_task, now_time);
+		curr_ve_task->stime = now_time;
+		VEOS_DEBUG("Process %d time slice not exhausted,"
+				" Skip Scheduling for core %d",
+				curr_ve_task->pid, p_ve_core->core_num);
+		goto hndl_return;
+	}
+
 	/* TAKE THREAD GROUP LOCK */
 	if (curr_ve_task) {
 		VEOS_DEBUG("Acquire thread group lock PID %d CORE %d",
@@ -47,6 +47,18 @@
 
 #define HALT_CORE_MAX_TIME	30
 #define START_CORE_MAX_TIME	1
+/* Core register is polled this many times before sleeping */
+#define CORE_WAIT_SPIN_COUNT	100
+/* Sleep between polls doubles from min to max nanoseconds */
+#define CORE_WAIT_SLEEP_MIN_NS	1000
+#define CORE_WAIT_SLEEP_MAX_NS	1000000
+
+/* Difference of runnable tasks at which a busy core is stolen from */
+#define PSM_REBALANCE_IMBALANCE	2
+/* Relative cost of moving a task to another VE core */
+#define PSM_MIGRATE_COST_BASE	1
+#define PSM_MIGRATE_COST_UDMA	2
+#define PSM_MIGRATE_COST_CR	1
 
 #define NANO_SECONDS 1
 #define MILLI_SECONDS (1000 * NANO_SECONDS)
@@ -113,12 +125,14 @@ int schedule_task_on_ve_node_ve_core(struct ve_task_struct *,
 		struct ve_task_struct *,
 		bool, bool);
 int veos_update_atb(uint64_t, void *, int, int, struct ve_task_struct *);
+int psm_halt_thread_group(struct ve_task_struct *, uint64_t *);
+int psm_resume_thread_group(struct ve_task_struct *, uint64_t, int, int);
 int veos_update_dmaatb(uint64_t, void *, int, int, struct ve_task_struct *, reg_t *);
 int psm_sync_hw_regs(struct ve_task_struct *, regs_t, void *, bool, int, int);
 void psm_find_sched_new_task_on_core(struct ve_core_struct *, bool, bool);
 void psm_rebalance_task_to_core(struct ve_core_struct *);
 void psm_unassign_migrate_task(struct ve_task_struct *);
-int psm_calc_task_exec_time(struct ve_task_struct *);
+int psm_calc_task_exec_time(struct ve_task_struct *, uint64_t);
 bool psm_unassign_task(struct ve_task_struct *);
 bool psm_unassign_assign_task(struct ve_task_struct *);
 struct ve_task_struct *find_and_remove_task_to_rebalance(int, int);
@@ -2808,6 +2808,8 @@ void veos_polling_thread(void)
 					continue;
 				VEOS_DEBUG("Cleanup for PID %d",
 						pid);
+				/* TID may be reused, forget authenticated TIDs */
+				__sync_fetch_and_add(&veos_dead_tid_gen, 1);
 				retval = pthread_rwlock_tryrdlock
 					(&handling_request_lock);
 				if (retval) {
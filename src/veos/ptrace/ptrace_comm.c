@@ -537,6 +537,168 @@ hndl_return:
 	return retval;
 }
 
+/**
+ * @brief Handles the "PEEKDATA_RANGE" ptrace request for the given pid.
+ *
+ * @param[in] pti Pointer to veos_thread_arg for communication
+ * @param[in] pid Pid of VE tracee process
+ * @param[in] addr VEMVA of tracee process
+ * @param[in] data VHVA of tracer to fill
+ * @param[in] len Length of the range in bytes
+ *
+ * @return 0 on success, -errno on failure.
+ */
+int veos_ptrace_peekdata_range(struct veos_thread_arg *pti, pid_t pid,
+		uint64_t addr, uint64_t data, uint64_t len)
+{
+	int retval = -1;
+	pid_t tracer_pid = -1;
+	struct ve_task_struct *p_ve_task = NULL;
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return;
+
+	tracer_pid = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->pseudo_pid;
+	VEOS_DEBUG("Recevied PEEKDATA_RANGE request for pid :%d", pid);
+
+	/* DMA transfers 8 byte aligned ranges only */
+	if (!len || ((addr | data | len) & (sizeof(uint64_t) - 1)) ||
+			(addr + len < addr) || (data + len < data) ||
+			(len > PTRACE_RANGE_MAX)) {
+		VEOS_DEBUG("Invalid range VEMVA: %lx VHVA: %lx length: %lx",
+				addr, data, len);
+		retval = -EINVAL;
+		goto hndl_return2;
+	}
+
+	/* Find the VE task struct corresponding to given pid */
+	p_ve_task = find_ve_task_struct(pid);
+	if (NULL == p_ve_task) {
+		VEOS_ERROR("Pid: %d is not found", pid);
+		retval = -ESRCH;
+		goto hndl_return2;
+	}
+
+	/* Check VE process is traced/attached or not */
+	if (false == p_ve_task->ptraced) {
+		VEOS_ERROR("VE Process: %d is not traced/attached", pid);
+		retval = -ESRCH;
+		goto hndl_return1;
+	}
+
+	/* Check that PTRACE request from valid VE tracer or not */
+	if (tracer_pid != p_ve_task->p_ve_ptrace->tracer_pid) {
+		VEOS_DEBUG("VE Process(%d)->Tracer(%d) Not: %d",
+				pid, p_ve_task->p_ve_ptrace->tracer_pid,
+				tracer_pid);
+		VEOS_ERROR("Request from unknown tracer received");
+		retval = -ESRCH;
+		goto hndl_return1;
+	}
+
+	VEOS_DEBUG("PID: %d VEMVA: %lx VHVA: %lx LEN: %lx",
+			pid, addr, data, len);
+
+	retval = psm_ptrace_peekdata_range(p_ve_task, addr, data, len);
+	if (-1 == retval) {
+		VEOS_ERROR("PEEKDATA_RANGE failed for pid: %d", pid);
+		retval = -EIO;
+		goto hndl_return1;
+	}
+
+	retval = 0;
+hndl_return1:
+	put_ve_task_struct(p_ve_task);
+hndl_return2:
+	veos_ptrace_send_cmd_response(pti->socket_descriptor, NULL, 0, retval);
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
+/**
+ * @brief Handles the "POKEDATA_RANGE" ptrace request for the given pid.
+ *
+ * @param[in] pti Pointer to veos_thread_arg for communication
+ * @param[in] pid Pid of VE tracee process
+ * @param[in] addr VEMVA of tracee process
+ * @param[in] data VHVA of tracer to read from
+ * @param[in] len Length of the range in bytes
+ *
+ * @return 0 on success, -errno on failure.
+ */
+int veos_ptrace_pokedata_range(struct veos_thread_arg *pti, pid_t pid,
+		uint64_t addr, uint64_t data, uint64_t len)
+{
+	int retval = -1;
+	pid_t tracer_pid = -1;
+	struct ve_task_struct *p_ve_task = NULL;
+
+	VEOS_TRACE("Entering");
+
+	if (!pti)
+		goto hndl_return;
+
+	tracer_pid = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->pseudo_pid;
+	VEOS_DEBUG("Recevied POKEDATA_RANGE request for pid :%d", pid);
+
+	/* DMA transfers 8 byte aligned ranges only */
+	if (!len || ((addr | data | len) & (sizeof(uint64_t) - 1)) ||
+			(addr + len < addr) || (data + len < data) ||
+			(len > PTRACE_RANGE_MAX)) {
+		VEOS_DEBUG("Invalid range VEMVA: %lx VHVA: %lx length: %lx",
+				addr, data, len);
+		retval = -EINVAL;
+		goto hndl_return2;
+	}
+
+	/* Find the VE task struct corresponding to given pid */
+	p_ve_task = find_ve_task_struct(pid);
+	if (NULL == p_ve_task) {
+		VEOS_ERROR("Pid: %d is not found", pid);
+		retval = -ESRCH;
+		goto hndl_return2;
+	}
+
+	/* Check VE process is traced/attached or not */
+	if (false == p_ve_task->ptraced) {
+		VEOS_ERROR("VE Process: %d is not traced/attached", pid);
+		retval = -ESRCH;
+		goto hndl_return1;
+	}
+
+	/* Check that PTRACE request from valid VE tracer or not */
+	if (tracer_pid != p_ve_task->p_ve_ptrace->tracer_pid) {
+		VEOS_DEBUG("VE Process(%d)->Tracer(%d) Not: %d",
+				pid, p_ve_task->p_ve_ptrace->tracer_pid,
+				tracer_pid);
+		VEOS_ERROR("Request from unknown tracer received");
+		retval = -ESRCH;
+		goto hndl_return1;
+	}
+
+	VEOS_DEBUG("PID: %d VEMVA: %lx VHVA: %lx LEN: %lx",
+			pid, addr, data, len);
+
+	retval = psm_ptrace_pokedata_range(p_ve_task, addr, data, len);
+	if (-1 == retval) {
+		VEOS_ERROR("POKEDATA_RANGE failed for pid: %d", pid);
+		retval = -EIO;
+		goto hndl_return1;
+	}
+
+	retval = 0;
+hndl_return1:
+	put_ve_task_struct(p_ve_task);
+hndl_return2:
+	veos_ptrace_send_cmd_response(pti->socket_descriptor, NULL, 0, retval);
+hndl_return:
+	VEOS_TRACE("Exiting");
+	return retval;
+}
+
 /**
  * @brief Handles the "PEEKUSER" ptrace request for the given pid.
  *
@@ -1405,7 +1567,8 @@ int veos_handle_ptrace_req(struct veos_thread_arg *pti)
 		goto hndl_return;
 
 	proto_msg = ((PseudoVeosMessage *)pti->pseudo_proc_msg)->pseudo_msg;
-	memcpy(&pt_req, proto_msg.data, proto_msg.len);
+	memcpy(&pt_req, proto_msg.data, (proto_msg.len < sizeof(pt_req)) ?
+			proto_msg.len : sizeof(pt_req));
 
 	VEOS_DEBUG("Recevied PTRACE request:%d for pid :%d",
 			pt_req.ptrace_cmd,
@@ -1451,6 +1614,20 @@ int veos_handle_ptrace_req(struct veos_thread_arg *pti)
 			VEOS_DEBUG("POKEDATA fails for PID: %d ADDR: %lx",
 					pt_req.pid, pt_req.addr);
 		break;
+	case PEEKDATA_RANGE:
+		retval = veos_ptrace_peekdata_range(pti, pt_req.pid,
+				pt_req.addr, pt_req.data, pt_req.len);
+		if (0 > retval)
+			VEOS_DEBUG("PEEKDATA_RANGE fails for PID: %d ADDR: %lx",
+					pt_req.pid, pt_req.addr);
+		break;
+	case POKEDATA_RANGE:
+		retval = veos_ptrace_pokedata_range(pti, pt_req.pid,
+				pt_req.addr, pt_req.data, pt_req.len);
+		if (0 > retval)
+			VEOS_DEBUG("POKEDATA_RANGE fails for PID: %d ADDR: %lx",
+					pt_req.pid, pt_req.addr);
+		break;
 	case PEEKUSER:
 		retval = veos_ptrace_peekuser(pti, pt_req.pid, pt_req.addr);
 		if (0 > retval)
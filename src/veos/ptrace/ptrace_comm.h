@@ -51,6 +51,8 @@ enum ptrace_req_cmd {
 	SETOPTIONS,             /*!< VE ptrace options */
 	GETEVENTMSG,            /*!< Get ptrace event that message */
 	CHECK_PID,              /*!< Check VE process exists or not */
+	PEEKDATA_RANGE,		/*!< Get content of a range of VE memory */
+	POKEDATA_RANGE,		/*!< Write content to a range of VE memory */
 	PTRACE_INVAL = -1	/*!< Invalid Request */
 };
 
@@ -62,6 +64,7 @@ typedef struct ptrace_req_struct {
 	pid_t pid;			/*!< PID of VE Tracee */
 	uint64_t addr;			/*!< Address to acces */
 	uint64_t data;			/*!< Address to data */
+	uint64_t len;			/*!< Length of memory range */
 } ptrace_req;
 
 ssize_t veos_ptrace_write_buf(int, void *, ssize_t);
@@ -72,6 +75,10 @@ int veos_ptrace_attach(struct veos_thread_arg *, pid_t);
 int veos_ptrace_check_pid(struct veos_thread_arg *, pid_t);
 int veos_ptrace_peekdata(struct veos_thread_arg *, pid_t, uint64_t);
 int veos_ptrace_pokedata(struct veos_thread_arg *, pid_t, uint64_t, uint64_t);
+int veos_ptrace_peekdata_range(struct veos_thread_arg *, pid_t, uint64_t,
+		uint64_t, uint64_t);
+int veos_ptrace_pokedata_range(struct veos_thread_arg *, pid_t, uint64_t,
+		uint64_t, uint64_t);
 int veos_ptrace_peekuser(struct veos_thread_arg *, pid_t, uint64_t);
 int veos_ptrace_pokeuser(struct veos_thread_arg *, pid_t, uint64_t, uint64_t);
 int veos_ptrace_getregs(struct veos_thread_arg *, pid_t, uint64_t);